@@ -12,15 +12,20 @@
 #include <string>
 #include <iostream>
 #include <limits>
-#include <iomanip>
 #include <unistd.h>
 #include <cstring>
 
 #include "ArgParser.h"
 #include "crypto-encode/base58.h"
-#include "crypto-encode/hex.h"
 #include "crypto-hash/sha256.h"
 #include "../Utility/StringUtilities.h"
+#include "../DeriveKey/Mnemonic.h"
+#include "../Utility/CommandLimits.h"
+#include "../Utility/EccContextPool.h"
+#include "../Utility/SeedHex.h"
+#include "../Utility/PathTemplate.h"
+#include "../Utility/SecureArena.h"
+#include "../Scan/Scan.h"
 
 extern "C"
 {
@@ -33,12 +38,40 @@ extern "C"
  */
 void ArgParser::printHelp() {
     std::cout << "derive-key {value} [--path {path}] [-]    - Depending on the type of the input {value} the utility outputs certain extended keys." << std::endl;
+    std::cout << "    --mnemonic              - {value} is a BIP39 mnemonic (12-24 lowercase words), converted to a seed with PBKDF2-HMAC-SHA512." << std::endl;
+    std::cout << "    --passphrase {phrase}   - optional printable ASCII BIP39 passphrase, only with --mnemonic." << std::endl;
+    std::cout << "    --public-only           - print only the xpub of each derived key." << std::endl;
+    std::cout << "    --private-only          - print only the xprv of each derived key (not allowed for xpub inputs)." << std::endl;
+    std::cout << "    --origin                - prefix each key with its key origin [fingerprint/path] (HASH160 of the master key), not with --format=bin." << std::endl;
+    std::cout << "    --cache {file}          - keep the node after the last hardened path step in a persistent mmapped cache file." << std::endl;
+    std::cout << "    --cache-no-private      - do not write private keys to the cache (cached nodes then only serve --public-only)." << std::endl;
+    std::cout << "    --format=text|bin|ndjson|address - output xpub:xprv lines (default), fixed-size " << BINARY_RECORD_SIZE << "-byte binary records," << std::endl;
+    std::cout << "                              JSON objects (index, xpub, xprv, depth, child, fingerprint) or P2PKH addresses." << std::endl;
+    std::cout << "    --threads {n}           - number of worker threads (1-" << MAX_DERIVE_THREADS << ", 0 = one per CPU, default)." << std::endl;
     std::cout << std::endl;
     std::cout << std::endl;
     std::cout << "key-expression {expr} [-]     - parses the {expr} according to the BIP 380 Key Expressions specification. If there are no parsing errors, the key expression is echoed back on a single line with 0 exit code. Otherwise, the utility errors out with a non-zero exit code and descriptive message." << std::endl;
+    std::cout << "    --format=text|ndjson    - echo the expressions (default) or print JSON objects (index, expression, type, key, origin, derivation)." << std::endl;
     std::cout << std::endl;
     std::cout << std::endl;
     std::cout << "script-expression {expr} [-]  - sub-command implements parsing of some of the script expressions and optionally also checksum verification and calculation." << std::endl;
+    std::cout << "    --format=text|ndjson|address - plain output (default), a JSON object (descriptor, checksum, verified)" << std::endl;
+    std::cout << "                              or the base58check address of a pkh() or sh() descriptor." << std::endl;
+    std::cout << std::endl;
+    std::cout << std::endl;
+    std::cout << "find-child {xpub} --targets {file} [--path {template}]    - reports the child index under {xpub} that produced each target key." << std::endl;
+    std::cout << "    --targets {file}        - one compressed public key (66 hex characters) or HASH160 (40 hex characters) per line." << std::endl;
+    std::cout << "    --path {template}       - non-hardened path with exactly one * step, e.g. 0/* (default *)." << std::endl;
+    std::cout << "    --range {n}             - search child indices 0 to n-1 (1-" << MAX_CHILD_SEARCH_RANGE << ", default " << DEFAULT_CHILD_SEARCH_RANGE << ")." << std::endl;
+    std::cout << "    --threads {n}           - number of worker threads (1-" << MAX_DERIVE_THREADS << ", 0 = one per CPU, default)." << std::endl;
+    std::cout << "    --format=text|ndjson    - target:path lines (default) or JSON objects (target, index, path)." << std::endl;
+    std::cout << std::endl;
+    std::cout << std::endl;
+    std::cout << "scan {xpub|descriptor} --used {file} [-]    - walks the address chains of {xpub} (0 and 1) or of a pkh(XPUB/.../*) descriptor and reports the used addresses." << std::endl;
+    std::cout << "    --used {file}           - one used P2PKH address or scriptPubKey (76a914...88ac) per line." << std::endl;
+    std::cout << "    --gap {n}               - a chain ends after n consecutive unused addresses (1-" << MAX_SCAN_GAP << ", default " << DEFAULT_SCAN_GAP << ")." << std::endl;
+    std::cout << "    --threads {n}           - number of worker threads (1-" << MAX_DERIVE_THREADS << ", 0 = one per CPU, default)." << std::endl;
+    std::cout << "    --format=text|ndjson    - input:path:address lines (default) or JSON objects (input, path, index, address)." << std::endl;
     std::cout << std::endl;
     std::cout << std::endl;
     std::cout << "--help   	- prints help and exits out" << std::endl;
@@ -80,7 +113,21 @@ bool ArgParser::invalidKeyArgsAmount() {
             multipleArgsExist("key-expression") ||
             multipleArgsExist("script-expression") ||
             multipleArgsExist("-") ||
-            multipleArgsExist("--path");
+            multipleArgsExist("--path") ||
+            multipleArgsExist("--mnemonic") ||
+            multipleArgsExist("--passphrase") ||
+            multipleArgsExist("--threads") ||
+            multipleArgsExist("--public-only") ||
+            multipleArgsExist("--private-only") ||
+            multipleArgsExist("--origin") ||
+            multipleArgsExist("--cache") ||
+            multipleArgsExist("--cache-no-private") ||
+            multipleArgsExist("find-child") ||
+            multipleArgsExist("--targets") ||
+            multipleArgsExist("--range") ||
+            multipleArgsExist("scan") ||
+            multipleArgsExist("--used") ||
+            multipleArgsExist("--gap");
 }
 
 
@@ -89,50 +136,100 @@ bool ArgParser::invalidKeyArgsAmount() {
  * @return true if key args are correct, false if otherwise
  */
 bool ArgParser::invalidKeyArgsPosition() {
-    return (argList.at(0) != "derive-key" && argList.at(0) != "key-expression" && argList.at(0) != "script-expression");
+    return (argList.at(0) != "derive-key" && argList.at(0) != "key-expression" && argList.at(0) != "script-expression" &&
+            argList.at(0) != "find-child" && argList.at(0) != "scan");
 }
 
 
 /**
- * Implements sha256 hashing
- * @param value value to be hashed
- * @return hashed string
+ * Parses the provided key value.
+ *
+ * Valid seed {value} is a byte sequence of length between 128 and 512 bits represented as case-insensitive hexadecimal values. Single space character ' ' or a
+ * tab value '\t' can be used to separate the individual hexadecimal values. Note that extended public and private keys cannot be split by any whitespace.
+ * The allowed seed lengths can be further constrained by the underlying BIP 32 library that you are using --- if so, mention the valid lengths in the help and
+ * the project's README file.
+ *
+ * Seeds are checked by the same single-pass decoder that DeriveKey uses (see SeedHex.h), which reports the
+ * column of the first offending character.
+ *
+ * @param value value to be checked
  */
-std::string ArgParser::sha256(const std::string &value) {
-    using safeheron::hash::CSHA256;
-
-    CSHA256 sha256;
-    uint8_t outputBuffer[CSHA256::OUTPUT_SIZE];
-    sha256.Write(reinterpret_cast<const unsigned char*>(value.c_str()), value.length());
-    sha256.Finalize(outputBuffer);
-
-    std::ostringstream hexStream;
-    for (unsigned char ch : outputBuffer) {
-        hexStream << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(ch);
+void ArgParser::parseDeriveKeyValue(const std::string &value) {
+    if (value.rfind("xpub", 0) == 0 || value.rfind("xprv", 0) == 0) {
+        if (!regex_match(value, std::regex(PURE_PRIVATE_KEYS_REGEX)))
+            throw std::invalid_argument("[ERROR]: parseDeriveKeyValue: invalid key value");
+        return;
     }
 
-    return hexStream.str();
+    uint8_t seed[SEED_MAX_BYTES];
+    const SeedHexResult result = decodeSeedHex(value.data(), value.size(), seed);
+    SecureArena::wipe(seed, sizeof(seed));
+    if (result.status != SeedHexStatus::Ok)
+        throw std::invalid_argument("[ERROR]: parseDeriveKeyValue: " + seedHexErrorMessage(result));
 }
 
 
 /**
- * Parses the provided key value.
+ * Parses the provided BIP39 mnemonic value.
  *
- * Valid seed {value} is a byte sequence of length between 128 and 512 bits represented as case-insensitive hexadecimal values. Single space character ' ' or a
- * tab value '\t' can be used to separate the individual hexadecimal values. Note that extended public and private keys cannot be split by any whitespace.
- * The allowed seed lengths can be further constrained by the underlying BIP 32 library that you are using --- if so, mention the valid lengths in the help and
- * the project's README file.
+ * The mnemonic consists of 12, 15, 18, 21 or 24 lowercase words separated by spaces or tabs. The words themselves
+ * are not checked against the BIP39 word list.
  *
  * @param value value to be checked
  */
-void ArgParser::parseDeriveKeyValue(const std::string &value) {
-    const std::regex valueRegex("^(([0-9a-fA-F]{2})([ \t]*)){16,64}$");
+void ArgParser::parseMnemonicValue(const std::string &value) {
+    try {
+        normalizeMnemonic(value);
+    }
+    catch (std::exception &ex) {
+        throw_with_nested(std::invalid_argument("[ERROR]: parseMnemonicValue: invalid mnemonic"));
+    }
+}
 
-    std::smatch matches;
-    if (!regex_match(value, matches, valueRegex) &&
-        !regex_match(value, matches, std::regex(PURE_PRIVATE_KEYS_REGEX)))
-        throw std::invalid_argument("[ERROR]: parseDeriveKeyValue: invalid key value");
 
+/**
+ * Parses the derive-key worker thread count.
+ * @param value decimal thread count, 0 means one thread per CPU
+ */
+void ArgParser::parseThreadCount(const std::string &value) {
+    if (!regex_match(value, std::regex("\\d{1,4}")))
+        throw std::invalid_argument("[ERROR]: parseThreadCount: thread count must be a decimal number");
+    if (std::stoul(value) > MAX_DERIVE_THREADS)
+        throw std::invalid_argument("[ERROR]: parseThreadCount: too many threads");
+}
+
+
+/**
+ * Consumes a --format={value} argument, shared by all sub-commands.
+ * @param arg argument to check
+ * @return true if the argument was a --format= argument, false if otherwise
+ */
+bool ArgParser::takeFormatArg(const std::string &arg) {
+    if (arg.rfind("--format=", 0) != 0)
+        return false;
+    if (!this->argFormat.empty())
+        throw std::invalid_argument("[ERROR]: takeFormatArg: multiple --format arguments");
+    this->argFormat = arg.substr(strlen("--format="));
+    if (this->argFormat.empty())
+        throw std::invalid_argument("[ERROR]: takeFormatArg: empty --format value");
+    return true;
+}
+
+
+/**
+ * Parses the output format.
+ * @param format value of --format=, empty if not provided
+ * @param allowBinary whether the sub-command supports binary records
+ * @param allowAddress whether the sub-command supports address output
+ */
+void ArgParser::parseFormat(const std::string &format, bool allowBinary, bool allowAddress) {
+    if (format.empty() || format == "text" || format == "ndjson")
+        return;
+    if (allowBinary && format == "bin")
+        return;
+    if (allowAddress && format == "address")
+        return;
+    throw std::invalid_argument("[ERROR]: parseFormat: unsupported format " + format);
 }
 
 
@@ -169,50 +266,67 @@ void ArgParser::parseFilepath(const std::string &filepath) {
 }
 
 
+/**
+ * Parses the find-child search range.
+ * @param value decimal number of child indices to search
+ */
+void ArgParser::parseRange(const std::string &value) {
+    if (!regex_match(value, std::regex("\\d{1,10}")))
+        throw std::invalid_argument("[ERROR]: parseRange: range must be a decimal number");
+    const unsigned long range = std::stoul(value);
+    if (range == 0 || range > MAX_CHILD_SEARCH_RANGE)
+        throw std::invalid_argument("[ERROR]: parseRange: range out of bounds");
+}
+
+
+/**
+ * Parses the scan gap limit.
+ * @param value decimal number of consecutive unused addresses that ends a chain
+ */
+void ArgParser::parseGap(const std::string &value) {
+    if (!regex_match(value, std::regex("\\d{1,6}")))
+        throw std::invalid_argument("[ERROR]: parseGap: gap must be a decimal number");
+    const unsigned long gap = std::stoul(value);
+    if (gap == 0 || gap > MAX_SCAN_GAP)
+        throw std::invalid_argument("[ERROR]: parseGap: gap out of bounds");
+}
+
+
 /**
  * Converts WIF key to PK via base58 decoding. NOTE, that the fist byte is not dropped, as it should be
  * @param WIFKey WIF key to be converted
- * @return decoded PK
+ * @param decoded decoded PK, including the version byte and the checksum
  */
-std::string ArgParser::WIFToPrivateKey(const std::string &WIFKey) {
-    using namespace safeheron::encode::hex;
+void ArgParser::WIFToPrivateKey(const std::string &WIFKey, unsigned char decoded[WIF_DECODED_SIZE]) {
     using namespace safeheron::encode::base58;
-    std::string convertedString;
-    try {
-        convertedString = EncodeToHex(DecodeFromBase58(WIFKey));
-    }
-    catch (std::exception &ex) {
+    size_t size = 0;
+    const Base58Status status = DecodeFromBase58(WIFKey, decoded, WIF_DECODED_SIZE, &size);
+    if (status == Base58Status::InvalidCharacter)
         throw std::invalid_argument("[ERROR]: WIFToPrivateKey: DecodeFromBase58 failed");
-    }
-
-    if (convertedString.length() != 74)
+    if (status != Base58Status::Ok || size != WIF_DECODED_SIZE)
         throw std::invalid_argument("[ERROR]: WIFToPrivateKey: Invalid convertedString output length");
-
-    return convertedString;
 }
 
 
 /**
- * Checks the WIF key's checksum
+ * Checks the WIF key's checksum: the first 4 bytes of the double-SHA256 of the version byte and the
+ * key must equal the last 4 decoded bytes
  * @param WIFKey WIF key to be checked
- * @return true if OK, false if otherwise
  */
 void ArgParser::checkWIFChecksum(const std::string &WIFKey) {
-    using namespace safeheron::encode::hex;
-    using namespace safeheron::encode::base58;
-    std::string convertedString;
+    unsigned char decoded[WIF_DECODED_SIZE];
     try {
-        convertedString = WIFToPrivateKey(WIFKey);
+        WIFToPrivateKey(WIFKey, decoded);
     }
     catch (std::exception &ex) {
         throw_with_nested(std::invalid_argument("[ERROR]: checkWIFChecksum: WIFToPrivateKey failed"));
     }
 
-    std::string shortString = convertedString.substr(0, 66);
-    std::string checksum = convertedString.substr(66, convertedString.length());
-    std::string result = sha256(DecodeFromHex(sha256(DecodeFromHex(shortString))));
-
-    if (checksum != result.substr(0, 8))
+    unsigned char hash[safeheron::hash::CSHA256::OUTPUT_SIZE];
+    safeheron::hash::Hash256Short(hash, decoded, WIF_DECODED_SIZE - 4);
+    const bool matches = memcmp(hash, decoded + WIF_DECODED_SIZE - 4, 4) == 0;
+    SecureArena::wipe(decoded, sizeof(decoded));
+    if (!matches)
         throw std::invalid_argument("[ERROR]: checkWIFChecksum: checksum does not match WIF key");
 }
 
@@ -243,10 +357,16 @@ void ArgParser::parseKeyExpressionValue(const std::string &value) {
         }
     }
     else if (regex_match(value, matches, extendedPrivateKeys)) {
+        EccContextPool::Lease ecc = EccContextPool::acquire();
         btc_hdnode node;
         static btc_chainparams *chain = (btc_chainparams *)&btc_chainparams_main;
 
-        if (!btc_hdnode_deserialize(value.c_str(), chain, &node))
+        // only the key itself, without the key origin and the derivation suffix
+        size_t keyBegin = value.find(']');
+        keyBegin = keyBegin == std::string::npos ? 0 : keyBegin + 1;
+        const std::string key = value.substr(keyBegin, value.find('/', keyBegin) - keyBegin);
+
+        if (!btc_hdnode_deserialize(key.c_str(), chain, &node))
         {
             throw std::invalid_argument("[ERROR]: parseKeyExpressionValue: invalid extended key");
         }
@@ -434,6 +554,7 @@ void ArgParser::getDeriveKeyArgs(std::vector<std::string> *tmpArgValueVector, st
         throw std::runtime_error("[ERROR]: getDeriveKeyArgs: nullptr provided");
 
     std::string tmpArgValue;  // for CLI value
+    bool passphraseFound = false;
 
     for (auto iter = argList.begin(); iter != argList.end(); iter = next(iter)) {
         if (*iter == "derive-key") {
@@ -443,6 +564,37 @@ void ArgParser::getDeriveKeyArgs(std::vector<std::string> *tmpArgValueVector, st
             iter = next(iter);
             *filepath = *iter;
         }
+        else if (!this->mnemonicFlag && *iter == "--mnemonic") {
+            this->mnemonicFlag = true;
+        }
+        else if (!passphraseFound && (*iter == "--passphrase") && (next(iter) != argList.end())) {
+            iter = next(iter);
+            this->argPassphrase = *iter;
+            passphraseFound = true;
+        }
+        else if (!this->publicOnlyFlag && *iter == "--public-only") {
+            this->publicOnlyFlag = true;
+        }
+        else if (!this->privateOnlyFlag && *iter == "--private-only") {
+            this->privateOnlyFlag = true;
+        }
+        else if (!this->originFlag && *iter == "--origin") {
+            this->originFlag = true;
+        }
+        else if (this->argCacheFile.empty() && (*iter == "--cache") && (next(iter) != argList.end())) {
+            iter = next(iter);
+            this->argCacheFile = *iter;
+        }
+        else if (!this->cacheNoPrivateFlag && *iter == "--cache-no-private") {
+            this->cacheNoPrivateFlag = true;
+        }
+        else if (takeFormatArg(*iter)) {
+            continue;
+        }
+        else if (this->argThreads.empty() && (*iter == "--threads") && (next(iter) != argList.end())) {
+            iter = next(iter);
+            this->argThreads = *iter;
+        }
         else if (tmpArgValue.empty() && *iter != "-") {
             tmpArgValue = *iter;
         }
@@ -456,12 +608,119 @@ void ArgParser::getDeriveKeyArgs(std::vector<std::string> *tmpArgValueVector, st
             throw std::invalid_argument("[ERROR]: getDeriveKeyArgs: unsupported argument");
         }
     }
+
+    if (passphraseFound && !this->mnemonicFlag)
+        throw std::invalid_argument("[ERROR]: getDeriveKeyArgs: --passphrase requires --mnemonic");
+    if (this->publicOnlyFlag && this->privateOnlyFlag)
+        throw std::invalid_argument("[ERROR]: getDeriveKeyArgs: --public-only and --private-only are mutually exclusive");
+    if (this->cacheNoPrivateFlag && this->argCacheFile.empty())
+        throw std::invalid_argument("[ERROR]: getDeriveKeyArgs: --cache-no-private requires --cache");
     // Primarily works with vector form
     if ((*tmpArgValueVector).empty())
         (*tmpArgValueVector).push_back(tmpArgValue);
 }
 
 
+/**
+ * Returns "find-child" args from CLI.
+ * @param tmpArgValueVector empty vector, which function fills with the xpub
+ * @param pathTemplate empty template, which function fills with detected template (if present)
+ */
+void ArgParser::getFindChildArgs(std::vector<std::string> *tmpArgValueVector, std::string *pathTemplate) {
+    if (tmpArgValueVector == nullptr || pathTemplate == nullptr)
+        throw std::runtime_error("[ERROR]: getFindChildArgs: nullptr provided");
+
+    std::string tmpArgValue;  // for CLI value
+
+    for (auto iter = argList.begin(); iter != argList.end(); iter = next(iter)) {
+        if (*iter == "find-child") {
+            continue;
+        }
+        else if ((*pathTemplate).empty() && (*iter == "--path") && (next(iter) != argList.end())) {
+            iter = next(iter);
+            *pathTemplate = *iter;
+        }
+        else if (this->argTargets.empty() && (*iter == "--targets") && (next(iter) != argList.end())) {
+            iter = next(iter);
+            this->argTargets = *iter;
+        }
+        else if (this->argRange.empty() && (*iter == "--range") && (next(iter) != argList.end())) {
+            iter = next(iter);
+            this->argRange = *iter;
+        }
+        else if (this->argThreads.empty() && (*iter == "--threads") && (next(iter) != argList.end())) {
+            iter = next(iter);
+            this->argThreads = *iter;
+        }
+        else if (takeFormatArg(*iter)) {
+            continue;
+        }
+        else if (tmpArgValue.empty()) {
+            tmpArgValue = *iter;
+        }
+        else {
+            throw std::invalid_argument("[ERROR]: getFindChildArgs: unsupported argument");
+        }
+    }
+
+    if (this->argTargets.empty())
+        throw std::invalid_argument("[ERROR]: getFindChildArgs: --targets is required");
+    (*tmpArgValueVector).push_back(tmpArgValue);
+}
+
+
+/**
+ * Returns "scan" args from CLI.
+ * @param tmpArgValueVector empty vector, which function fills with the xpubs or descriptors
+ */
+void ArgParser::getScanArgs(std::vector<std::string> *tmpArgValueVector) {
+    if (tmpArgValueVector == nullptr)
+        throw std::runtime_error("[ERROR]: getScanArgs: nullptr provided");
+
+    std::string tmpArgValue;  // for CLI value
+
+    for (auto iter = argList.begin(); iter != argList.end(); iter = next(iter)) {
+        if (*iter == "scan") {
+            continue;
+        }
+        else if (this->argUsed.empty() && (*iter == "--used") && (next(iter) != argList.end())) {
+            iter = next(iter);
+            this->argUsed = *iter;
+        }
+        else if (this->argGap.empty() && (*iter == "--gap") && (next(iter) != argList.end())) {
+            iter = next(iter);
+            this->argGap = *iter;
+        }
+        else if (this->argThreads.empty() && (*iter == "--threads") && (next(iter) != argList.end())) {
+            iter = next(iter);
+            this->argThreads = *iter;
+        }
+        else if (takeFormatArg(*iter)) {
+            continue;
+        }
+        else if (tmpArgValue.empty() && (*tmpArgValueVector).empty() && *iter != "-") {
+            tmpArgValue = *iter;
+        }
+        else if (tmpArgValue.empty() && (*tmpArgValueVector).empty() && *iter == "-") {
+            std::string line;
+            while (getline(std::cin, line))
+                if (!line.empty())
+                    (*tmpArgValueVector).push_back(line);
+        }
+        else {
+            throw std::invalid_argument("[ERROR]: getScanArgs: unsupported argument");
+        }
+    }
+
+    if (this->argUsed.empty())
+        throw std::invalid_argument("[ERROR]: getScanArgs: --used is required");
+    if (!tmpArgValue.empty())
+        (*tmpArgValueVector).push_back(tmpArgValue);
+    if ((*tmpArgValueVector).empty())
+        throw std::invalid_argument("[ERROR]: getScanArgs: no xpub or descriptor provided");
+}
+
+
 /**
  * Returns "key-expression" args from CLI.
  * @param tmpArgValueVector empty vector, which function fills with detected expressions
@@ -476,6 +735,9 @@ void ArgParser::getKeyExpressionArgs(std::vector<std::string> *tmpArgValueVector
         if (arg == "key-expression") {
             continue;
         }
+        else if (takeFormatArg(arg)) {
+            continue;
+        }
         else if (tmpArgValue.empty() && arg != "-") {
             tmpArgValue = arg;
         }
@@ -510,6 +772,9 @@ void ArgParser::getScriptExpressionArgs(std::vector<std::string> *tmpArgValueVec
         if (arg == "script-expression") {
             continue;
         }
+        else if (takeFormatArg(arg)) {
+            continue;
+        }
         else if (!*verifyChecksumFlag && (arg == "--verify-checksum")) {
             this->verifyChecksumFlag = true;
         }
@@ -556,8 +821,35 @@ void ArgParser::parseDeriveKey() {
     }
 
     try {
-        for (const auto &value : tmpArgValueVector)
-            parseDeriveKeyValue(value);
+        parseFormat(this->argFormat, true, true);
+    }
+    catch (std::exception &ex) {
+        throw_with_nested(std::invalid_argument("[ERROR]: parseDeriveKey: invalid format"));
+    }
+    if (this->originFlag && getFormat() == OutputFormat::Binary)
+        throw std::invalid_argument("[ERROR]: parseDeriveKey: --origin is not supported with --format=bin");
+    if (this->originFlag && getFormat() == OutputFormat::Address)
+        throw std::invalid_argument("[ERROR]: parseDeriveKey: --origin is not supported with --format=address");
+    if (this->privateOnlyFlag && getFormat() == OutputFormat::Address)
+        throw std::invalid_argument("[ERROR]: parseDeriveKey: --private-only is not supported with --format=address");
+
+    if (!this->argThreads.empty()) {
+        try {
+            parseThreadCount(this->argThreads);
+        }
+        catch (std::exception &ex) {
+            throw_with_nested(std::invalid_argument("[ERROR]: parseDeriveKey: invalid thread count"));
+        }
+    }
+
+    try {
+        validatePassphrase(this->argPassphrase);
+        for (const auto &value : tmpArgValueVector) {
+            if (this->mnemonicFlag)
+                parseMnemonicValue(value);
+            else
+                parseDeriveKeyValue(value);
+        }
     }
     catch (std::exception &ex) {
         throw_with_nested(std::invalid_argument("[ERROR]: parseDeriveKey: invalid value(s)"));
@@ -576,6 +868,13 @@ void ArgParser::parseKeyExpression() {
     std::vector<std::string> tmpArgValueVector;
     getKeyExpressionArgs(&tmpArgValueVector);
 
+    try {
+        parseFormat(this->argFormat, false, false);
+    }
+    catch (std::exception &ex) {
+        throw_with_nested(std::invalid_argument("[ERROR]: parseKeyExpression: invalid format"));
+    }
+
     try {
         for (const auto &value : tmpArgValueVector)
             parseKeyExpressionValue(value);
@@ -597,6 +896,15 @@ void ArgParser::parseScriptExpression() {
     this->computeChecksumFlag = false;
     getScriptExpressionArgs(&tmpArgValueVector, &verifyChecksumFlag, &computeChecksumFlag);
 
+    try {
+        parseFormat(this->argFormat, false, true);
+    }
+    catch (std::exception &ex) {
+        throw_with_nested(std::invalid_argument("[ERROR]: parseScriptExpression: invalid format"));
+    }
+    if (this->computeChecksumFlag && getFormat() == OutputFormat::Address)
+        throw std::invalid_argument("[ERROR]: parseScriptExpression: --compute-checksum is not supported with --format=address");
+
     try {
         for (const auto &value : tmpArgValueVector)
             parseScriptExpressionValue(value);
@@ -609,6 +917,92 @@ void ArgParser::parseScriptExpression() {
 }
 
 
+/**
+ * Function parses find-child command arguments
+ */
+void ArgParser::parseFindChild() {
+    std::vector<std::string> tmpArgValueVector;
+    std::string pathTemplate;
+    getFindChildArgs(&tmpArgValueVector, &pathTemplate);
+
+    if (pathTemplate.empty())
+        pathTemplate = "*";
+    try {
+        parsePathTemplate(pathTemplate);
+    }
+    catch (std::exception &ex) {
+        throw_with_nested(std::invalid_argument("[ERROR]: parseFindChild: invalid path template"));
+    }
+
+    try {
+        parseFormat(this->argFormat, false, false);
+    }
+    catch (std::exception &ex) {
+        throw_with_nested(std::invalid_argument("[ERROR]: parseFindChild: invalid format"));
+    }
+
+    try {
+        if (!this->argRange.empty())
+            parseRange(this->argRange);
+        if (!this->argThreads.empty())
+            parseThreadCount(this->argThreads);
+    }
+    catch (std::exception &ex) {
+        throw_with_nested(std::invalid_argument("[ERROR]: parseFindChild: invalid range or thread count"));
+    }
+
+    const std::string &xpub = tmpArgValueVector.front();
+    if (!regex_match(xpub, std::regex("^xpub[1-9A-HJ-NP-Za-km-z]{20,111}$"))) {
+        throw std::invalid_argument("[ERROR]: parseFindChild: value is not an xpub");
+    }
+    {
+        EccContextPool::Lease ecc = EccContextPool::acquire();
+        btc_hdnode node;
+        if (!btc_hdnode_deserialize(xpub.c_str(), &btc_chainparams_main, &node))
+            throw std::invalid_argument("[ERROR]: parseFindChild: invalid extended key");
+    }
+
+    this->argFilepath = pathTemplate;
+    this->argValuesVector = tmpArgValueVector;
+}
+
+
+/**
+ * Function parses scan command arguments
+ */
+void ArgParser::parseScan() {
+    std::vector<std::string> tmpArgValueVector;
+    getScanArgs(&tmpArgValueVector);
+
+    try {
+        parseFormat(this->argFormat, false, false);
+    }
+    catch (std::exception &ex) {
+        throw_with_nested(std::invalid_argument("[ERROR]: parseScan: invalid format"));
+    }
+
+    try {
+        if (!this->argGap.empty())
+            parseGap(this->argGap);
+        if (!this->argThreads.empty())
+            parseThreadCount(this->argThreads);
+    }
+    catch (std::exception &ex) {
+        throw_with_nested(std::invalid_argument("[ERROR]: parseScan: invalid gap or thread count"));
+    }
+
+    try {
+        for (const auto &value : tmpArgValueVector)
+            parseScanSource(value);
+    }
+    catch (std::exception &ex) {
+        throw_with_nested(std::invalid_argument("[ERROR]: parseScan: invalid xpub or descriptor"));
+    }
+
+    this->argValuesVector = tmpArgValueVector;
+}
+
+
 /**
  * The main function for parsing all CLI arguments
  */
@@ -632,6 +1026,10 @@ void ArgParser::parse() {
         parseKeyExpression();
     else if (argExists("script-expression"))
         parseScriptExpression();
+    else if (argExists("find-child"))
+        parseFindChild();
+    else if (argExists("scan"))
+        parseScan();
 }
 
 
@@ -671,6 +1069,129 @@ bool ArgParser::getComputeChecksumFlag() const {
 }
 
 
+/**
+ * Public getter for the Mnemonic flag
+ * @return true if argument is provided, false if otherwise
+ */
+bool ArgParser::getMnemonicFlag() const {
+    return this->mnemonicFlag;
+}
+
+
+/**
+ * Public getter for the PublicOnly flag
+ * @return true if argument is provided, false if otherwise
+ */
+bool ArgParser::getPublicOnlyFlag() const {
+    return this->publicOnlyFlag;
+}
+
+
+/**
+ * Public getter for the PrivateOnly flag
+ * @return true if argument is provided, false if otherwise
+ */
+bool ArgParser::getPrivateOnlyFlag() const {
+    return this->privateOnlyFlag;
+}
+
+
+/**
+ * Public getter for the Origin flag
+ * @return true if argument is provided, false if otherwise
+ */
+bool ArgParser::getOriginFlag() const {
+    return this->originFlag;
+}
+
+
+/**
+ * Public getter for the derive-key node cache file
+ * @return path of the cache file, empty if not provided
+ */
+std::string ArgParser::getCacheFile() const {
+    return this->argCacheFile;
+}
+
+
+/**
+ * Public getter for the CacheNoPrivate flag
+ * @return true if argument is provided, false if otherwise
+ */
+bool ArgParser::getCacheNoPrivateFlag() const {
+    return this->cacheNoPrivateFlag;
+}
+
+
+/**
+ * Public getter for the find-child targets file
+ * @return path of the targets file
+ */
+std::string ArgParser::getTargetsFile() const {
+    return this->argTargets;
+}
+
+
+/**
+ * Public getter for the find-child search range
+ * @return number of child indices to search, DEFAULT_CHILD_SEARCH_RANGE if not provided
+ */
+uint32_t ArgParser::getRange() const {
+    return this->argRange.empty() ? DEFAULT_CHILD_SEARCH_RANGE : static_cast<uint32_t>(std::stoul(this->argRange));
+}
+
+
+/**
+ * Public getter for the scan used address file
+ * @return path of the used file
+ */
+std::string ArgParser::getUsedFile() const {
+    return this->argUsed;
+}
+
+
+/**
+ * Public getter for the scan gap limit
+ * @return number of consecutive unused addresses that ends a chain, DEFAULT_SCAN_GAP if not provided
+ */
+uint32_t ArgParser::getGap() const {
+    return this->argGap.empty() ? DEFAULT_SCAN_GAP : static_cast<uint32_t>(std::stoul(this->argGap));
+}
+
+
+/**
+ * Public getter for the output format
+ * @return format selected with --format=, OutputFormat::Text if not provided
+ */
+OutputFormat ArgParser::getFormat() const {
+    if (this->argFormat == "bin")
+        return OutputFormat::Binary;
+    if (this->argFormat == "ndjson")
+        return OutputFormat::Ndjson;
+    if (this->argFormat == "address")
+        return OutputFormat::Address;
+    return OutputFormat::Text;
+}
+
+
+/**
+ * Public getter for the derive-key worker thread count
+ * @return number of threads, 0 if not provided (one per CPU)
+ */
+unsigned ArgParser::getThreadCount() const {
+    return this->argThreads.empty() ? 0 : static_cast<unsigned>(std::stoul(this->argThreads));
+}
+
+
+/**
+ * Public getter for the BIP39 passphrase (if present)
+ * @return passphrase if provided
+ */
+std::string ArgParser::getPassphrase() {
+    return this->argPassphrase;
+}
+
+
 void ArgParser::loadArguments(int argc, char **argv) {
     for (int x = 1; x < argc; x++) {
         if (strlen(argv[x]) > 3000)
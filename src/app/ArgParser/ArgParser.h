@@ -15,10 +15,14 @@
 #include <vector>
 #include <regex>
 
+#include "../Utility/OutputFormat.h"
+
 const std::string KEY_ORIGIN_REGEX = "(\\[(\\d|[a-f]|[A-F]){8}(\\/\\dh?)*\\])?";
 
 const std::string SIMPLE_KEY_EXPRESSION_VALUE_REGEX = KEY_ORIGIN_REGEX + R"(((02|03)(\d|[a-f]|[A-F]){64})|((04)(\d|[a-f]|[A-F]){128}))";
 const std::string WIF_REGEX = KEY_ORIGIN_REGEX + "5([0-9]|[a-z]|[A-Z]){50}";
+/** Decoded WIF key accepted by WIF_REGEX: version byte, 32-byte private key and 4-byte checksum. */
+const size_t WIF_DECODED_SIZE = 37;
 const std::string EXTENDED_PRIVATE_KEYS_REGEX = KEY_ORIGIN_REGEX + "(xprv|xpub)[1-9A-HJ-NP-Za-km-z]{20,111}(\\/\\d+(H|h|')?)*(\\/\\*)?h?";
 const std::string PURE_PRIVATE_KEYS_REGEX = "(xprv|xpub)[1-9A-HJ-NP-Za-km-z]{20,111}";
 
@@ -30,6 +34,7 @@ const std::string MULTI_REGEX = "multi\\(( *\\d+ *( *, *( *(" + SIMPLE_KEY_EXPRE
 const std::string SH_PK_REGEX = "sh\\( *" + PK_REGEX + " *\\) *";
 const std::string SH_PKH_REGEX = "sh\\( *" + PKH_REGEX + " *\\) *";
 const std::string SH_MULTI_REGEX = "sh\\( *" + MULTI_REGEX + " *\\) *";
+
 const std::string RAW_REGEX = "raw\\((\\d|[a-f]|[A-F]| )+\\) *";
 
 
@@ -41,15 +46,33 @@ private:
     std::string argFilepath;  // Contains the filepath from argument, if provided
     bool verifyChecksumFlag = false;  // flag for script expressions
     bool computeChecksumFlag = false;  // flag for script expressions
+    bool mnemonicFlag = false;  // flag for derive-key, values are BIP39 mnemonics
+    std::string argPassphrase;  // BIP39 passphrase for derive-key, if provided
+    std::string argThreads;  // worker thread count for derive-key, if provided
+    bool publicOnlyFlag = false;  // flag for derive-key, print only xpubs
+    bool privateOnlyFlag = false;  // flag for derive-key, print only xprvs
+    bool originFlag = false;  // flag for derive-key, prefix keys with their key origin
+    std::string argCacheFile;  // node cache file for derive-key, if provided
+    bool cacheNoPrivateFlag = false;  // flag for derive-key, keep private keys out of the node cache
+    std::string argTargets;  // targets file for find-child
+    std::string argRange;  // number of child indices for find-child, if provided
+    std::string argUsed;  // used address file for scan
+    std::string argGap;  // gap limit for scan, if provided
+    std::string argFormat;  // output format from --format=, if provided (all sub-commands)
 
     static void printHelp();
     bool multipleArgsExist(const std::string &arg);
     bool invalidKeyArgsAmount();
     bool invalidKeyArgsPosition();
-    static std::string sha256(const std::string &value);
     static void parseDeriveKeyValue(const std::string &value);
+    static void parseMnemonicValue(const std::string &value);
+    static void parseThreadCount(const std::string &value);
+    static void parseFormat(const std::string &format, bool allowBinary, bool allowAddress);
+    bool takeFormatArg(const std::string &arg);
     static void parseFilepath(const std::string &filepath);
-    static std::string WIFToPrivateKey(const std::string &WIFKey);
+    static void parseRange(const std::string &value);
+    static void parseGap(const std::string &value);
+    static void WIFToPrivateKey(const std::string &WIFKey, unsigned char decoded[WIF_DECODED_SIZE]);
     static void checkWIFChecksum(const std::string &WIFKey);
     static void parseKeyExpressionValue(const std::string &value);
     void parseScriptExpressionValue(std::string value);
@@ -61,12 +84,16 @@ private:
     bool checkRawExpression(std::string str, std::string checksumRegex);
 
     void getDeriveKeyArgs(std::vector<std::string> *tmpArgValueVector, std::string *filepath);
+    void getFindChildArgs(std::vector<std::string> *tmpArgValueVector, std::string *pathTemplate);
+    void getScanArgs(std::vector<std::string> *tmpArgValueVector);
     void getKeyExpressionArgs(std::vector<std::string> *tmpArgValueVector);
     void getScriptExpressionArgs(std::vector<std::string> *tmpArgValueVector, bool *verifyChecksumFlag, bool *computeChecksumFlag);
 
     void parseDeriveKey();
     void parseKeyExpression();
     void parseScriptExpression();
+    void parseFindChild();
+    void parseScan();
 
 public:
     ArgParser();
@@ -78,6 +105,19 @@ public:
     std::string getFilepath();
     bool getVerifyChecksumFlag() const;
     bool getComputeChecksumFlag() const;
+    bool getMnemonicFlag() const;
+    std::string getPassphrase();
+    unsigned getThreadCount() const;
+    bool getPublicOnlyFlag() const;
+    bool getPrivateOnlyFlag() const;
+    bool getOriginFlag() const;
+    std::string getCacheFile() const;
+    bool getCacheNoPrivateFlag() const;
+    std::string getTargetsFile() const;
+    uint32_t getRange() const;
+    std::string getUsedFile() const;
+    uint32_t getGap() const;
+    OutputFormat getFormat() const;
 
 
 };
@@ -17,41 +17,68 @@ namespace encode {
 namespace base58 {
 
 std::string EncodeToBase58(const std::string &data){
-    std::vector<unsigned char> vch(data.begin(), data.end());
-    return _internal::EncodeBase58(vch);
+    return EncodeToBase58((unsigned char const *)data.data(), data.size());
 }
 std::string EncodeToBase58(unsigned char const *buf, size_t buf_len){
-    std::vector<unsigned char> vch(buf, buf + buf_len);
-    return _internal::EncodeBase58(vch);
+    std::string str_ret(Base58MaxEncodedLength(buf_len), '\0');
+    size_t length = 0;
+    EncodeToBase58(buf, buf_len, &str_ret[0], str_ret.size(), &length);
+    str_ret.resize(length);
+    return str_ret;
 }
 
 std::string DecodeFromBase58(const std::string &base58){
-    std::vector<unsigned char> vch_ret;
-    bool success = _internal::DecodeBase58(base58, vch_ret);
-    if(!success) throw std::runtime_error("Failed in _internal::DecodeBase58.");
-    std::string str_ret(vch_ret.begin(), vch_ret.end());
+    std::string str_ret(base58.size(), '\0');
+    size_t size = 0;
+    if(DecodeFromBase58(base58, (unsigned char *)&str_ret[0], str_ret.size(), &size) != Base58Status::Ok)
+        throw std::runtime_error("Failed in _internal::DecodeBase58.");
+    str_ret.resize(size);
     return str_ret;
 }
 
 
 std::string EncodeToBase58Check(const std::string &data){
-    std::vector<unsigned char> vch(data.begin(), data.end());
-    return _internal::EncodeBase58Check(vch);
+    return EncodeToBase58Check((unsigned char const *)data.data(), data.size());
 }
 
 std::string EncodeToBase58Check(unsigned char const *buf, size_t buf_len){
-    std::vector<unsigned char> vch(buf, buf + buf_len);
-    return _internal::EncodeBase58Check(vch);
+    std::string str_ret(Base58MaxEncodedLength(buf_len + 4), '\0');
+    size_t length = 0;
+    EncodeToBase58Check(buf, buf_len, &str_ret[0], str_ret.size(), &length);
+    str_ret.resize(length);
+    return str_ret;
 }
 
 std::string DecodeFromBase58Check(const std::string &base58){
-    std::vector<unsigned char> vch_ret;
-    bool success = _internal::DecodeBase58Check(base58, vch_ret);
-    if(!success) throw std::runtime_error("Failed in _internal::DecodeBase58.");
-    std::string str_ret(vch_ret.begin(), vch_ret.end());
+    std::string str_ret(base58.size(), '\0');
+    size_t size = 0;
+    if(DecodeFromBase58Check(base58, (unsigned char *)&str_ret[0], str_ret.size(), &size) != Base58Status::Ok)
+        throw std::runtime_error("Failed in _internal::DecodeBase58.");
+    str_ret.resize(size);
     return str_ret;
 }
 
+Base58Status EncodeToBase58(unsigned char const *buf, size_t buf_len, char *out, size_t capacity, size_t *length){
+    return _internal::EncodeBase58(buf, buf_len, out, capacity, length);
+}
+
+Base58Status DecodeFromBase58(std::string_view base58, unsigned char *out, size_t capacity, size_t *size){
+    return _internal::DecodeBase58(base58, out, capacity, size);
+}
+
+Base58Status EncodeToBase58Check(unsigned char const *buf, size_t buf_len, char *out, size_t capacity, size_t *length){
+    return _internal::EncodeBase58Check(buf, buf_len, out, capacity, length);
+}
+
+Base58Status DecodeFromBase58Check(std::string_view base58, unsigned char *out, size_t capacity, size_t *size){
+    return _internal::DecodeBase58Check(base58, out, capacity, size);
+}
+
+void DecodeFromBase58CheckBatch(const std::string_view *base58, size_t count, unsigned char *out, size_t stride,
+                                size_t *sizes, Base58Status *statuses){
+    _internal::DecodeBase58CheckBatch(base58, count, out, stride, sizes, statuses);
+}
+
 }
 }
 }
@@ -15,7 +15,9 @@
 #ifndef SAFEHERON_BASE58_H
 #define SAFEHERON_BASE58_H
 
+#include <stddef.h>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace safeheron {
@@ -31,6 +33,25 @@ namespace base58 {
  * - Double-clicking selects the whole string as one word if it's all alphanumeric.
  */
 
+/**
+ * Outcome of the buffer-based encoders and decoders.
+ */
+enum class Base58Status {
+    Ok,
+    InvalidCharacter,  // a character outside the base58 alphabet, or whitespace inside the string
+    BufferTooSmall,  // the result does not fit into the caller's buffer
+    BadChecksum,  // base58check data shorter than its checksum, or a checksum mismatch
+};
+
+/**
+ * Upper bound of the base58 length of size bytes (log(256) / log(58) < 1.38 characters per byte).
+ * @param size number of bytes
+ * @return maximum number of characters, excluding any terminator
+ */
+constexpr size_t Base58MaxEncodedLength(size_t size) {
+    return size * 138 / 100 + 1;
+}
+
 /**
  * Encode from bytes to base58.
  * @param data in bytes.
@@ -76,6 +97,68 @@ std::string EncodeToBase58Check(unsigned char const *buf, size_t buf_len);
  */
 std::string DecodeFromBase58Check(const std::string &base58);
 
+/*
+ * Buffer-based variants: they read from the caller's memory, write into the caller's buffer and
+ * report failures through the status, so they neither allocate nor throw. Output buffers are
+ * not null terminated.
+ */
+
+/**
+ * Encode from bytes to base58.
+ * @param buf
+ * @param buf_len
+ * @param out output buffer, Base58MaxEncodedLength(buf_len) characters always suffice
+ * @param capacity size of out
+ * @param length number of characters written on success
+ * @return Ok or BufferTooSmall
+ */
+Base58Status EncodeToBase58(unsigned char const *buf, size_t buf_len, char *out, size_t capacity, size_t *length);
+
+/**
+ * Decode from base58 to bytes.
+ * @param base58
+ * @param out output buffer, base58.size() bytes always suffice
+ * @param capacity size of out
+ * @param size number of bytes written on success
+ * @return Ok, InvalidCharacter or BufferTooSmall
+ */
+Base58Status DecodeFromBase58(std::string_view base58, unsigned char *out, size_t capacity, size_t *size);
+
+/**
+ * Encode from bytes to base58check.
+ * @param buf
+ * @param buf_len
+ * @param out output buffer, Base58MaxEncodedLength(buf_len + 4) characters always suffice
+ * @param capacity size of out
+ * @param length number of characters written on success
+ * @return Ok or BufferTooSmall
+ */
+Base58Status EncodeToBase58Check(unsigned char const *buf, size_t buf_len, char *out, size_t capacity, size_t *length);
+
+/**
+ * Decode from base58check string to bytes, without the checksum.
+ * @param base58
+ * @param out output buffer
+ * @param capacity size of out
+ * @param size payload length on success
+ * @return Ok, InvalidCharacter, BadChecksum or BufferTooSmall
+ */
+Base58Status DecodeFromBase58Check(std::string_view base58, unsigned char *out, size_t capacity, size_t *size);
+
+/**
+ * Decode a list of base58check strings, e.g. WIF keys or extended keys read from a file.
+ * Equivalent to calling DecodeFromBase58Check on every entry, but the checksums of up to eight
+ * entries are double-hashed together.
+ * @param base58 count strings
+ * @param count number of strings
+ * @param out output buffer of count * stride bytes; entry i is written to out + i * stride
+ * @param stride capacity of every entry
+ * @param sizes count payload lengths, set for the entries that decoded successfully
+ * @param statuses count outcomes
+ */
+void DecodeFromBase58CheckBatch(const std::string_view *base58, size_t count, unsigned char *out, size_t stride,
+                                size_t *sizes, Base58Status *statuses);
+
 }
 }
 }
@@ -0,0 +1,104 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file base58_fixed.h
+ * @brief Base58Check encoder specialised at compile time for a fixed payload length
+ * @date 2026-10-18
+ *
+ * The generic encoder in base58_imp.cpp converts one input byte at a time into a
+ * base58 digit array, which is quadratic in the number of digits. Here the payload and
+ * its checksum are loaded into 64-bit limbs and repeatedly divided by 58^10, so every
+ * pass over the limbs produces ten digits at once. All buffer sizes follow from the
+ * payload length, so nothing is allocated.
+ */
+
+#ifndef BASE58_FIXED_H
+#define BASE58_FIXED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../crypto-hash/sha256.h"
+
+namespace safeheron {
+namespace encode {
+namespace base58 {
+
+/**
+ * 58^10, the number of values of ten base58 digits. A 64-bit limb times it fits in 128 bits, so
+ * both this encoder and the decoder in base58_imp.cpp convert ten digits per limb pass.
+ */
+static const uint64_t BASE58_RADIX_10 = 430804206899405824ull;
+
+/** Sizes derived from the payload length N. */
+template<size_t N>
+struct Base58CheckFixedSize {
+    /** Payload plus the 4-byte checksum. */
+    static const size_t DATA_SIZE = N + 4;
+    /** Number of 64-bit limbs holding the data. */
+    static const size_t LIMBS = (DATA_SIZE + 7) / 8;
+    /** Upper bound of the encoded length (log(256) / log(58) < 1.365659), excluding the terminator. */
+    static const size_t MAX_LENGTH = DATA_SIZE * 1365659 / 1000000 + 1;
+};
+
+/**
+ * Encode a fixed-length payload to base58check.
+ * @param data payload bytes
+ * @param out output buffer of at least Base58CheckFixedSize<N>::MAX_LENGTH + 1 characters, null terminated on return
+ * @return length of the encoded string
+ */
+template<size_t N>
+size_t EncodeToBase58CheckFixed(const unsigned char (&data)[N], char *out) {
+    __extension__ typedef unsigned __int128 uint128;
+    typedef Base58CheckFixedSize<N> Size;
+    static const char alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+    unsigned char checksum[32];
+    if (N <= safeheron::hash::SHA256_SHORT_MAX_LEN)
+        safeheron::hash::Hash256Short(checksum, data, N);
+    else
+        safeheron::hash::SHA256D(checksum, data, N);
+
+    // Big-endian limbs, limbs[0] is the most significant one and holds the leftover bytes.
+    uint64_t limbs[Size::LIMBS] = {0};
+    for (size_t i = 0; i < Size::DATA_SIZE; i++) {
+        unsigned char byte = i < N ? data[i] : checksum[i - N];
+        size_t pos = Size::LIMBS * 8 - Size::DATA_SIZE + i;
+        limbs[pos / 8] = (limbs[pos / 8] << 8) | byte;
+    }
+
+    // Digits are produced least significant first, ten per division pass.
+    char digits[(Size::MAX_LENGTH + 9) / 10 * 10];
+    size_t digitCount = 0;
+    size_t first = 0;
+    while (first < Size::LIMBS && limbs[first] == 0) first++;
+    while (first < Size::LIMBS) {
+        uint64_t rem = 0;
+        for (size_t i = first; i < Size::LIMBS; i++) {
+            uint128 cur = ((uint128)rem << 64) | limbs[i];
+            limbs[i] = (uint64_t)(cur / BASE58_RADIX_10);
+            rem = (uint64_t)(cur % BASE58_RADIX_10);
+        }
+        while (first < Size::LIMBS && limbs[first] == 0) first++;
+        for (int j = 0; j < 10; j++) {
+            digits[digitCount++] = (char)(rem % 58);
+            rem /= 58;
+        }
+    }
+
+    // Drop the zero digits above the most significant one, then emit a '1' per leading zero byte.
+    while (digitCount > 0 && digits[digitCount - 1] == 0) digitCount--;
+    size_t zeroes = 0;
+    while (zeroes < Size::DATA_SIZE && (zeroes < N ? data[zeroes] : checksum[zeroes - N]) == 0) zeroes++;
+
+    size_t length = 0;
+    for (size_t i = 0; i < zeroes; i++) out[length++] = '1';
+    while (digitCount > 0) out[length++] = alphabet[(int)digits[--digitCount]];
+    out[length] = '\0';
+    return length;
+}
+
+}
+}
+}
+
+#endif // BASE58_FIXED_H
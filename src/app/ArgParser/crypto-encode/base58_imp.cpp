@@ -9,13 +9,17 @@
 
 #pragma GCC diagnostic ignored "-Wunused-variable"
 
-#include "base58.h"
+#include "base58_imp.h"
 
 #include <assert.h>
+#include <ctype.h>
 #include <string.h>
-#include "../crypto-hash/hash256.h"
+#include "base58_fixed.h"
+#include "../crypto-hash/sha256.h"
 
-using safeheron::hash::CHash256;
+using safeheron::encode::base58::BASE58_RADIX_10;
+using safeheron::hash::CSHA256;
+using safeheron::hash::SHA256_LANES;
 
 /** All alphanumeric characters except for "0", "I", "O", and "l" */
 static const char* pszBase58 = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
@@ -38,153 +42,348 @@ static const int8_t mapBase58[256] = {
     -1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,
 };
 
+__extension__ typedef unsigned __int128 uint128;
+
+/** 58^5, the radix of the encoder's 32-bit limb passes. */
+static const uint64_t BASE58_RADIX_5 = 656356768ull;
+
+/** Number of base58 digits per limb step. */
+static const int BASE58_DIGITS_PER_STEP = 10;
+
+/** Powers 58^0 .. 58^10, for the last, partial step of the decoder. */
+static const uint64_t BASE58_POWERS[BASE58_DIGITS_PER_STEP + 1] = {
+    1ull, 58ull, 3364ull, 195112ull, 11316496ull, 656356768ull, 38068692544ull, 2207984167552ull,
+    128063081718016ull, 7427658739644928ull, 430804206899405824ull,
+};
+
+/** Number of 64-bit limbs kept on the stack; covers inputs of up to 256 bytes (349 base58 characters). */
+static const size_t BASE58_STACK_LIMBS = 32;
+
+/** Longest string decoded in the lanes of DecodeBase58CheckBatch (a 78-byte extended key has 111 characters). */
+static const size_t BASE58_BATCH_MAX_LENGTH = 128;
+
+/**
+ * Scratch array of a size known at runtime: on the stack up to N elements, on the heap above.
+ * Elements are zero-initialised.
+ */
+template<typename T, size_t N>
+class ScratchBuffer {
+public:
+    explicit ScratchBuffer(size_t size) : ptr(stack) {
+        if (size > N) {
+            heap.assign(size, T());
+            ptr = heap.data();
+        } else {
+            memset(stack, 0, sizeof(stack));
+        }
+    }
+    T *data() { return ptr; }
+
+private:
+    T stack[N];
+    std::vector<T> heap;
+    T *ptr;
+};
+
 namespace safeheron {
 namespace encode {
 namespace base58 {
 namespace _internal {
 
-bool DecodeBase58(const char *psz, std::vector<unsigned char> &vch) {
+/*
+ * The number is kept in machine-word limbs: the decoder consumes ten base58 digits per pass
+ * (radix 58^10, one 64x64->128-bit multiply per limb) and the encoder produces five per pass
+ * (radix 58^5, one 64/32-bit division by a constant per limb), instead of one byte-sized step
+ * per digit. Both directions are still quadratic, but with a much smaller constant.
+ */
+
+Base58Status DecodeBase58(std::string_view str, unsigned char *out, size_t capacity, size_t *size) {
+    const char *psz = str.data();
+    const char *end = psz + str.size();
     // Skip leading spaces.
-    while (*psz && isspace(*psz))
+    while (psz != end && isspace((unsigned char) *psz))
         psz++;
     // Skip and count leading '1's.
-    int zeroes = 0;
-    int length = 0;
-    while (*psz == '1') {
+    size_t zeroes = 0;
+    while (psz != end && *psz == '1') {
         zeroes++;
         psz++;
     }
-    // Allocate enough space in big-endian base256 representation.
-    int size = strlen(psz) * 733 / 1000 + 1; // log(58) / log(256), rounded up.
-    std::vector<unsigned char> b256(size);
-    // Process the characters.
+    // Little-endian limbs, enough for log(58) / log(256) bytes per character, rounded up.
+    const size_t limbCapacity = (end - psz) * 733 / 1000 / 8 + 2;
+    ScratchBuffer<uint64_t, BASE58_STACK_LIMBS> buffer(limbCapacity);
+    uint64_t *limbs = buffer.data();
+    size_t used = 0;
+
+    // Apply "limbs = limbs * radix + chunk".
+    auto mulAdd = [&](uint64_t radix, uint64_t chunk) {
+        uint64_t carry = chunk;
+        for (size_t i = 0; i < used; i++) {
+            const uint128 cur = (uint128) limbs[i] * radix + carry;
+            limbs[i] = (uint64_t) cur;
+            carry = (uint64_t) (cur >> 64);
+        }
+        if (carry != 0) {
+            assert(used < limbCapacity);
+            limbs[used++] = carry;
+        }
+    };
+
+    // Process the characters, ten at a time.
     static_assert(sizeof(mapBase58) / sizeof(mapBase58[0]) == 256,
                   "mapBase58.size() should be 256"); // guarantee not out of range
-    while (*psz && !isspace(*psz)) {
+    uint64_t chunk = 0;
+    int digits = 0;
+    while (psz != end && !isspace((unsigned char) *psz)) {
         // Decode base58 character
-        int carry = mapBase58[(uint8_t) *psz];
-        if (carry == -1)  // Invalid b58 character
-            return false;
-        int i = 0;
-        for (std::vector<unsigned char>::reverse_iterator it = b256.rbegin();
-             (carry != 0 || i < length) && (it != b256.rend()); ++it, ++i) {
-            carry += 58 * (*it);
-            *it = carry % 256;
-            carry /= 256;
+        const int digit = mapBase58[(uint8_t) *psz];
+        if (digit == -1)  // Invalid b58 character
+            return Base58Status::InvalidCharacter;
+        chunk = chunk * 58 + digit;
+        if (++digits == BASE58_DIGITS_PER_STEP) {
+            mulAdd(BASE58_RADIX_10, chunk);
+            chunk = 0;
+            digits = 0;
         }
-        assert(carry == 0);
-        length = i;
         psz++;
     }
+    if (digits > 0)
+        mulAdd(BASE58_POWERS[digits], chunk);
     // Skip trailing spaces.
-    while (isspace(*psz))
+    while (psz != end && isspace((unsigned char) *psz))
         psz++;
-    if (*psz != 0)
-        return false;
-    // Skip leading zeroes in b256.
-    std::vector<unsigned char>::iterator it = b256.begin() + (size - length);
-    while (it != b256.end() && *it == 0)
-        it++;
-    // Copy result into output vector.
-    vch.reserve(zeroes + (b256.end() - it));
-    vch.assign(zeroes, 0x00);
-    while (it != b256.end())
-        vch.push_back(*(it++));
-    return true;
+    if (psz != end)
+        return Base58Status::InvalidCharacter;
+
+    // Copy the result into the output buffer, big-endian and without leading zero bytes.
+    size_t bytes = used * 8;
+    while (bytes > 0 && (limbs[(bytes - 1) / 8] >> ((bytes - 1) % 8 * 8) & 0xff) == 0)
+        bytes--;
+    if (zeroes + bytes > capacity)
+        return Base58Status::BufferTooSmall;
+    if (zeroes > 0)
+        memset(out, 0, zeroes);
+    *size = zeroes + bytes;
+    while (bytes > 0) {
+        bytes--;
+        out[*size - 1 - bytes] = (unsigned char) (limbs[bytes / 8] >> (bytes % 8 * 8));
+    }
+    return Base58Status::Ok;
 }
 
-std::string EncodeBase58(const unsigned char *pbegin, const unsigned char *pend) {
+Base58Status EncodeBase58(const unsigned char *data, size_t size, char *out, size_t capacity, size_t *length) {
+    const unsigned char *pbegin = data;
+    const unsigned char *pend = data + size;
     // Skip & count leading zeroes.
-    int zeroes = 0;
-    int length = 0;
+    size_t zeroes = 0;
     while (pbegin != pend && *pbegin == 0) {
         pbegin++;
         zeroes++;
     }
-    // Allocate enough space in big-endian base58 representation.
-    int size = (pend - pbegin) * 138 / 100 + 1; // log(256) / log(58), rounded up.
-    std::vector<unsigned char> b58(size);
-    // Process the bytes.
-    while (pbegin != pend) {
-        int carry = *pbegin;
-        int i = 0;
-        // Apply "b58 = b58 * 256 + ch".
-        for (std::vector<unsigned char>::reverse_iterator it = b58.rbegin();
-             (carry != 0 || i < length) && (it != b58.rend()); it++, i++) {
-            carry += 256 * (*it);
-            *it = carry % 58;
-            carry /= 58;
+    const size_t significant = pend - pbegin;
+
+    // Big-endian 32-bit limbs, limbs[0] is the most significant one and holds the leftover bytes.
+    // Dividing a 64-bit remainder:limb pair by the constant 58^5 compiles to multiplications.
+    const size_t limbCount = (significant + 3) / 4;
+    ScratchBuffer<uint32_t, BASE58_STACK_LIMBS * 2> limbBuffer(limbCount);
+    uint32_t *limbs = limbBuffer.data();
+    for (size_t i = 0; i < significant; i++) {
+        const size_t pos = limbCount * 4 - significant + i;
+        limbs[pos / 4] = (limbs[pos / 4] << 8) | pbegin[i];
+    }
+
+    // Digits are produced least significant first, five per division pass;
+    // log(256) / log(58) digits per byte, rounded up to whole passes.
+    ScratchBuffer<char, BASE58_STACK_LIMBS * 8 * 138 / 100 + 10> digitBuffer((significant * 138 / 100 + 1 + 4) / 5 * 5);
+    char *digits = digitBuffer.data();
+    size_t digitCount = 0;
+    size_t first = 0;
+    while (first < limbCount && limbs[first] == 0)
+        first++;
+    while (first < limbCount) {
+        uint64_t rem = 0;
+        for (size_t i = first; i < limbCount; i++) {
+            const uint64_t cur = (rem << 32) | limbs[i];
+            limbs[i] = (uint32_t) (cur / BASE58_RADIX_5);
+            rem = cur % BASE58_RADIX_5;
+        }
+        while (first < limbCount && limbs[first] == 0)
+            first++;
+        for (int j = 0; j < 5; j++) {
+            digits[digitCount++] = (char) (rem % 58);
+            rem /= 58;
         }
+    }
+    // Skip the zero digits above the most significant one.
+    while (digitCount > 0 && digits[digitCount - 1] == 0)
+        digitCount--;
 
-        assert(carry == 0);
-        length = i;
-        pbegin++;
+    // Translate the result into characters.
+    if (zeroes + digitCount > capacity)
+        return Base58Status::BufferTooSmall;
+    if (zeroes > 0)
+        memset(out, '1', zeroes);
+    *length = zeroes + digitCount;
+    for (size_t i = zeroes; i < *length; i++)
+        out[i] = pszBase58[(int) digits[--digitCount]];
+    return Base58Status::Ok;
+}
+
+/**
+ * Double-SHA256 of a base58check payload; WIF and address payloads fit a single block.
+ */
+static void ChecksumHash(const unsigned char *data, size_t size, unsigned char hash[CSHA256::OUTPUT_SIZE]) {
+    if (size <= safeheron::hash::SHA256_SHORT_MAX_LEN)
+        safeheron::hash::Hash256Short(hash, data, size);
+    else
+        safeheron::hash::SHA256D(hash, data, size);
+}
+
+Base58Status EncodeBase58Check(const unsigned char *data, size_t size, char *out, size_t capacity, size_t *length) {
+    // add 4-byte hash check to the end
+    ScratchBuffer<unsigned char, BASE58_STACK_LIMBS * 8 + 4> buffer(size + 4);
+    unsigned char *vch = buffer.data();
+    if (size > 0)
+        memcpy(vch, data, size);
+    uint8_t hash[CSHA256::OUTPUT_SIZE];
+    ChecksumHash(vch, size, hash);
+    memcpy(vch + size, hash, 4);
+    return EncodeBase58(vch, size + 4, out, capacity, length);
+}
+
+Base58Status DecodeBase58Check(std::string_view str, unsigned char *out, size_t capacity, size_t *size) {
+    // every character carries less than one byte, so the decoded data never exceeds the input length
+    ScratchBuffer<unsigned char, BASE58_STACK_LIMBS * 8 + 4> buffer(str.size());
+    unsigned char *vch = buffer.data();
+    size_t decoded = 0;
+    const Base58Status status = DecodeBase58(str, vch, str.size(), &decoded);
+    if (status != Base58Status::Ok)
+        return status;
+    if (decoded < 4)
+        return Base58Status::BadChecksum;
+    // re-calculate the checksum, ensure it matches the included 4-byte checksum
+    uint8_t hash[CSHA256::OUTPUT_SIZE];
+    ChecksumHash(vch, decoded - 4, hash);
+    if (memcmp(hash, vch + decoded - 4, 4) != 0)
+        return Base58Status::BadChecksum;
+    if (decoded - 4 > capacity)
+        return Base58Status::BufferTooSmall;
+    if (decoded > 4)
+        memcpy(out, vch, decoded - 4);
+    *size = decoded - 4;
+    return Base58Status::Ok;
+}
+
+void DecodeBase58CheckBatch(const std::string_view *strs, size_t count, unsigned char *out, size_t stride,
+                            size_t *sizes, Base58Status *statuses) {
+    // Decoded strings of one group, their payloads and the double-SHA256 of the payloads.
+    unsigned char data[SHA256_LANES][BASE58_BATCH_MAX_LENGTH];
+    const unsigned char *payloads[SHA256_LANES];
+    size_t payloadLens[SHA256_LANES];
+    unsigned char hashes[SHA256_LANES * CSHA256::OUTPUT_SIZE];
+    size_t index[SHA256_LANES], decoded[SHA256_LANES];
+
+    for (size_t first = 0; first < count; first += SHA256_LANES) {
+        const size_t group = count - first < SHA256_LANES ? count - first : SHA256_LANES;
+
+        // Decode the group; every string that decodes to a payload and a checksum takes a lane.
+        size_t lanes = 0;
+        for (size_t i = first; i < first + group; i++) {
+            if (strs[i].size() > BASE58_BATCH_MAX_LENGTH) {
+                statuses[i] = DecodeBase58Check(strs[i], out + i * stride, stride, &sizes[i]);
+                continue;
+            }
+            statuses[i] = DecodeBase58(strs[i], data[lanes], BASE58_BATCH_MAX_LENGTH, &decoded[lanes]);
+            if (statuses[i] != Base58Status::Ok)
+                continue;
+            if (decoded[lanes] < 4) {
+                statuses[i] = Base58Status::BadChecksum;
+                continue;
+            }
+            payloads[lanes] = data[lanes];
+            payloadLens[lanes] = decoded[lanes] - 4;
+            index[lanes++] = i;
+        }
+
+        // Double-SHA256 of all payloads at once, then compare the checksums.
+        safeheron::hash::SHA256DMulti(hashes, payloads, payloadLens, lanes);
+        for (size_t l = 0; l < lanes; l++) {
+            const size_t i = index[l];
+            const size_t size = decoded[l] - 4;
+            if (memcmp(hashes + l * CSHA256::OUTPUT_SIZE, data[l] + size, 4) != 0) {
+                statuses[i] = Base58Status::BadChecksum;
+            }
+            else if (size > stride) {
+                statuses[i] = Base58Status::BufferTooSmall;
+            }
+            else {
+                if (size > 0)
+                    memcpy(out + i * stride, data[l], size);
+                sizes[i] = size;
+            }
+        }
     }
-    // Skip leading zeroes in base58 result.
-    std::vector<unsigned char>::iterator it = b58.begin() + (size - length);
-    while (it != b58.end() && *it == 0)
-        it++;
-    // Translate the result into a string.
-    std::string str;
-    str.reserve(zeroes + (b58.end() - it));
-    str.assign(zeroes, '1');
-    while (it != b58.end())
-        str += pszBase58[*(it++)];
-    return str;
 }
 
-std::string EncodeBase58(const std::vector<unsigned char> &vch) {
-    return EncodeBase58(vch.data(), vch.data() + vch.size());
+bool DecodeBase58(const char *psz, std::vector<unsigned char> &vch) {
+    return DecodeBase58(std::string_view(psz), vch);
 }
 
 bool DecodeBase58(const std::string &str, std::vector<unsigned char> &vchRet) {
-    return DecodeBase58(str.c_str(), vchRet);
+    return DecodeBase58(std::string_view(str), vchRet);
+}
+
+bool DecodeBase58(std::string_view str, std::vector<unsigned char> &vchRet) {
+    size_t size = 0;
+    vchRet.resize(str.size());
+    if (DecodeBase58(str, vchRet.data(), vchRet.size(), &size) != Base58Status::Ok) {
+        vchRet.clear();
+        return false;
+    }
+    vchRet.resize(size);
+    return true;
 }
 
-inline void
-Hash256(const std::vector<unsigned char>::const_iterator pbegin, const std::vector<unsigned char>::const_iterator pend,
-        uint8_t hash[32]) {
-    static const unsigned char pblank[1] = {};
-    CHash256().Write(pbegin == pend ? pblank : (const unsigned char *) &pbegin[0], (pend - pbegin) * sizeof(pbegin[0]))
-            .Finalize(hash);
+std::string EncodeBase58(const unsigned char *pbegin, const unsigned char *pend) {
+    std::string str(Base58MaxEncodedLength(pend - pbegin), '\0');
+    size_t length = 0;
+    EncodeBase58(pbegin, pend - pbegin, &str[0], str.size(), &length);
+    str.resize(length);
+    return str;
+}
+
+std::string EncodeBase58(const std::vector<unsigned char> &vch) {
+    return EncodeBase58(vch.data(), vch.data() + vch.size());
 }
 
 std::string EncodeBase58Check(const std::vector<unsigned char> &vchIn) {
-    static unsigned char pblank[1] = {};
-    // add 4-byte hash check to the end
-    std::vector<unsigned char> vch(vchIn);
-    uint8_t hash[CHash256::OUTPUT_SIZE];
-    Hash256(vch.begin(), vch.end(), hash);
-    vch.push_back(hash[0]);
-    vch.push_back(hash[1]);
-    vch.push_back(hash[2]);
-    vch.push_back(hash[3]);
-    return EncodeBase58(vch);
+    std::string str(Base58MaxEncodedLength(vchIn.size() + 4), '\0');
+    size_t length = 0;
+    EncodeBase58Check(vchIn.data(), vchIn.size(), &str[0], str.size(), &length);
+    str.resize(length);
+    return str;
 }
 
 bool DecodeBase58Check(const char *psz, std::vector<unsigned char> &vchRet) {
-    static unsigned char pblank[1] = {};
-    if (!DecodeBase58(psz, vchRet) ||
-        (vchRet.size() < 4)) {
-        vchRet.clear();
-        return false;
-    }
-    // re-calculate the checksum, ensure it matches the included 4-byte checksum
-    uint8_t hash[CHash256::OUTPUT_SIZE];
-    Hash256(vchRet.begin(), vchRet.end() - 4, hash);
-    if (memcmp(&hash, &vchRet[vchRet.size() - 4], 4) != 0) {
+    return DecodeBase58Check(std::string_view(psz), vchRet);
+}
+
+bool DecodeBase58Check(const std::string &str, std::vector<unsigned char> &vchRet) {
+    return DecodeBase58Check(std::string_view(str), vchRet);
+}
+
+bool DecodeBase58Check(std::string_view str, std::vector<unsigned char> &vchRet) {
+    size_t size = 0;
+    vchRet.resize(str.size());
+    if (DecodeBase58Check(str, vchRet.data(), vchRet.size(), &size) != Base58Status::Ok) {
         vchRet.clear();
         return false;
     }
-    vchRet.resize(vchRet.size() - 4);
+    vchRet.resize(size);
     return true;
 }
 
-bool DecodeBase58Check(const std::string &str, std::vector<unsigned char> &vchRet) {
-    return DecodeBase58Check(str.c_str(), vchRet);
 }
-
 }
 }
 }
-}
\ No newline at end of file
@@ -15,13 +15,47 @@
 #define BITCOIN_BASE58_IMP_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "base58.h"
+
 namespace safeheron {
 namespace encode {
 namespace base58 {
 namespace _internal{
 
+/**
+ * Encode size bytes at data as base58 into out, which holds capacity characters.
+ * On success *length is the number of characters written; out is not null terminated.
+ */
+Base58Status EncodeBase58(const unsigned char* data, size_t size, char* out, size_t capacity, size_t* length);
+
+/**
+ * Decode a base58-encoded string (str) into out, which holds capacity bytes.
+ * Leading and trailing whitespace is skipped. On success *size is the number of bytes written.
+ */
+Base58Status DecodeBase58(std::string_view str, unsigned char* out, size_t capacity, size_t* size);
+
+/**
+ * Encode size bytes at data and their 4-byte checksum as base58 into out, which holds capacity characters.
+ */
+Base58Status EncodeBase58Check(const unsigned char* data, size_t size, char* out, size_t capacity, size_t* length);
+
+/**
+ * Decode a base58-encoded string (str) that includes a checksum into out, which holds capacity
+ * bytes; on success *size is the payload length without the checksum.
+ */
+Base58Status DecodeBase58Check(std::string_view str, unsigned char* out, size_t capacity, size_t* size);
+
+/**
+ * Decode count base58-encoded strings that include a checksum. Entry i is written to
+ * out + i * stride (stride bytes available), its payload length to sizes[i] and its outcome to
+ * statuses[i]. The strings are decoded one by one, then the payloads of up to eight of them are
+ * double-hashed together by SHA256DMulti.
+ */
+void DecodeBase58CheckBatch(const std::string_view* strs, size_t count, unsigned char* out, size_t stride,
+                            size_t* sizes, Base58Status* statuses);
 
 /**
  * Encode a byte sequence as a base58-encoded string.
@@ -46,6 +80,7 @@ bool DecodeBase58(const char* psz, std::vector<unsigned char>& vchRet);
  * return true if decoding is successful.
  */
 bool DecodeBase58(const std::string& str, std::vector<unsigned char>& vchRet);
+bool DecodeBase58(std::string_view str, std::vector<unsigned char>& vchRet);
 
 /**
  * Encode a byte vector into a base58-encoded string, including checksum
@@ -63,6 +98,7 @@ bool DecodeBase58Check(const char* psz, std::vector<unsigned char>& vchRet);
  * vector (vchRet), return true if decoding is successful
  */
 bool DecodeBase58Check(const std::string& str, std::vector<unsigned char>& vchRet);
+bool DecodeBase58Check(std::string_view str, std::vector<unsigned char>& vchRet);
 
 }
 }
@@ -22,16 +22,15 @@ namespace encode {
 namespace hex {
 
 std::string DecodeFromHex(const std::string &hex) {
-    std::string data;
-    int hex_len = hex.length();
-    if(hex_len == 0) return data;
-    if(hex_len % 2 != 0){
+    std::string data(hex.length() / 2, '\0');
+    size_t size = 0;
+    HexStatus status = DecodeFromHex(hex, reinterpret_cast<unsigned char *>(&data[0]), data.size(), &size);
+    if(status == HexStatus::OddLength){
         throw std::runtime_error("Input is not valid hex-encoded data(length is even).");
     }
-    unsigned int decode_out_len = hex_len / 2;
-    std::unique_ptr<uint8_t[]> decode_out(new uint8_t[decode_out_len]);
-    tallymarker_hex2bin(hex.c_str(), decode_out.get(), decode_out_len);
-    data.assign((char *)decode_out.get(), decode_out_len);
+    if(status != HexStatus::Ok){
+        throw std::runtime_error("Input is not valid hex-encoded data(invalid character).");
+    }
     return data;
 }
 
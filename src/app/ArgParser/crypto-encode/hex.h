@@ -15,7 +15,9 @@
 #ifndef SAFEHERON_HEX_H
 #define SAFEHERON_HEX_H
 
+#include <stddef.h>
 #include <string>
+#include <string_view>
 
 namespace safeheron {
 namespace encode {
@@ -36,13 +38,38 @@ std::string EncodeToHex(const std::string &data);
  */
 std::string EncodeToHex(const unsigned char * buf, size_t buf_len);
 
+/**
+ * Outcome of the buffer-based decoder.
+ */
+enum class HexStatus {
+    Ok,
+    InvalidCharacter,  // a character that is not a hex digit (either case)
+    OddLength,  // every character is a hex digit, but the last one has no pair
+    BufferTooSmall,  // the caller's buffer cannot hold hex.size() / 2 bytes
+};
+
 /**
  * Decode from hex string to bytes.
  * @param hex
  * @return data in bytes.
+ * @throws std::runtime_error if hex has an odd length or a character that is not a hex digit
  */
 std::string DecodeFromHex(const std::string &hex);
 
+/**
+ * Decode from hex to bytes into the caller's buffer, without allocating or throwing.
+ * Every character is validated; with AVX2 (or SSE2) 32 characters are classified and decoded per
+ * step. On InvalidCharacter and OddLength the complete pairs before the offending character are
+ * still decoded, so *size is always position / 2.
+ * @param hex hex digits without separators
+ * @param out output buffer
+ * @param capacity size of out, hex.size() / 2 bytes always suffice
+ * @param size number of bytes written
+ * @param position index of the first invalid character, or of the unpaired last digit; may be null
+ * @return Ok, InvalidCharacter, OddLength or BufferTooSmall
+ */
+HexStatus DecodeFromHex(std::string_view hex, unsigned char *out, size_t capacity, size_t *size, size_t *position = nullptr);
+
 }
 }
 }
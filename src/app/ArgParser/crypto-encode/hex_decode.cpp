@@ -0,0 +1,182 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file hex_decode.cpp
+ * @brief Strict hex decoder writing into a caller buffer, 32 characters per step
+ * @date 2026-10-18
+ *
+ * Blocks of 32 characters are classified as hex digits and decoded into 16 bytes with AVX2 when
+ * GetCpuFeatures reports it, with two SSE2 vectors otherwise. The first block containing anything
+ * else, and the tail shorter than a block, go pair by pair, which finds the exact position of the
+ * first invalid character.
+ */
+
+#include "hex.h"
+#include "../crypto-hash/cpu_features.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_HEX_AVX2
+#endif
+
+namespace safeheron {
+namespace encode {
+namespace hex {
+namespace {
+
+/** Characters classified and decoded per step. */
+const size_t HEX_BLOCK = 32;
+
+/**
+ * Decodes one hex digit
+ * @param c character
+ * @return value of the digit, -1 if c is not a hex digit
+ */
+int digitValue(char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+#if defined(__SSE2__)
+/**
+ * Classifies 16 characters and decodes them into 8 bytes
+ * @param input 16 characters
+ * @param out 8 bytes, written only if every character is a hex digit
+ * @return true if every character is a hex digit
+ */
+bool decodeBlockSse2(const char *input, unsigned char *out) {
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input));
+    // bytes >= 0x80 are negative in the signed compares and fail both ranges
+    const __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    const __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+    const __m128i isAlpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    if (_mm_movemask_epi8(_mm_or_si128(isDigit, isAlpha)) != 0xffff)
+        return false;
+
+    const __m128i digits = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i letters = _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10));
+    const __m128i nibbles = _mm_or_si128(_mm_and_si128(isAlpha, letters), _mm_andnot_si128(isAlpha, digits));
+
+    // every 16-bit lane holds the high nibble in its low byte and the low nibble in its high byte
+    const __m128i high = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00ff)), 4);
+    const __m128i low = _mm_srli_epi16(nibbles, 8);
+    const __m128i bytes = _mm_or_si128(high, low);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(bytes, bytes));
+    return true;
+}
+
+/**
+ * Decodes whole blocks while every character is a hex digit
+ * @param input characters
+ * @param length number of characters
+ * @param out output, length / 2 bytes
+ * @return number of characters decoded, a multiple of HEX_BLOCK
+ */
+size_t decodeBlocksSse2(const char *input, size_t length, unsigned char *out) {
+    size_t i = 0;
+    for (; i + HEX_BLOCK <= length; i += HEX_BLOCK) {
+        unsigned char bytes[HEX_BLOCK / 2];
+        if (!decodeBlockSse2(input + i, bytes) || !decodeBlockSse2(input + i + HEX_BLOCK / 2, bytes + HEX_BLOCK / 4))
+            break;
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i / 2), _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes)));
+    }
+    return i;
+}
+#endif
+
+#if defined(HAVE_HEX_AVX2)
+/**
+ * AVX2 variant of decodeBlocksSse2, one 32-character block per vector
+ * @param input characters
+ * @param length number of characters
+ * @param out output, length / 2 bytes
+ * @return number of characters decoded, a multiple of HEX_BLOCK
+ */
+__attribute__((target("avx2"))) size_t decodeBlocksAvx2(const char *input, size_t length, unsigned char *out) {
+    size_t i = 0;
+    for (; i + HEX_BLOCK <= length; i += HEX_BLOCK) {
+        const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + i));
+        const __m256i lower = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+        const __m256i isDigit = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+        const __m256i isAlpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+        if (_mm256_movemask_epi8(_mm256_or_si256(isDigit, isAlpha)) != -1)
+            break;
+
+        const __m256i digits = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+        const __m256i letters = _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10));
+        const __m256i nibbles = _mm256_blendv_epi8(digits, letters, isAlpha);
+
+        // high nibble * 16 + low nibble per pair, then the low halves of both 128-bit lanes
+        const __m256i pairs = _mm256_maddubs_epi16(nibbles, _mm256_set1_epi16(0x0110));
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(pairs, pairs), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i / 2), _mm256_castsi256_si128(packed));
+    }
+    return i;
+}
+#endif
+
+/**
+ * Decodes whole blocks with the widest available kernel
+ * @param input characters
+ * @param length number of characters
+ * @param out output, length / 2 bytes
+ * @return number of characters decoded, a multiple of HEX_BLOCK
+ */
+size_t decodeBlocks(const char *input, size_t length, unsigned char *out) {
+#if defined(HAVE_HEX_AVX2)
+    // the same detection as SHA256AutoDetect, which also checks that the OS saves the YMM registers
+    if (hash::GetCpuFeatures().avx2)
+        return decodeBlocksAvx2(input, length, out);
+#endif
+#if defined(__SSE2__)
+    return decodeBlocksSse2(input, length, out);
+#else
+    (void) input;
+    (void) length;
+    (void) out;
+    return 0;
+#endif
+}
+
+} // namespace
+
+HexStatus DecodeFromHex(std::string_view hex, unsigned char *out, size_t capacity, size_t *size, size_t *position) {
+    const char *input = hex.data();
+    const size_t length = hex.size();
+    *size = 0;
+    if (capacity < length / 2)
+        return HexStatus::BufferTooSmall;
+
+    // whole blocks up to the first one that is not all hex, then pair by pair
+    size_t i = decodeBlocks(input, length, out);
+    HexStatus status = HexStatus::Ok;
+    for (; i + 1 < length; i += 2) {
+        const int high = digitValue(input[i]);
+        const int low = digitValue(input[i + 1]);
+        if (high < 0 || low < 0) {
+            status = HexStatus::InvalidCharacter;
+            if (high >= 0)
+                i++;
+            break;
+        }
+        out[i / 2] = static_cast<unsigned char>(high << 4 | low);
+    }
+    if (status == HexStatus::Ok && i < length)
+        status = digitValue(input[i]) < 0 ? HexStatus::InvalidCharacter : HexStatus::OddLength;
+
+    *size = i / 2;
+    if (position != nullptr)
+        *position = i;
+    return status;
+}
+
+}
+}
+}
@@ -22,9 +22,6 @@
 extern "C" {
 #endif
 
-// tallymarker_hextobin
-int tallymarker_hex2bin(const char *str, uint8_t *bytes, size_t blen);
-
 int tallymarker_bin2hex(const uint8_t *bytes, size_t blen, char *str, size_t slen);
 
 #ifdef __cplusplus
@@ -0,0 +1,65 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file cpu_features.cpp
+ * @brief CPUID and XGETBV based detection of x86 instruction set extensions
+ * @date 2026-10-18
+ */
+
+#include "cpu_features.h"
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define HAVE_GETCPUID
+#endif
+
+namespace safeheron {
+namespace hash {
+namespace {
+
+#if defined(HAVE_GETCPUID)
+/** Query a CPUID leaf. */
+void inline GetCPUID(uint32_t leaf, uint32_t subleaf, uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d) {
+    __cpuid_count(leaf, subleaf, a, b, c, d);
+}
+
+/** Check that the OS saves the XMM and YMM registers across context switches. */
+bool AVXEnabled() {
+    uint32_t a, d;
+    __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+    return (a & 6) == 6;
+}
+#endif
+
+CpuFeatures DetectCpuFeatures() {
+    CpuFeatures features;
+#if defined(HAVE_GETCPUID)
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(0, 0, eax, ebx, ecx, edx);
+    const uint32_t max_leaf = eax;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    features.sse41 = (ecx >> 19) & 1;
+    const bool have_xsave = (ecx >> 27) & 1;
+    const bool have_avx = (ecx >> 28) & 1;
+    // XGETBV may only be executed once the OS has set OSXSAVE
+    const bool enabled_avx = have_xsave && have_avx && AVXEnabled();
+    // the SHA-NI and AVX2 kernels also use SSE4.1 instructions
+    if (features.sse41 && max_leaf >= 7) {
+        GetCPUID(7, 0, eax, ebx, ecx, edx);
+        features.avx2 = enabled_avx && ((ebx >> 5) & 1);
+        features.shani = (ebx >> 29) & 1;
+    }
+#endif
+    return features;
+}
+
+}
+
+const CpuFeatures &GetCpuFeatures() {
+    static const CpuFeatures features = DetectCpuFeatures();
+    return features;
+}
+
+}
+}
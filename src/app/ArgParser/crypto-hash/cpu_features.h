@@ -0,0 +1,33 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file cpu_features.h
+ * @brief x86 instruction set extensions usable by this process
+ * @date 2026-10-18
+ *
+ * One CPUID and XGETBV based detection shared by every kernel that picks an implementation at
+ * runtime (SHA256AutoDetect, the hex decoder), so they all agree on what the CPU and OS support.
+ */
+
+#ifndef SAFEHERON_CRYPTO_CPU_FEATURES_H
+#define SAFEHERON_CRYPTO_CPU_FEATURES_H
+
+namespace safeheron {
+namespace hash {
+
+/** Extensions the CPU reports and, for the AVX family, the OS saves the registers of. */
+struct CpuFeatures {
+    bool sse41 = false;
+    bool avx2 = false;
+    bool shani = false;
+};
+
+/**
+ * Detects the extensions once and returns the cached result
+ * @return features of the CPU, all false on non-x86 targets
+ */
+const CpuFeatures &GetCpuFeatures();
+
+}
+}
+
+#endif //SAFEHERON_CRYPTO_CPU_FEATURES_H
@@ -0,0 +1,40 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file hash160.cpp
+ * @brief Bitcoin's HASH160 (RIPEMD-160 of SHA-256), single and batched
+ * @date 2026-10-18
+ */
+
+#include "hash160.h"
+#include "ripemd160.h"
+#include "sha256.h"
+
+namespace safeheron {
+namespace hash {
+
+void Hash160(unsigned char *output, const unsigned char *input, size_t len) {
+    unsigned char digest[CSHA256::OUTPUT_SIZE];
+    CSHA256().Write(input, len).Finalize(digest);
+    RIPEMD160_32Multiway(output, digest, 1);
+}
+
+void Hash160Batch(unsigned char *output, const unsigned char *input, size_t len, size_t count) {
+    unsigned char digests[RIPEMD160_LANES * CSHA256::OUTPUT_SIZE];
+    while (count > 0) {
+        const size_t lanes = count < RIPEMD160_LANES ? count : RIPEMD160_LANES;
+        const unsigned char *messages[RIPEMD160_LANES];
+        size_t lens[RIPEMD160_LANES];
+        for (size_t l = 0; l < lanes; ++l) {
+            messages[l] = input + l * len;
+            lens[l] = len;
+        }
+        SHA256Multi(digests, messages, lens, lanes);
+        RIPEMD160_32Multiway(output, digests, lanes);
+        input += lanes * len;
+        output += lanes * HASH160_OUTPUT_SIZE;
+        count -= lanes;
+    }
+}
+
+}
+}
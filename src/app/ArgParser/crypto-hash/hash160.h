@@ -0,0 +1,34 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file hash160.h
+ * @brief Bitcoin's HASH160 (RIPEMD-160 of SHA-256), single and batched
+ * @date 2026-10-18
+ */
+
+#ifndef CRYPTOHASH_HASH160_H
+#define CRYPTOHASH_HASH160_H
+
+#include <stddef.h>
+
+namespace safeheron {
+namespace hash {
+
+/** Size of a HASH160 digest in bytes. */
+static const size_t HASH160_OUTPUT_SIZE = 20;
+
+/** Compute RIPEMD160(SHA256(input)).
+ *  output: pointer to a 20 byte output buffer
+ */
+void Hash160(unsigned char *output, const unsigned char *input, size_t len);
+
+/** Compute HASH160 of count messages of len bytes each, stored back to back.
+ *  The SHA-256 stage runs through SHA256Multi, the RIPEMD-160 stage through RIPEMD160_32Multiway.
+ *  output: pointer to a count*20 byte output buffer
+ *  input:  pointer to a count*len byte input buffer
+ */
+void Hash160Batch(unsigned char *output, const unsigned char *input, size_t len, size_t count);
+
+}
+}
+
+#endif // CRYPTOHASH_HASH160_H
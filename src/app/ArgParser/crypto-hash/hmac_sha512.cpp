@@ -0,0 +1,44 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file hmac_sha512.cpp
+ * @brief HMAC-SHA512 hasher
+ * @date 2026-10-18
+ */
+
+#include "hmac_sha512.h"
+
+#include <string.h>
+
+namespace safeheron {
+namespace hash {
+
+CHMAC_SHA512::CHMAC_SHA512(const unsigned char *key, size_t keylen) {
+    unsigned char rkey[128];
+    if (keylen <= 128) {
+        memcpy(rkey, key, keylen);
+        memset(rkey + keylen, 0, 128 - keylen);
+    } else {
+        CSHA512().Write(key, keylen).Finalize(rkey);
+        memset(rkey + 64, 0, 64);
+    }
+
+    for (int n = 0; n < 128; n++)
+        rkey[n] ^= 0x5c;
+    outer.Write(rkey, 128);
+
+    for (int n = 0; n < 128; n++)
+        rkey[n] ^= 0x5c ^ 0x36;
+    inner.Write(rkey, 128);
+
+    memset(rkey, 0, sizeof(rkey));
+}
+
+void CHMAC_SHA512::Finalize(unsigned char hash[OUTPUT_SIZE]) {
+    unsigned char temp[64];
+    inner.Finalize(temp);
+    outer.Write(temp, 64).Finalize(hash);
+    memset(temp, 0, sizeof(temp));
+}
+
+}
+}
@@ -0,0 +1,38 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file hmac_sha512.h
+ * @brief HMAC-SHA512 hasher
+ * @date 2026-10-18
+ */
+
+#ifndef SAFEHERON_CRYPTO_HMAC_SHA512_H
+#define SAFEHERON_CRYPTO_HMAC_SHA512_H
+
+#include "sha512.h"
+
+namespace safeheron {
+namespace hash {
+
+/** A hasher class for HMAC-SHA-512. */
+class CHMAC_SHA512 {
+private:
+    CSHA512 outer;
+    CSHA512 inner;
+
+public:
+    static const size_t OUTPUT_SIZE = 64;
+
+    CHMAC_SHA512(const unsigned char *key, size_t keylen);
+
+    CHMAC_SHA512 &Write(const unsigned char *data, size_t len) {
+        inner.Write(data, len);
+        return *this;
+    }
+
+    void Finalize(unsigned char hash[OUTPUT_SIZE]);
+};
+
+}
+}
+
+#endif // SAFEHERON_CRYPTO_HMAC_SHA512_H
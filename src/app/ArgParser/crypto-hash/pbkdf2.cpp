@@ -0,0 +1,115 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file pbkdf2.cpp
+ * @brief PBKDF2-HMAC-SHA512 key derivation, single and multi-buffer
+ * @date 2026-10-18
+ */
+
+#include "pbkdf2.h"
+#include "hmac_sha512.h"
+#include "common.h"
+
+#include <assert.h>
+#include <string.h>
+
+namespace safeheron {
+namespace hash {
+
+namespace {
+
+/** Absorb the HMAC ipad/opad key blocks of one password into raw SHA-512 midstates. */
+void HMACMidstates(const unsigned char *password, size_t passwordLen, uint64_t inner[8], uint64_t outer[8]) {
+    unsigned char rkey[128];
+    if (passwordLen <= 128) {
+        memcpy(rkey, password, passwordLen);
+        memset(rkey + passwordLen, 0, 128 - passwordLen);
+    } else {
+        CSHA512().Write(password, passwordLen).Finalize(rkey);
+        memset(rkey + 64, 0, 64);
+    }
+
+    for (int n = 0; n < 128; n++)
+        rkey[n] ^= 0x5c;
+    SHA512Initialize(outer);
+    SHA512Transform(outer, rkey, 1);
+
+    for (int n = 0; n < 128; n++)
+        rkey[n] ^= 0x5c ^ 0x36;
+    SHA512Initialize(inner);
+    SHA512Transform(inner, rkey, 1);
+
+    memset(rkey, 0, sizeof(rkey));
+}
+
+}
+
+void PBKDF2_HMAC_SHA512(const unsigned char *password, size_t passwordLen,
+                        const unsigned char *salt, size_t saltLen,
+                        uint32_t iterations, unsigned char out[PBKDF2_SHA512_OUTPUT_SIZE]) {
+    PBKDF2_HMAC_SHA512_Multiway(&password, &passwordLen, &salt, &saltLen, 1, iterations, out);
+}
+
+void PBKDF2_HMAC_SHA512_Multiway(const unsigned char *const passwords[], const size_t passwordLens[],
+                                 const unsigned char *const salts[], const size_t saltLens[],
+                                 size_t count, uint32_t iterations, unsigned char *out) {
+    const size_t L = SHA512_LANES;
+    assert(count >= 1 && count <= L);
+    assert(iterations >= 1);
+
+    uint64_t inner[8][L], outer[8][L], u[8][L], t[8][L];
+    for (size_t l = 0; l < L; ++l) {
+        // Idle lanes repeat the last real input; their results are discarded.
+        const size_t src = l < count ? l : count - 1;
+        uint64_t in[8], ou[8];
+        HMACMidstates(passwords[src], passwordLens[src], in, ou);
+
+        // U_1 = HMAC(P, S || INT(1)) has a caller-sized message, so it is computed per lane.
+        static const unsigned char one[4] = {0, 0, 0, 1};
+        unsigned char first[CHMAC_SHA512::OUTPUT_SIZE];
+        CHMAC_SHA512(passwords[src], passwordLens[src]).Write(salts[src], saltLens[src]).Write(one, 4).Finalize(first);
+
+        for (int i = 0; i < 8; ++i) {
+            inner[i][l] = in[i];
+            outer[i][l] = ou[i];
+            u[i][l] = t[i][l] = ReadBE64(first + 8 * i);
+        }
+        memset(first, 0, sizeof(first));
+    }
+
+    // U_i = HMAC(P, U_{i-1}); both the inner and the outer message are a single padded 64-byte
+    // block following the 128-byte key block, so every lane needs exactly two compressions.
+    uint64_t words[16][L];
+    for (size_t l = 0; l < L; ++l) {
+        words[8][l] = 0x8000000000000000ull;
+        for (int i = 9; i < 15; ++i) words[i][l] = 0;
+        words[15][l] = (128 + 64) * 8;
+    }
+
+    uint64_t st[8][L];
+    for (uint32_t it = 1; it < iterations; ++it) {
+        memcpy(st, inner, sizeof(st));
+        memcpy(words, u, sizeof(u));
+        SHA512TransformMultiway(st, words);
+
+        memcpy(words, st, sizeof(st));
+        memcpy(st, outer, sizeof(st));
+        SHA512TransformMultiway(st, words);
+
+        memcpy(u, st, sizeof(st));
+        for (int i = 0; i < 8; ++i)
+            for (size_t l = 0; l < L; ++l) t[i][l] ^= u[i][l];
+    }
+
+    for (size_t l = 0; l < count; ++l)
+        for (int i = 0; i < 8; ++i) WriteBE64(out + l * PBKDF2_SHA512_OUTPUT_SIZE + 8 * i, t[i][l]);
+
+    memset(inner, 0, sizeof(inner));
+    memset(outer, 0, sizeof(outer));
+    memset(u, 0, sizeof(u));
+    memset(t, 0, sizeof(t));
+    memset(st, 0, sizeof(st));
+    memset(words, 0, sizeof(words));
+}
+
+}
+}
@@ -0,0 +1,41 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file pbkdf2.h
+ * @brief PBKDF2-HMAC-SHA512 key derivation, single and multi-buffer
+ * @date 2026-10-18
+ */
+
+#ifndef SAFEHERON_CRYPTO_PBKDF2_H
+#define SAFEHERON_CRYPTO_PBKDF2_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "sha512.h"
+
+namespace safeheron {
+namespace hash {
+
+/** Size of the single PBKDF2-HMAC-SHA512 output block produced by the functions below. */
+static const size_t PBKDF2_SHA512_OUTPUT_SIZE = 64;
+
+/** Derive the first 64-byte block of PBKDF2-HMAC-SHA512(password, salt, iterations).
+ *  Only one output block is produced, which is the full dkLen used by BIP39.
+ */
+void PBKDF2_HMAC_SHA512(const unsigned char *password, size_t passwordLen,
+                        const unsigned char *salt, size_t saltLen,
+                        uint32_t iterations, unsigned char out[PBKDF2_SHA512_OUTPUT_SIZE]);
+
+/** Derive the first PBKDF2-HMAC-SHA512 block for up to SHA512_LANES password/salt pairs at once.
+ *  The iteration loop runs all pairs through SHA512TransformMultiway in lockstep.
+ *  passwords/passwordLens, salts/saltLens: count entries each
+ *  out: pointer to a count*64 byte output buffer
+ */
+void PBKDF2_HMAC_SHA512_Multiway(const unsigned char *const passwords[], const size_t passwordLens[],
+                                 const unsigned char *const salts[], const size_t saltLens[],
+                                 size_t count, uint32_t iterations, unsigned char *out);
+
+}
+}
+
+#endif // SAFEHERON_CRYPTO_PBKDF2_H
@@ -0,0 +1,223 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file ripemd160.cpp
+ * @brief RIPEMD-160 hasher, with a lane-interleaved variant for hashing many SHA-256 digests at once
+ * @date 2026-10-18
+ */
+
+#include "ripemd160.h"
+#include "common.h"
+
+#include <string.h>
+
+namespace safeheron {
+namespace hash {
+
+/// Internal RIPEMD-160 implementation.
+namespace ripemd160 {
+
+/** Message word selection of the left and right lines. */
+static const unsigned char RL[80] = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+        7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+        3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+        1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+        4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13};
+static const unsigned char RR[80] = {
+        5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+        6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+        15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+        8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+        12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11};
+
+/** Rotation amounts of the left and right lines. */
+static const unsigned char SL[80] = {
+        11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+        7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+        11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+        11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+        9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6};
+static const unsigned char SR[80] = {
+        8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+        9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+        9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+        15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+        8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11};
+
+/** Round constants of the left and right lines. */
+static const uint32_t KL[5] = {0x00000000ul, 0x5A827999ul, 0x6ED9EBA1ul, 0x8F1BBCDCul, 0xA953FD4Eul};
+static const uint32_t KR[5] = {0x50A28BE6ul, 0x5C4DD124ul, 0x6D703EF3ul, 0x7A6D76E9ul, 0x00000000ul};
+
+uint32_t inline rol(uint32_t x, int i) { return (x << i) | (x >> (32 - i)); }
+
+/** The five boolean functions, f(0) ... f(4). */
+uint32_t inline F(int round, uint32_t x, uint32_t y, uint32_t z) {
+    switch (round) {
+        case 0: return x ^ y ^ z;
+        case 1: return (x & y) | (~x & z);
+        case 2: return (x | ~y) ^ z;
+        case 3: return (x & z) | (y & ~z);
+        default: return x ^ (y | ~z);
+    }
+}
+
+/** Initialize RIPEMD-160 state. */
+void inline Initialize(uint32_t *s) {
+    s[0] = 0x67452301ul;
+    s[1] = 0xEFCDAB89ul;
+    s[2] = 0x98BADCFEul;
+    s[3] = 0x10325476ul;
+    s[4] = 0xC3D2E1F0ul;
+}
+
+/** Perform a RIPEMD-160 transformation, processing a 64-byte chunk. */
+void Transform(uint32_t *s, const unsigned char *chunk) {
+    uint32_t w[16];
+    for (int i = 0; i < 16; ++i) w[i] = ReadLE32(chunk + 4 * i);
+
+    uint32_t a1 = s[0], b1 = s[1], c1 = s[2], d1 = s[3], e1 = s[4];
+    uint32_t a2 = a1, b2 = b1, c2 = c1, d2 = d1, e2 = e1;
+    for (int j = 0; j < 80; ++j) {
+        const int round = j / 16;
+        uint32_t t = rol(a1 + F(round, b1, c1, d1) + w[RL[j]] + KL[round], SL[j]) + e1;
+        a1 = e1; e1 = d1; d1 = rol(c1, 10); c1 = b1; b1 = t;
+        t = rol(a2 + F(4 - round, b2, c2, d2) + w[RR[j]] + KR[round], SR[j]) + e2;
+        a2 = e2; e2 = d2; d2 = rol(c2, 10); c2 = b2; b2 = t;
+    }
+
+    uint32_t t = s[1] + c1 + d2;
+    s[1] = s[2] + d1 + e2;
+    s[2] = s[3] + e1 + a2;
+    s[3] = s[4] + a1 + b2;
+    s[4] = s[0] + b1 + c2;
+    s[0] = t;
+}
+
+/** One RIPEMD-160 step of one line over all lanes. */
+template<int round>
+void inline StepMultiway(uint32_t *a, uint32_t *b, uint32_t *c, uint32_t *d, uint32_t *e,
+                         const uint32_t *x, uint32_t k, int rotation) {
+    for (size_t l = 0; l < RIPEMD160_LANES; ++l) {
+        uint32_t t = rol(a[l] + F(round, b[l], c[l], d[l]) + x[l] + k, rotation) + e[l];
+        a[l] = e[l];
+        e[l] = d[l];
+        d[l] = rol(c[l], 10);
+        c[l] = b[l];
+        b[l] = t;
+    }
+}
+
+/** One line (16 steps of one round) over all lanes. */
+template<int round>
+void inline RoundMultiway(uint32_t v[5][RIPEMD160_LANES], const uint32_t w[16][RIPEMD160_LANES],
+                          const unsigned char *selection, const unsigned char *rotation, uint32_t k) {
+    for (int j = 0; j < 16; ++j)
+        StepMultiway<round>(v[0], v[1], v[2], v[3], v[4], w[selection[j]], k, rotation[j]);
+}
+
+/** Compress one pre-padded block per lane, starting from the initial state. */
+void TransformMultiway(uint32_t out[5][RIPEMD160_LANES], const uint32_t w[16][RIPEMD160_LANES]) {
+    const size_t L = RIPEMD160_LANES;
+    uint32_t init[5];
+    Initialize(init);
+
+    uint32_t left[5][L], right[5][L];
+    for (int i = 0; i < 5; ++i)
+        for (size_t l = 0; l < L; ++l) left[i][l] = right[i][l] = init[i];
+
+    RoundMultiway<0>(left, w, RL + 0, SL + 0, KL[0]);
+    RoundMultiway<4>(right, w, RR + 0, SR + 0, KR[0]);
+    RoundMultiway<1>(left, w, RL + 16, SL + 16, KL[1]);
+    RoundMultiway<3>(right, w, RR + 16, SR + 16, KR[1]);
+    RoundMultiway<2>(left, w, RL + 32, SL + 32, KL[2]);
+    RoundMultiway<2>(right, w, RR + 32, SR + 32, KR[2]);
+    RoundMultiway<3>(left, w, RL + 48, SL + 48, KL[3]);
+    RoundMultiway<1>(right, w, RR + 48, SR + 48, KR[3]);
+    RoundMultiway<4>(left, w, RL + 64, SL + 64, KL[4]);
+    RoundMultiway<0>(right, w, RR + 64, SR + 64, KR[4]);
+
+    for (size_t l = 0; l < L; ++l) {
+        out[0][l] = init[1] + left[2][l] + right[3][l];
+        out[1][l] = init[2] + left[3][l] + right[4][l];
+        out[2][l] = init[3] + left[4][l] + right[0][l];
+        out[3][l] = init[4] + left[0][l] + right[1][l];
+        out[4][l] = init[0] + left[1][l] + right[2][l];
+    }
+}
+
+} // namespace ripemd160
+
+////// RIPEMD-160
+
+CRIPEMD160::CRIPEMD160() : bytes(0) {
+    ripemd160::Initialize(s);
+}
+
+CRIPEMD160 &CRIPEMD160::Write(const unsigned char *data, size_t len) {
+    const unsigned char *end = data + len;
+    size_t bufsize = bytes % 64;
+    if (bufsize && bufsize + len >= 64) {
+        // Fill the buffer, and process it.
+        memcpy(buf + bufsize, data, 64 - bufsize);
+        bytes += 64 - bufsize;
+        data += 64 - bufsize;
+        ripemd160::Transform(s, buf);
+        bufsize = 0;
+    }
+    while (end - data >= 64) {
+        // Process full chunks directly from the source.
+        ripemd160::Transform(s, data);
+        bytes += 64;
+        data += 64;
+    }
+    if (end > data) {
+        // Fill the buffer with what remains.
+        memcpy(buf + bufsize, data, end - data);
+        bytes += end - data;
+    }
+    return *this;
+}
+
+void CRIPEMD160::Finalize(unsigned char hash[OUTPUT_SIZE]) {
+    static const unsigned char pad[64] = {0x80};
+    unsigned char sizedesc[8];
+    WriteLE64(sizedesc, bytes << 3);
+    Write(pad, 1 + ((119 - (bytes % 64)) % 64));
+    Write(sizedesc, 8);
+    for (int i = 0; i < 5; ++i) {
+        WriteLE32(hash + 4 * i, s[i]);
+    }
+}
+
+CRIPEMD160 &CRIPEMD160::Reset() {
+    bytes = 0;
+    ripemd160::Initialize(s);
+    return *this;
+}
+
+void RIPEMD160_32Multiway(unsigned char *output, const unsigned char *input, size_t count) {
+    const size_t L = RIPEMD160_LANES;
+    while (count > 0) {
+        const size_t lanes = count < L ? count : L;
+
+        // Words 0-7 are the message, 8 is the padding byte, 14 the bit length (256).
+        uint32_t w[16][L] = {};
+        for (size_t l = 0; l < lanes; ++l) {
+            for (int i = 0; i < 8; ++i) w[i][l] = ReadLE32(input + 32 * l + 4 * i);
+            w[8][l] = 0x80;
+            w[14][l] = 256;
+        }
+
+        uint32_t out[5][L];
+        ripemd160::TransformMultiway(out, w);
+        for (size_t l = 0; l < lanes; ++l)
+            for (int i = 0; i < 5; ++i) WriteLE32(output + 20 * l + 4 * i, out[i][l]);
+
+        input += 32 * lanes;
+        output += 20 * lanes;
+        count -= lanes;
+    }
+}
+
+}
+}
@@ -0,0 +1,53 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file ripemd160.h
+ * @brief RIPEMD-160 hasher, with a lane-interleaved variant for hashing many SHA-256 digests at once
+ * @date 2026-10-18
+ *
+ * Follows the layout of the bundled sha256.h (Bitcoin Core derived).
+ */
+
+#ifndef SAFEHERON_CRYPTO_RIPEMD160_H
+#define SAFEHERON_CRYPTO_RIPEMD160_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace safeheron {
+namespace hash {
+
+/** Number of independent RIPEMD-160 states compressed together by RIPEMD160_32Multiway. */
+static const size_t RIPEMD160_LANES = 8;
+
+/** A hasher class for RIPEMD-160. */
+class CRIPEMD160 {
+private:
+    uint32_t s[5];
+    unsigned char buf[64];
+    uint64_t bytes;
+
+public:
+    static const size_t OUTPUT_SIZE = 20;
+
+    CRIPEMD160();
+
+    CRIPEMD160 &Write(const unsigned char *data, size_t len);
+
+    void Finalize(unsigned char hash[OUTPUT_SIZE]);
+
+    CRIPEMD160 &Reset();
+};
+
+/** Compute the RIPEMD-160 of a number of 32-byte messages (e.g. SHA-256 digests).
+ *  Up to RIPEMD160_LANES messages are padded into single blocks and compressed together,
+ *  with every step written as a loop over lanes so that the lanes map onto vector registers.
+ *  output:  pointer to a count*20 byte output buffer
+ *  input:   pointer to a count*32 byte input buffer
+ *  count:   the number of messages
+ */
+void RIPEMD160_32Multiway(unsigned char *output, const unsigned char *input, size_t count);
+
+}
+}
+
+#endif // SAFEHERON_CRYPTO_RIPEMD160_H
@@ -9,13 +9,34 @@
 
 #include "sha256.h"
 #include "common.h"
+#include "cpu_features.h"
 
 #include <assert.h>
 #include <string.h>
 
+#if defined(__x86_64__) || defined(__i386__)
+#define HAVE_GETCPUID
+#endif
+
 namespace safeheron {
 namespace hash {
 
+#if defined(HAVE_GETCPUID)
+namespace sha256_x86_shani {
+void Transform(uint32_t *s, const unsigned char *chunk, size_t blocks);
+}
+
+namespace sha256_sse41 {
+void Transform_4way(unsigned char *out, const unsigned char *in);
+void HashMulti_4way(unsigned char *out, const unsigned char *const *in, const size_t *len, size_t count, bool twice);
+}
+
+namespace sha256_avx2 {
+void Transform_8way(unsigned char *out, const unsigned char *in);
+void HashMulti_8way(unsigned char *out, const unsigned char *const *in, const size_t *len, size_t count, bool twice);
+}
+#endif
+
 /// Internal SHA-256 implementation.
 namespace sha256 {
 uint32_t inline Ch(uint32_t x, uint32_t y, uint32_t z) { return z ^ (x & (y ^ z)); }
@@ -387,6 +408,59 @@ void TransformD64(unsigned char *out, const unsigned char *in) {
     WriteBE32(out + 28, h + 0x5be0cd19ul);
 }
 
+/** Round constants. */
+static const uint32_t K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/** Compress one pre-padded block per lane, starting from the initial state.
+ *  Every step is a loop over lanes, so that the lanes map onto vector registers.
+ *  The message schedule is expanded in place, w is clobbered.
+ */
+void TransformMultiway(uint32_t out[8][SHA256_LANES], uint32_t w[16][SHA256_LANES]) {
+    const size_t L = SHA256_LANES;
+    uint32_t init[8];
+    Initialize(init);
+
+    uint32_t a[L], b[L], c[L], d[L], e[L], f[L], g[L], h[L];
+    for (size_t l = 0; l < L; ++l) {
+        a[l] = init[0]; b[l] = init[1]; c[l] = init[2]; d[l] = init[3];
+        e[l] = init[4]; f[l] = init[5]; g[l] = init[6]; h[l] = init[7];
+    }
+
+    for (int t = 0; t < 64; ++t) {
+        uint32_t *x = w[t & 15];
+        if (t >= 16) {
+            const uint32_t *x2 = w[(t - 2) & 15], *x7 = w[(t - 7) & 15], *x15 = w[(t - 15) & 15];
+            for (size_t l = 0; l < L; ++l) x[l] += sigma1(x2[l]) + x7[l] + sigma0(x15[l]);
+        }
+        for (size_t l = 0; l < L; ++l) {
+            uint32_t t1 = h[l] + Sigma1(e[l]) + Ch(e[l], f[l], g[l]) + K[t] + x[l];
+            uint32_t t2 = Sigma0(a[l]) + Maj(a[l], b[l], c[l]);
+            h[l] = g[l];
+            g[l] = f[l];
+            f[l] = e[l];
+            e[l] = d[l] + t1;
+            d[l] = c[l];
+            c[l] = b[l];
+            b[l] = a[l];
+            a[l] = t1 + t2;
+        }
+    }
+
+    for (size_t l = 0; l < L; ++l) {
+        out[0][l] = init[0] + a[l]; out[1][l] = init[1] + b[l]; out[2][l] = init[2] + c[l]; out[3][l] = init[3] + d[l];
+        out[4][l] = init[4] + e[l]; out[5][l] = init[5] + f[l]; out[6][l] = init[6] + g[l]; out[7][l] = init[7] + h[l];
+    }
+}
+
 } // namespace sha256
 
 typedef void (*TransformType)(uint32_t *, const unsigned char *, size_t);
@@ -437,6 +511,12 @@ TransformD64Type TransformD64_2way = nullptr;
 TransformD64Type TransformD64_4way = nullptr;
 TransformD64Type TransformD64_8way = nullptr;
 
+typedef void (*HashMultiType)(unsigned char *, const unsigned char *const *, const size_t *, size_t, bool);
+
+/** Multi-buffer kernel of SHA256Multi and SHA256DMulti and its number of lanes, none if null. */
+HashMultiType HashMulti = nullptr;
+size_t HashMultiLanes = 0;
+
 bool SelfTest() {
     // Input state (equal to the initial SHA256 state)
     static const uint32_t init[8] = {
@@ -523,6 +603,56 @@ bool SelfTest() {
     return true;
 }
 
+std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implementation) {
+    std::string ret = "standard";
+    Transform = sha256::Transform;
+    TransformD64 = sha256::TransformD64;
+    TransformD64_2way = nullptr;
+    TransformD64_4way = nullptr;
+    TransformD64_8way = nullptr;
+    HashMulti = nullptr;
+    HashMultiLanes = 0;
+
+#if defined(HAVE_GETCPUID)
+    const CpuFeatures &features = GetCpuFeatures();
+    bool have_sse4 = features.sse41;
+    bool have_avx2 = features.avx2;
+    const bool have_x86_shani = features.shani;
+
+    if (have_x86_shani && (use_implementation & sha256_implementation::USE_SHANI)) {
+        Transform = sha256_x86_shani::Transform;
+        TransformD64 = TransformD64Wrapper<sha256_x86_shani::Transform>;
+        ret = "x86_shani(1way)";
+        // One SHA-NI stream is about as fast per message as the eight AVX2 lanes, so the
+        // multi-way and multi-buffer kernels are only installed without it.
+        have_sse4 = false;
+        have_avx2 = false;
+    }
+
+    // The multi-way kernels hash several 64-byte messages per call; SHA256D64 prefers the widest.
+    if (have_sse4 && (use_implementation & sha256_implementation::USE_SSE4)) {
+        TransformD64_4way = sha256_sse41::Transform_4way;
+        HashMulti = sha256_sse41::HashMulti_4way;
+        HashMultiLanes = 4;
+        ret += ",sse41(4way)";
+    }
+    if (have_avx2 && (use_implementation & sha256_implementation::USE_AVX2)) {
+        TransformD64_8way = sha256_avx2::Transform_8way;
+        HashMulti = sha256_avx2::HashMulti_8way;
+        HashMultiLanes = 8;
+        ret += ",avx2(8way)";
+    }
+#else
+    (void)use_implementation;
+#endif
+
+    assert(SelfTest());
+    return ret;
+}
+
+/** The implementation is selected before main runs, so every hash in the process uses it. */
+static const std::string SHA256_IMPLEMENTATION = SHA256AutoDetect();
+
 ////// SHA-256
 
 CSHA256::CSHA256() : bytes(0) {
@@ -576,6 +706,22 @@ CSHA256 &CSHA256::Reset() {
     return *this;
 }
 
+SHA256Midstate CSHA256::SaveMidstate() const {
+    SHA256Midstate midstate;
+    memcpy(midstate.s, s, sizeof(s));
+    memcpy(midstate.buf, buf, bytes % 64);
+    midstate.bytes = bytes;
+    return midstate;
+}
+
+CSHA256 CSHA256::FromMidstate(const SHA256Midstate &midstate) {
+    CSHA256 hasher;
+    memcpy(hasher.s, midstate.s, sizeof(hasher.s));
+    memcpy(hasher.buf, midstate.buf, midstate.bytes % 64);
+    hasher.bytes = midstate.bytes;
+    return hasher;
+}
+
 void SHA256D64(unsigned char *out, const unsigned char *in, size_t blocks) {
     if (TransformD64_8way) {
         while (blocks >= 8) {
@@ -609,5 +755,135 @@ void SHA256D64(unsigned char *out, const unsigned char *in, size_t blocks) {
     }
 }
 
+void SHA256D(unsigned char *out, const unsigned char *in, size_t len) {
+    uint32_t s[8];
+    unsigned char tail[128] = {0};
+    unsigned char buffer2[64] = {
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0
+    };
+
+    // First hash: full blocks straight from the input, then the padded remainder.
+    sha256::Initialize(s);
+    size_t blocks = len / 64;
+    Transform(s, in, blocks);
+    size_t rest = len % 64;
+    memcpy(tail, in + 64 * blocks, rest);
+    tail[rest] = 0x80;
+    size_t tailBlocks = rest < 56 ? 1 : 2;
+    WriteBE64(tail + 64 * tailBlocks - 8, (uint64_t)len << 3);
+    Transform(s, tail, tailBlocks);
+
+    // Second hash: the 32-byte digest always fits one block.
+    for (int i = 0; i < 8; ++i) WriteBE32(buffer2 + 4 * i, s[i]);
+    sha256::Initialize(s);
+    Transform(s, buffer2, 1);
+    for (int i = 0; i < 8; ++i) WriteBE32(out + 4 * i, s[i]);
+}
+
+void Hash256Short(unsigned char *out, const unsigned char *in, size_t len) {
+    assert(len <= SHA256_SHORT_MAX_LEN);
+    uint32_t s[8];
+    unsigned char block[64] = {0};
+    unsigned char buffer2[64] = {
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0
+    };
+
+    // First hash: message, pad byte and bit length in a single block.
+    if (len > 0) memcpy(block, in, len);
+    block[len] = 0x80;
+    WriteBE64(block + 56, (uint64_t)len << 3);
+    sha256::Initialize(s);
+    Transform(s, block, 1);
+
+    // Second hash: the digest, pre-padded.
+    for (int i = 0; i < 8; ++i) WriteBE32(buffer2 + 4 * i, s[i]);
+    sha256::Initialize(s);
+    Transform(s, buffer2, 1);
+    for (int i = 0; i < 8; ++i) WriteBE32(out + 4 * i, s[i]);
+}
+
+void SHA256_32Multiway(unsigned char *output, const unsigned char *input, size_t count) {
+    if (Transform != sha256::Transform) {
+        // A hardware transform compresses one block faster than the portable lanes compress eight.
+        unsigned char block[64] = {0};
+        block[32] = 0x80;
+        block[62] = 1;  // bit length 256
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t s[8];
+            sha256::Initialize(s);
+            memcpy(block, input + 32 * i, 32);
+            Transform(s, block, 1);
+            for (int j = 0; j < 8; ++j) WriteBE32(output + 32 * i + 4 * j, s[j]);
+        }
+        return;
+    }
+
+    const size_t L = SHA256_LANES;
+    while (count > 0) {
+        const size_t lanes = count < L ? count : L;
+
+        // Words 0-7 are the message, 8 is the padding byte, 15 the bit length (256).
+        uint32_t w[16][L] = {};
+        for (size_t l = 0; l < lanes; ++l) {
+            for (int i = 0; i < 8; ++i) w[i][l] = ReadBE32(input + 32 * l + 4 * i);
+            w[8][l] = 0x80000000ul;
+            w[15][l] = 256;
+        }
+
+        uint32_t out[8][L];
+        sha256::TransformMultiway(out, w);
+        for (size_t l = 0; l < lanes; ++l)
+            for (int i = 0; i < 8; ++i) WriteBE32(output + 32 * l + 4 * i, out[i][l]);
+
+        input += 32 * lanes;
+        output += 32 * lanes;
+        count -= lanes;
+    }
+}
+
+/** Hash count messages, SHA256_MULTI_MAX_LEN bytes or shorter ones in the lanes of HashMulti. */
+static void HashMessages(unsigned char *output, const unsigned char *const *inputs, const size_t *lens, size_t count, bool twice) {
+    const unsigned char *laneInputs[8];
+    size_t laneLens[8], laneIndex[8];
+    unsigned char digests[8 * 32];
+    size_t pending = 0;
+    auto flush = [&]() {
+        HashMulti(digests, laneInputs, laneLens, pending, twice);
+        for (size_t l = 0; l < pending; ++l) memcpy(output + 32 * laneIndex[l], digests + 32 * l, 32);
+        pending = 0;
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+        if (HashMulti == nullptr || lens[i] > SHA256_MULTI_MAX_LEN) {
+            if (twice && lens[i] <= SHA256_SHORT_MAX_LEN)
+                Hash256Short(output + 32 * i, inputs[i], lens[i]);
+            else if (twice)
+                SHA256D(output + 32 * i, inputs[i], lens[i]);
+            else
+                CSHA256().Write(inputs[i], lens[i]).Finalize(output + 32 * i);
+            continue;
+        }
+        laneInputs[pending] = inputs[i];
+        laneLens[pending] = lens[i];
+        laneIndex[pending++] = i;
+        if (pending == HashMultiLanes) flush();
+    }
+    if (pending > 0) flush();
+}
+
+void SHA256Multi(unsigned char *output, const unsigned char *const *inputs, const size_t *lens, size_t count) {
+    HashMessages(output, inputs, lens, count, false);
+}
+
+void SHA256DMulti(unsigned char *output, const unsigned char *const *inputs, const size_t *lens, size_t count) {
+    HashMessages(output, inputs, lens, count, true);
+}
+
+}
 }
-}
\ No newline at end of file
@@ -13,6 +13,17 @@
 namespace safeheron{
 namespace hash {
 
+/** Number of independent SHA-256 states compressed together by SHA256_32Multiway. */
+static const size_t SHA256_LANES = 8;
+
+/** Snapshot of a CSHA256 hasher: the chaining state, the buffered partial block and the number of
+ *  bytes written so far. */
+struct SHA256Midstate {
+    uint32_t s[8];
+    unsigned char buf[64];
+    uint64_t bytes;
+};
+
 /** A hasher class for SHA-256. */
 class CSHA256 {
 private:
@@ -30,12 +41,31 @@ public:
     void Finalize(unsigned char hash[OUTPUT_SIZE]);
 
     CSHA256 &Reset();
+
+    /** Export the state after the data written so far, e.g. a prefix shared by many messages. */
+    SHA256Midstate SaveMidstate() const;
+
+    /** Create a hasher that continues from a state exported by SaveMidstate. */
+    static CSHA256 FromMidstate(const SHA256Midstate &midstate);
 };
 
-/** Autodetect the best available SHA256 implementation.
+namespace sha256_implementation {
+/** Hardware SHA-256 implementations SHA256AutoDetect may select. */
+enum UseImplementation : uint8_t {
+    STANDARD = 0,
+    USE_SSE4 = 1 << 0,
+    USE_AVX2 = 1 << 1,
+    USE_SHANI = 1 << 2,
+    USE_ALL = 0xff,
+};
+}
+
+/** Autodetect the best available SHA256 implementation and make every hash in the process use it.
+ *  Runs once at startup with USE_ALL; callers may run it again to restrict the choice (e.g. to
+ *  compare implementations in tests). The selected functions are checked by a self-test.
  *  Returns the name of the implementation.
  */
-std::string SHA256AutoDetect();
+std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implementation = sha256_implementation::USE_ALL);
 
 /** Compute multiple double-SHA256's of 64-byte blobs.
  *  output:  pointer to a blocks*32 byte output buffer
@@ -44,6 +74,55 @@ std::string SHA256AutoDetect();
  */
 void SHA256D64(unsigned char *output, const unsigned char *input, size_t blocks);
 
+/** Compute the double-SHA256 of a message without a hasher object.
+ *  The padded tail of the message is built on the stack, and the second hash
+ *  always compresses a single pre-padded block.
+ *  output:  pointer to a 32 byte output buffer
+ *  input:   pointer to a len byte input buffer
+ *  len:     the message length
+ */
+void SHA256D(unsigned char *output, const unsigned char *input, size_t len);
+
+/** Longest message Hash256Short accepts: the message, the 0x80 pad byte and the 64-bit length
+ *  fit one block. */
+static const size_t SHA256_SHORT_MAX_LEN = 64 - 9;
+
+/** Compute the double-SHA256 of a message of at most SHA256_SHORT_MAX_LEN bytes (e.g. a WIF or
+ *  address payload). Both padded blocks are built directly and compressed by one Transform call
+ *  each, without the buffering of CSHA256.
+ *  output:  pointer to a 32 byte output buffer
+ *  input:   pointer to a len byte input buffer
+ *  len:     the message length, at most SHA256_SHORT_MAX_LEN
+ */
+void Hash256Short(unsigned char *output, const unsigned char *input, size_t len);
+
+/** Compute the SHA-256 of a number of 32-byte messages (e.g. the inner digests of double-SHA256).
+ *  Up to SHA256_LANES messages are padded into single blocks and compressed together,
+ *  with every step written as a loop over lanes so that the lanes map onto vector registers.
+ *  When SHA256AutoDetect selected a hardware transform, the messages go through it one by one.
+ *  output:  pointer to a count*32 byte output buffer
+ *  input:   pointer to a count*32 byte input buffer
+ *  count:   the number of messages
+ */
+void SHA256_32Multiway(unsigned char *output, const unsigned char *input, size_t count);
+
+/** Longest message SHA256Multi and SHA256DMulti hash in SIMD lanes (four blocks with padding);
+ *  longer messages are hashed one by one. */
+static const size_t SHA256_MULTI_MAX_LEN = 4 * 64 - 9;
+
+/** Compute the SHA-256 of a number of messages of mixed lengths.
+ *  Messages are padded per lane and hashed 4 or 8 at a time by the SSE4.1 or AVX2 kernel that
+ *  SHA256AutoDetect selected; without one (or with SHA-NI) they are hashed one by one.
+ *  output:  pointer to a count*32 byte output buffer
+ *  inputs:  count message pointers
+ *  lens:    count message lengths
+ *  count:   the number of messages
+ */
+void SHA256Multi(unsigned char *output, const unsigned char *const *inputs, const size_t *lens, size_t count);
+
+/** Compute the double-SHA256 of a number of messages of mixed lengths, as SHA256Multi. */
+void SHA256DMulti(unsigned char *output, const unsigned char *const *inputs, const size_t *lens, size_t count);
+
 }
 }
 
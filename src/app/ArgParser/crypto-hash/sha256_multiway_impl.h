@@ -0,0 +1,203 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file sha256_multiway_impl.h
+ * @brief Lane-parallel SHA-256 over GCC vector types, shared by the SIMD kernels
+ * @date 2026-10-18
+ *
+ * Every 32-bit lane of a vector holds one independent SHA-256 state, so one compression over a
+ * vector of N lanes hashes N blocks. This header is included by the per-instruction-set files
+ * (sha256_sse41.cpp, sha256_avx2.cpp) after their target pragma, so the same code is compiled
+ * once per instruction set; everything in it has internal linkage to keep the copies apart.
+ * Not part of the public interface.
+ */
+
+#ifndef SAFEHERON_CRYPTO_SHA256_MULTIWAY_IMPL_H
+#define SAFEHERON_CRYPTO_SHA256_MULTIWAY_IMPL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "common.h"
+
+namespace safeheron {
+namespace hash {
+namespace {
+namespace sha256_multiway {
+
+/** Round constants. */
+const uint32_t K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/** Most blocks a message of HashMultiway may take, padding included. */
+const size_t MULTI_MAX_BLOCKS = 4;
+
+/** Initial state. */
+const uint32_t INIT[8] = {
+        0x6a09e667ul, 0xbb67ae85ul, 0x3c6ef372ul, 0xa54ff53aul, 0x510e527ful, 0x9b05688cul, 0x1f83d9abul, 0x5be0cd19ul
+};
+
+template<typename V>
+inline V Ch(V x, V y, V z) { return z ^ (x & (y ^ z)); }
+
+template<typename V>
+inline V Maj(V x, V y, V z) { return (x & y) | (z & (x | y)); }
+
+template<typename V>
+inline V Sigma0(V x) { return (x >> 2 | x << 30) ^ (x >> 13 | x << 19) ^ (x >> 22 | x << 10); }
+
+template<typename V>
+inline V Sigma1(V x) { return (x >> 6 | x << 26) ^ (x >> 11 | x << 21) ^ (x >> 25 | x << 7); }
+
+template<typename V>
+inline V sigma0(V x) { return (x >> 7 | x << 25) ^ (x >> 18 | x << 14) ^ (x >> 3); }
+
+template<typename V>
+inline V sigma1(V x) { return (x >> 17 | x << 15) ^ (x >> 19 | x << 13) ^ (x >> 10); }
+
+/** One round of SHA-256 in every lane. */
+template<typename V>
+inline void Round(V a, V b, V c, V &d, V e, V f, V g, V &h, V k) {
+    V t1 = h + Sigma1(e) + Ch(e, f, g) + k;
+    V t2 = Sigma0(a) + Maj(a, b, c);
+    d += t1;
+    h = t1 + t2;
+}
+
+/** Message word j of the current 16-round group; from round 16 on, the schedule is expanded in place. */
+template<typename V>
+inline V Word(V w[16], int j, int t) {
+    if (t == 0) return w[j];
+    return w[j] += sigma1(w[(j + 14) & 15]) + w[(j + 9) & 15] + sigma0(w[(j + 1) & 15]);
+}
+
+/** Compress one block per lane into the states s; the message words w are clobbered. */
+template<typename V>
+inline void Compress(V s[8], V w[16]) {
+    V a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+    for (int t = 0; t < 64; t += 16) {
+        Round(a, b, c, d, e, f, g, h, K[t + 0] + Word(w, 0, t));
+        Round(h, a, b, c, d, e, f, g, K[t + 1] + Word(w, 1, t));
+        Round(g, h, a, b, c, d, e, f, K[t + 2] + Word(w, 2, t));
+        Round(f, g, h, a, b, c, d, e, K[t + 3] + Word(w, 3, t));
+        Round(e, f, g, h, a, b, c, d, K[t + 4] + Word(w, 4, t));
+        Round(d, e, f, g, h, a, b, c, K[t + 5] + Word(w, 5, t));
+        Round(c, d, e, f, g, h, a, b, K[t + 6] + Word(w, 6, t));
+        Round(b, c, d, e, f, g, h, a, K[t + 7] + Word(w, 7, t));
+        Round(a, b, c, d, e, f, g, h, K[t + 8] + Word(w, 8, t));
+        Round(h, a, b, c, d, e, f, g, K[t + 9] + Word(w, 9, t));
+        Round(g, h, a, b, c, d, e, f, K[t + 10] + Word(w, 10, t));
+        Round(f, g, h, a, b, c, d, e, K[t + 11] + Word(w, 11, t));
+        Round(e, f, g, h, a, b, c, d, K[t + 12] + Word(w, 12, t));
+        Round(d, e, f, g, h, a, b, c, K[t + 13] + Word(w, 13, t));
+        Round(c, d, e, f, g, h, a, b, K[t + 14] + Word(w, 14, t));
+        Round(b, c, d, e, f, g, h, a, K[t + 15] + Word(w, 15, t));
+    }
+    s[0] += a; s[1] += b; s[2] += c; s[3] += d;
+    s[4] += e; s[5] += f; s[6] += g; s[7] += h;
+}
+
+/** Set every lane of the states to the initial state. */
+template<typename V>
+inline void Initialize(V s[8]) {
+    for (int i = 0; i < 8; ++i) s[i] = V{} + INIT[i];
+}
+
+/** Double-SHA256 of one 64-byte message per lane: out holds lanes*32 bytes, in lanes*64 bytes. */
+template<typename V>
+inline void TransformD64(unsigned char *out, const unsigned char *in) {
+    const size_t lanes = sizeof(V) / sizeof(uint32_t);
+    V s[8], w[16];
+
+    // Transform 1: the message.
+    // Transpose through plain words: element-wise writes into vectors go through memory one by one.
+    uint32_t words[16][lanes];
+    for (int i = 0; i < 16; ++i)
+        for (size_t l = 0; l < lanes; ++l) words[i][l] = ReadBE32(in + 64 * l + 4 * i);
+    memcpy(w, words, sizeof(words));
+    Initialize(s);
+    Compress(s, w);
+
+    // Transform 2: the padding of a 64-byte message.
+    for (int i = 0; i < 16; ++i) w[i] = V{};
+    w[0] += 0x80000000ul;
+    w[15] += 512;
+    Compress(s, w);
+
+    // Transform 3: the padded 32-byte digest.
+    for (int i = 0; i < 8; ++i) w[i] = s[i];
+    for (int i = 8; i < 16; ++i) w[i] = V{};
+    w[8] += 0x80000000ul;
+    w[15] += 256;
+    Initialize(s);
+    Compress(s, w);
+
+    memcpy(words, s, sizeof(s));
+    for (size_t l = 0; l < lanes; ++l)
+        for (int i = 0; i < 8; ++i) WriteBE32(out + 32 * l + 4 * i, words[i][l]);
+}
+
+/** Single or double SHA-256 of up to one message per lane, of any length that fits
+ *  MULTI_MAX_BLOCKS blocks with its padding. Every lane is padded on its own and all lanes run as
+ *  many compressions as the longest message needs; a lane whose message has ended keeps its
+ *  state through a mask. out holds count*32 bytes; lanes past count hash an empty message. */
+template<typename V>
+inline void HashMultiway(unsigned char *out, const unsigned char *const *in, const size_t *len, size_t count, bool twice) {
+    const size_t lanes = sizeof(V) / sizeof(uint32_t);
+    unsigned char padded[lanes][MULTI_MAX_BLOCKS * 64];
+    size_t blocks[lanes];
+    size_t maxBlocks = 1;
+    for (size_t l = 0; l < lanes; ++l) {
+        const size_t n = l < count ? len[l] : 0;
+        blocks[l] = (n + 9 + 63) / 64;
+        if (n > 0) memcpy(padded[l], in[l], n);
+        memset(padded[l] + n, 0, blocks[l] * 64 - n);
+        padded[l][n] = 0x80;
+        WriteBE64(padded[l] + blocks[l] * 64 - 8, (uint64_t)n << 3);
+        if (blocks[l] > maxBlocks) maxBlocks = blocks[l];
+    }
+
+    V s[8], w[16], old[8], mask;
+    uint32_t words[16][lanes], live[lanes];
+    Initialize(s);
+    for (size_t b = 0; b < maxBlocks; ++b) {
+        for (int i = 0; i < 16; ++i)
+            for (size_t l = 0; l < lanes; ++l) words[i][l] = b < blocks[l] ? ReadBE32(padded[l] + 64 * b + 4 * i) : 0;
+        memcpy(w, words, sizeof(w));
+        for (size_t l = 0; l < lanes; ++l) live[l] = b < blocks[l] ? 0xfffffffful : 0;
+        memcpy(&mask, live, sizeof(mask));
+
+        for (int i = 0; i < 8; ++i) old[i] = s[i];
+        Compress(s, w);
+        for (int i = 0; i < 8; ++i) s[i] = (s[i] & mask) | (old[i] & ~mask);
+    }
+
+    if (twice) {
+        // The 32-byte digests always fit one padded block.
+        for (int i = 0; i < 8; ++i) w[i] = s[i];
+        for (int i = 8; i < 16; ++i) w[i] = V{};
+        w[8] += 0x80000000ul;
+        w[15] += 256;
+        Initialize(s);
+        Compress(s, w);
+    }
+
+    memcpy(words, s, sizeof(s));
+    for (size_t l = 0; l < count; ++l)
+        for (int i = 0; i < 8; ++i) WriteBE32(out + 32 * l + 4 * i, words[i][l]);
+}
+
+} // namespace sha256_multiway
+} // namespace
+}
+}
+
+#endif // SAFEHERON_CRYPTO_SHA256_MULTIWAY_IMPL_H
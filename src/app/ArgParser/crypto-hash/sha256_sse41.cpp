@@ -0,0 +1,40 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file sha256_sse41.cpp
+ * @brief 4-way SHA-256 kernels using SSE4.1
+ * @date 2026-10-18
+ *
+ * Double-SHA256 of 64-byte messages (TransformD64_4way) and single or double SHA-256 of short
+ * messages of mixed lengths (SHA256Multi). SHA256AutoDetect only installs these kernels on CPUs
+ * that report SSE4.1.
+ */
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+
+#include "sha256_multiway_impl.h"
+
+namespace safeheron {
+namespace hash {
+namespace sha256_sse41 {
+
+/** 4 32-bit lanes in one 128-bit register. */
+typedef uint32_t Lanes __attribute__((vector_size(16)));
+
+void Transform_4way(unsigned char *out, const unsigned char *in) {
+    sha256_multiway::TransformD64<Lanes>(out, in);
+}
+
+void HashMulti_4way(unsigned char *out, const unsigned char *const *in, const size_t *len, size_t count, bool twice) {
+    sha256_multiway::HashMultiway<Lanes>(out, in, len, count, twice);
+}
+
+} // namespace sha256_sse41
+}
+}
+
+#pragma GCC pop_options
+
+#endif
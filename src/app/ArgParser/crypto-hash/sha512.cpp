@@ -0,0 +1,211 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file sha512.cpp
+ * @brief SHA-512 hasher, with a lane-interleaved compression function for multi-buffer hashing
+ * @date 2026-10-18
+ */
+
+#include "sha512.h"
+#include "common.h"
+
+#include <string.h>
+
+namespace safeheron {
+namespace hash {
+
+/// Internal SHA-512 implementation.
+namespace sha512 {
+
+static const uint64_t K[80] = {
+        0x428a2f98d728ae22ull, 0x7137449123ef65cdull, 0xb5c0fbcfec4d3b2full, 0xe9b5dba58189dbbcull,
+        0x3956c25bf348b538ull, 0x59f111f1b605d019ull, 0x923f82a4af194f9bull, 0xab1c5ed5da6d8118ull,
+        0xd807aa98a3030242ull, 0x12835b0145706fbeull, 0x243185be4ee4b28cull, 0x550c7dc3d5ffb4e2ull,
+        0x72be5d74f27b896full, 0x80deb1fe3b1696b1ull, 0x9bdc06a725c71235ull, 0xc19bf174cf692694ull,
+        0xe49b69c19ef14ad2ull, 0xefbe4786384f25e3ull, 0x0fc19dc68b8cd5b5ull, 0x240ca1cc77ac9c65ull,
+        0x2de92c6f592b0275ull, 0x4a7484aa6ea6e483ull, 0x5cb0a9dcbd41fbd4ull, 0x76f988da831153b5ull,
+        0x983e5152ee66dfabull, 0xa831c66d2db43210ull, 0xb00327c898fb213full, 0xbf597fc7beef0ee4ull,
+        0xc6e00bf33da88fc2ull, 0xd5a79147930aa725ull, 0x06ca6351e003826full, 0x142929670a0e6e70ull,
+        0x27b70a8546d22ffcull, 0x2e1b21385c26c926ull, 0x4d2c6dfc5ac42aedull, 0x53380d139d95b3dfull,
+        0x650a73548baf63deull, 0x766a0abb3c77b2a8ull, 0x81c2c92e47edaee6ull, 0x92722c851482353bull,
+        0xa2bfe8a14cf10364ull, 0xa81a664bbc423001ull, 0xc24b8b70d0f89791ull, 0xc76c51a30654be30ull,
+        0xd192e819d6ef5218ull, 0xd69906245565a910ull, 0xf40e35855771202aull, 0x106aa07032bbd1b8ull,
+        0x19a4c116b8d2d0c8ull, 0x1e376c085141ab53ull, 0x2748774cdf8eeb99ull, 0x34b0bcb5e19b48a8ull,
+        0x391c0cb3c5c95a63ull, 0x4ed8aa4ae3418acbull, 0x5b9cca4f7763e373ull, 0x682e6ff3d6b2b8a3ull,
+        0x748f82ee5defb2fcull, 0x78a5636f43172f60ull, 0x84c87814a1f0ab72ull, 0x8cc702081a6439ecull,
+        0x90befffa23631e28ull, 0xa4506cebde82bde9ull, 0xbef9a3f7b2c67915ull, 0xc67178f2e372532bull,
+        0xca273eceea26619cull, 0xd186b8c721c0c207ull, 0xeada7dd6cde0eb1eull, 0xf57d4f7fee6ed178ull,
+        0x06f067aa72176fbaull, 0x0a637dc5a2c898a6ull, 0x113f9804bef90daeull, 0x1b710b35131c471bull,
+        0x28db77f523047d84ull, 0x32caab7b40c72493ull, 0x3c9ebe0a15c9bebcull, 0x431d67c49c100d4cull,
+        0x4cc5d4becb3e42b6ull, 0x597f299cfc657e2aull, 0x5fcb6fab3ad6faecull, 0x6c44198c4a475817ull,
+};
+
+uint64_t inline Ch(uint64_t x, uint64_t y, uint64_t z) { return z ^ (x & (y ^ z)); }
+
+uint64_t inline Maj(uint64_t x, uint64_t y, uint64_t z) { return (x & y) | (z & (x | y)); }
+
+uint64_t inline Sigma0(uint64_t x) { return (x >> 28 | x << 36) ^ (x >> 34 | x << 30) ^ (x >> 39 | x << 25); }
+
+uint64_t inline Sigma1(uint64_t x) { return (x >> 14 | x << 50) ^ (x >> 18 | x << 46) ^ (x >> 41 | x << 23); }
+
+uint64_t inline sigma0(uint64_t x) { return (x >> 1 | x << 63) ^ (x >> 8 | x << 56) ^ (x >> 7); }
+
+uint64_t inline sigma1(uint64_t x) { return (x >> 19 | x << 45) ^ (x >> 61 | x << 3) ^ (x >> 6); }
+
+/** Initialize SHA-512 state. */
+void inline Initialize(uint64_t *s) {
+    s[0] = 0x6a09e667f3bcc908ull;
+    s[1] = 0xbb67ae8584caa73bull;
+    s[2] = 0x3c6ef372fe94f82bull;
+    s[3] = 0xa54ff53a5f1d36f1ull;
+    s[4] = 0x510e527fade682d1ull;
+    s[5] = 0x9b05688c2b3e6c1full;
+    s[6] = 0x1f83d9abfb41bd6bull;
+    s[7] = 0x5be0cd19137e2179ull;
+}
+
+/** Perform a number of SHA-512 transformations, processing 128-byte chunks. */
+void Transform(uint64_t *s, const unsigned char *chunk, size_t blocks) {
+    while (blocks--) {
+        uint64_t w[80];
+        for (int i = 0; i < 16; ++i) w[i] = ReadBE64(chunk + 8 * i);
+        for (int i = 16; i < 80; ++i) w[i] = sigma1(w[i - 2]) + w[i - 7] + sigma0(w[i - 15]) + w[i - 16];
+
+        uint64_t a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+        for (int i = 0; i < 80; ++i) {
+            uint64_t t1 = h + Sigma1(e) + Ch(e, f, g) + K[i] + w[i];
+            uint64_t t2 = Sigma0(a) + Maj(a, b, c);
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        s[0] += a;
+        s[1] += b;
+        s[2] += c;
+        s[3] += d;
+        s[4] += e;
+        s[5] += f;
+        s[6] += g;
+        s[7] += h;
+        chunk += 128;
+    }
+}
+
+/** One SHA-512 compression over SHA512_LANES interleaved states. */
+void TransformMultiway(uint64_t state[8][SHA512_LANES], const uint64_t words[16][SHA512_LANES]) {
+    const size_t L = SHA512_LANES;
+    uint64_t w[80][L];
+    for (int i = 0; i < 16; ++i)
+        for (size_t l = 0; l < L; ++l) w[i][l] = words[i][l];
+    for (int i = 16; i < 80; ++i)
+        for (size_t l = 0; l < L; ++l)
+            w[i][l] = sigma1(w[i - 2][l]) + w[i - 7][l] + sigma0(w[i - 15][l]) + w[i - 16][l];
+
+    uint64_t a[L], b[L], c[L], d[L], e[L], f[L], g[L], h[L];
+    for (size_t l = 0; l < L; ++l) {
+        a[l] = state[0][l];
+        b[l] = state[1][l];
+        c[l] = state[2][l];
+        d[l] = state[3][l];
+        e[l] = state[4][l];
+        f[l] = state[5][l];
+        g[l] = state[6][l];
+        h[l] = state[7][l];
+    }
+
+    for (int i = 0; i < 80; ++i) {
+        for (size_t l = 0; l < L; ++l) {
+            uint64_t t1 = h[l] + Sigma1(e[l]) + Ch(e[l], f[l], g[l]) + K[i] + w[i][l];
+            uint64_t t2 = Sigma0(a[l]) + Maj(a[l], b[l], c[l]);
+            h[l] = g[l];
+            g[l] = f[l];
+            f[l] = e[l];
+            e[l] = d[l] + t1;
+            d[l] = c[l];
+            c[l] = b[l];
+            b[l] = a[l];
+            a[l] = t1 + t2;
+        }
+    }
+
+    for (size_t l = 0; l < L; ++l) {
+        state[0][l] += a[l];
+        state[1][l] += b[l];
+        state[2][l] += c[l];
+        state[3][l] += d[l];
+        state[4][l] += e[l];
+        state[5][l] += f[l];
+        state[6][l] += g[l];
+        state[7][l] += h[l];
+    }
+}
+
+} // namespace sha512
+
+void SHA512Initialize(uint64_t s[8]) {
+    sha512::Initialize(s);
+}
+
+void SHA512Transform(uint64_t s[8], const unsigned char *chunk, size_t blocks) {
+    sha512::Transform(s, chunk, blocks);
+}
+
+void SHA512TransformMultiway(uint64_t state[8][SHA512_LANES], const uint64_t words[16][SHA512_LANES]) {
+    sha512::TransformMultiway(state, words);
+}
+
+////// SHA-512
+
+CSHA512::CSHA512() : bytes(0) {
+    sha512::Initialize(s);
+}
+
+CSHA512 &CSHA512::Write(const unsigned char *data, size_t len) {
+    const unsigned char *end = data + len;
+    size_t bufsize = bytes % 128;
+    if (bufsize && bufsize + len >= 128) {
+        // Fill the buffer, and process it.
+        memcpy(buf + bufsize, data, 128 - bufsize);
+        bytes += 128 - bufsize;
+        data += 128 - bufsize;
+        sha512::Transform(s, buf, 1);
+        bufsize = 0;
+    }
+    if (end - data >= 128) {
+        size_t blocks = (end - data) / 128;
+        sha512::Transform(s, data, blocks);
+        data += 128 * blocks;
+        bytes += 128 * blocks;
+    }
+    if (end > data) {
+        // Fill the buffer with what remains.
+        memcpy(buf + bufsize, data, end - data);
+        bytes += end - data;
+    }
+    return *this;
+}
+
+void CSHA512::Finalize(unsigned char hash[OUTPUT_SIZE]) {
+    static const unsigned char pad[128] = {0x80};
+    unsigned char sizedesc[16] = {0};
+    WriteBE64(sizedesc + 8, bytes << 3);
+    Write(pad, 1 + ((239 - (bytes % 128)) % 128));
+    Write(sizedesc, 16);
+    for (int i = 0; i < 8; ++i) {
+        WriteBE64(hash + 8 * i, s[i]);
+    }
+}
+
+CSHA512 &CSHA512::Reset() {
+    bytes = 0;
+    sha512::Initialize(s);
+    return *this;
+}
+
+}
+}
@@ -0,0 +1,57 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file sha512.h
+ * @brief SHA-512 hasher, with a lane-interleaved compression function for multi-buffer hashing
+ * @date 2026-10-18
+ *
+ * Follows the layout of the bundled sha256.h (Bitcoin Core derived).
+ */
+
+#ifndef SAFEHERON_CRYPTO_SHA512_H
+#define SAFEHERON_CRYPTO_SHA512_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace safeheron {
+namespace hash {
+
+/** Number of independent SHA-512 states compressed together by SHA512TransformMultiway. */
+static const size_t SHA512_LANES = 4;
+
+/** A hasher class for SHA-512. */
+class CSHA512 {
+private:
+    uint64_t s[8];
+    unsigned char buf[128];
+    uint64_t bytes;
+
+public:
+    static const size_t OUTPUT_SIZE = 64;
+
+    CSHA512();
+
+    CSHA512 &Write(const unsigned char *data, size_t len);
+
+    void Finalize(unsigned char hash[OUTPUT_SIZE]);
+
+    CSHA512 &Reset();
+};
+
+/** Load the SHA-512 initial state into s. */
+void SHA512Initialize(uint64_t s[8]);
+
+/** Compress a number of 128-byte chunks into the raw state s (no padding is applied). */
+void SHA512Transform(uint64_t s[8], const unsigned char *chunk, size_t blocks);
+
+/** Compress one block into each of SHA512_LANES independent states.
+ *  state: lane-interleaved state words, state[i][lane]
+ *  words: lane-interleaved big-endian message words of the block, words[i][lane]
+ *  Every round is written as a loop over lanes so that the lanes map onto vector registers.
+ */
+void SHA512TransformMultiway(uint64_t state[8][SHA512_LANES], const uint64_t words[16][SHA512_LANES]);
+
+}
+}
+
+#endif // SAFEHERON_CRYPTO_SHA512_H
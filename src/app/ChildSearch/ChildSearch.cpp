@@ -0,0 +1,248 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file ChildSearch.cpp
+ * @brief Reverse lookup of the child index that produced a public key under an xpub
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "ChildSearch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "../ArgParser/crypto-encode/hex.h"
+#include "../ArgParser/crypto-hash/hash160.h"
+#include "../ArgParser/crypto-hash/ripemd160.h"
+#include "../Utility/EccContextPool.h"
+#include "../Utility/JsonWriter.h"
+#include "../Utility/PathTemplate.h"
+#include "../Utility/StringUtilities.h"
+
+extern "C"
+{
+#include <btc/bip32.h>
+#include <btc/chainparams.h>
+}
+
+/** Number of consecutive child indices a worker takes at once. */
+static const uint32_t CHILD_SEARCH_CHUNK = 4096;
+
+/** Number of children derived before their keys are looked up, one multi-buffer HASH160 call. */
+static const size_t CHILD_SEARCH_GROUP = safeheron::hash::RIPEMD160_LANES;
+
+
+/**
+ * Reads the targets, one compressed public key (66 hex characters) or HASH160 (40 hex characters) per line
+ * @param in targets stream; empty lines and lines starting with # are skipped, duplicates are ignored
+ * @return the targets
+ */
+ChildSearchTargets loadChildSearchTargets(std::istream &in) {
+    ChildSearchTargets targets;
+    std::string line;
+    size_t lineNumber = 0;
+
+    while (getline(in, line)) {
+        lineNumber++;
+        line = StringUtilities::removeWhiteCharacters(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        uint8_t bytes[33];
+        size_t size = 0;
+        const bool isHex = (line.size() == 66 || line.size() == 40) &&
+                           safeheron::encode::hex::DecodeFromHex(line, bytes, sizeof(bytes), &size) ==
+                           safeheron::encode::hex::HexStatus::Ok;
+        const bool isPublicKey = isHex && size == 33 && (bytes[0] == 0x02 || bytes[0] == 0x03);
+        if (!isPublicKey && !(isHex && size == 20))
+            throw std::invalid_argument("[ERROR]: loadChildSearchTargets: line " + std::to_string(lineNumber) +
+                                        ": expected a compressed public key or a HASH160");
+
+        const std::string hex = safeheron::encode::hex::EncodeToHex(bytes, size);
+        bool inserted;
+        if (isPublicKey) {
+            std::array<uint8_t, 33> key;
+            std::copy(bytes, bytes + size, key.begin());
+            inserted = targets.publicKeys.emplace(key, targets.lines.size()).second;
+        }
+        else {
+            std::array<uint8_t, 20> key;
+            std::copy(bytes, bytes + size, key.begin());
+            inserted = targets.hashes.emplace(key, targets.lines.size()).second;
+        }
+        if (inserted)
+            targets.lines.push_back(hex);
+    }
+    return targets;
+}
+
+
+/**
+ * Searches child indices 0 .. options.range-1 of the path template under xpub for the targets.
+ *
+ * The node above "*" is derived once; workers then take chunks of child indices, derive the children
+ * (and the steps below "*") in groups, hash each group with one Hash160Batch call if HASH160 targets
+ * are present, and look the keys up in the target hash maps. The search ends early once every target
+ * has been found.
+ *
+ * @param xpub extended public key
+ * @param targets targets to look for
+ * @param options path template, range and thread count
+ * @return for every target (in targets.lines order) the lowest matching child index, -1 if not found
+ */
+std::vector<int64_t> searchChildren(const std::string &xpub, const ChildSearchTargets &targets, const ChildSearchOptions &options) {
+    using safeheron::hash::HASH160_OUTPUT_SIZE;
+    static btc_chainparams *chain = (btc_chainparams *)&btc_chainparams_main;
+
+    const PathTemplate steps = parsePathTemplate(options.pathTemplate);
+    const std::vector<uint32_t> &prefix = steps.prefix;
+    const std::vector<uint32_t> &suffix = steps.suffix;
+
+    EccContextPool::Lease ecc = EccContextPool::acquire();
+    btc_hdnode parent;
+    if (xpub.rfind("xpub", 0) != 0 || !btc_hdnode_deserialize(xpub.c_str(), chain, &parent))
+        throw std::invalid_argument("[ERROR]: searchChildren: invalid extended public key");
+    for (uint32_t step : prefix) {
+        if (!btc_hdnode_public_ckd(&parent, step))
+            throw std::runtime_error("[ERROR]: searchChildren: CKD operation failed");
+    }
+
+    std::vector<int64_t> found(targets.lines.size(), -1);
+    if (targets.lines.empty() || options.range == 0)
+        return found;
+
+    std::mutex foundMutex;
+    size_t foundCount = 0;
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> nextChunk(0);
+    const uint32_t chunks = (options.range - 1) / CHILD_SEARCH_CHUNK + 1;
+
+    auto report = [&](size_t target, uint32_t index) {
+        std::lock_guard<std::mutex> lock(foundMutex);
+        if (found[target] < 0) {
+            if (++foundCount == found.size())
+                done = true;
+        }
+        if (found[target] < 0 || found[target] > index)
+            found[target] = index;
+    };
+
+    auto work = [&]() {
+        EccContextPool::Lease workerEcc = EccContextPool::acquire();
+        uint8_t keys[CHILD_SEARCH_GROUP][33];
+        uint8_t hashes[CHILD_SEARCH_GROUP * HASH160_OUTPUT_SIZE];
+        uint32_t indices[CHILD_SEARCH_GROUP];
+
+        for (uint32_t chunk = nextChunk++; chunk < chunks && !done; chunk = nextChunk++) {
+            const uint32_t first = chunk * CHILD_SEARCH_CHUNK;
+            const uint32_t last = std::min<uint64_t>(options.range, uint64_t(first) + CHILD_SEARCH_CHUNK);
+
+            for (uint32_t group = first; group < last; group += CHILD_SEARCH_GROUP) {
+                size_t count = 0;
+                for (uint32_t index = group; index < std::min<uint64_t>(last, uint64_t(group) + CHILD_SEARCH_GROUP); index++) {
+                    btc_hdnode child = parent;
+                    // indices without a valid child are skipped, as BIP32 prescribes
+                    bool valid = btc_hdnode_public_ckd(&child, index);
+                    for (size_t s = 0; valid && s < suffix.size(); s++)
+                        valid = btc_hdnode_public_ckd(&child, suffix[s]);
+                    if (!valid)
+                        continue;
+                    memcpy(keys[count], child.public_key, sizeof(keys[count]));
+                    indices[count++] = index;
+                }
+
+                if (!targets.publicKeys.empty()) {
+                    std::array<uint8_t, 33> key;
+                    for (size_t i = 0; i < count; i++) {
+                        std::copy(keys[i], keys[i] + 33, key.begin());
+                        auto match = targets.publicKeys.find(key);
+                        if (match != targets.publicKeys.end())
+                            report(match->second, indices[i]);
+                    }
+                }
+                if (!targets.hashes.empty()) {
+                    safeheron::hash::Hash160Batch(hashes, keys[0], 33, count);
+                    std::array<uint8_t, 20> hash;
+                    for (size_t i = 0; i < count; i++) {
+                        std::copy(hashes + HASH160_OUTPUT_SIZE * i, hashes + HASH160_OUTPUT_SIZE * (i + 1), hash.begin());
+                        auto match = targets.hashes.find(hash);
+                        if (match != targets.hashes.end())
+                            report(match->second, indices[i]);
+                    }
+                }
+            }
+        }
+    };
+
+    unsigned threads = options.threads == 0 ? std::thread::hardware_concurrency() : options.threads;
+    threads = std::max(1u, std::min<unsigned>(threads, chunks));
+    if (threads == 1) {
+        work();
+    }
+    else {
+        std::vector<std::thread> workers;
+        for (unsigned i = 0; i < threads; i++)
+            workers.emplace_back(work);
+        for (auto &thread : workers)
+            thread.join();
+    }
+    return found;
+}
+
+
+/**
+ * Replaces the "*" step of a path template with a child index
+ * @param pathTemplate path with exactly one "*" step
+ * @param index child index
+ * @return the derivation path of the child
+ */
+static std::string expandPathTemplate(const std::string &pathTemplate, int64_t index) {
+    std::string path = pathTemplate;
+    path.replace(path.find('*'), 1, std::to_string(index));
+    return path;
+}
+
+
+/**
+ * Loads the targets file, searches the children of xpub and prints every target that was found,
+ * in targets file order, as "target:path" lines or NDJSON records (target, index, path)
+ * @param xpub extended public key
+ * @param targetsFile path of the targets file
+ * @param options search and output options
+ */
+void runChildSearch(const std::string &xpub, const std::string &targetsFile, const ChildSearchOptions &options) {
+    std::ifstream in(targetsFile);
+    if (!in)
+        throw std::invalid_argument("[ERROR]: runChildSearch: cannot open targets file " + targetsFile);
+    const ChildSearchTargets targets = loadChildSearchTargets(in);
+    const std::vector<int64_t> found = searchChildren(xpub, targets, options);
+
+    JsonWriter json;
+    for (size_t i = 0; i < found.size(); i++) {
+        if (found[i] < 0)
+            continue;
+        const std::string path = expandPathTemplate(options.pathTemplate, found[i]);
+        if (options.format == OutputFormat::Ndjson) {
+            json.beginObject()
+                .stringField("target", targets.lines[i])
+                .numberField("index", static_cast<uint64_t>(found[i]))
+                .stringField("path", path)
+                .endObject();
+            if (json.str().size() >= JsonWriter::DEFAULT_CAPACITY / 2)
+                json.flush(std::cout);
+        }
+        else {
+            std::cout << targets.lines[i] << ":" << path << "\n";
+        }
+    }
+    json.flush(std::cout);
+    std::cout.flush();
+}
@@ -0,0 +1,57 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file ChildSearch.h
+ * @brief Reverse lookup of the child index that produced a public key under an xpub
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../Utility/CommandLimits.h"
+#include "../Utility/OutputFormat.h"
+
+/**
+ * Hash of fixed-size target keys. Public keys and HASH160s are uniformly distributed, so their
+ * last 8 bytes (past the public key prefix byte) are used directly.
+ */
+struct TargetKeyHash {
+    template<size_t N>
+    size_t operator()(const std::array<uint8_t, N> &key) const {
+        uint64_t value;
+        memcpy(&value, key.data() + N - sizeof(value), sizeof(value));
+        return static_cast<size_t>(value);
+    }
+};
+
+/**
+ * Keys searched for, each mapped to its position in the targets file
+ */
+struct ChildSearchTargets {
+    std::vector<std::string> lines;  // distinct targets in file order, lowercase hex
+    std::unordered_map<std::array<uint8_t, 33>, size_t, TargetKeyHash> publicKeys;  // compressed public key -> lines index
+    std::unordered_map<std::array<uint8_t, 20>, size_t, TargetKeyHash> hashes;  // HASH160 of a public key -> lines index
+};
+
+/**
+ * Search options of find-child
+ */
+struct ChildSearchOptions {
+    std::string pathTemplate = "*";  // path below the xpub, exactly one step is "*"
+    uint32_t range = DEFAULT_CHILD_SEARCH_RANGE;  // child indices 0 .. range-1 are searched
+    unsigned threads = 0;  // number of worker threads, 0 = one per hardware thread
+    OutputFormat format = OutputFormat::Text;  // "target:path" lines or NDJSON
+};
+
+ChildSearchTargets loadChildSearchTargets(std::istream &in);
+std::vector<int64_t> searchChildren(const std::string &xpub, const ChildSearchTargets &targets, const ChildSearchOptions &options);
+void runChildSearch(const std::string &xpub, const std::string &targetsFile, const ChildSearchOptions &options);
@@ -9,6 +9,17 @@
  */
 
 #include "DeriveKey.h"
+#include "Mnemonic.h"
+#include "ExtendedKey.h"
+#include "NodeCache.h"
+#include "../Utility/Address.h"
+#include "../Utility/EccContextPool.h"
+#include "../Utility/JsonWriter.h"
+#include "../Utility/SecureArena.h"
+#include "../Utility/SeedHex.h"
+#include "../ArgParser/crypto-hash/common.h"
+#include "../ArgParser/crypto-hash/hash160.h"
+#include "../ArgParser/crypto-hash/ripemd160.h"
 
 #include <iostream>
 #include <sstream>
@@ -18,6 +29,10 @@
 #include <cctype>
 #include <stdexcept>
 #include <limits>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
 
 extern "C"
 {
@@ -30,34 +45,11 @@ extern "C"
 
 static btc_chainparams *chain = (btc_chainparams *)&btc_chainparams_main;
 
-/**
- * @brief Removes all whitespace characters from a string.
- * @param input The input string.
- * @return A new string with all whitespace removed.
- */
-static std::string removeWhitespace(const std::string &input)
-{
-    std::string result;
-    for (char c : input)
-    {
-        if (!isspace(static_cast<unsigned char>(c)))
-        {
-            result += c;
-        }
-    }
-    return result;
-}
+/** Number of inputs derived in parallel before their results are printed. */
+static const size_t DERIVE_BATCH_SIZE = 1024;
 
-/**
- * @brief Checks if a string is a valid hexadecimal string.
- * @param s The input string.
- * @return True if the string is hex, false otherwise.
- */
-static bool isHex(const std::string &s)
-{
-    return all_of(s.begin(), s.end(), [](char c)
-                  { return isxdigit(static_cast<unsigned char>(c)); });
-}
+/** Number of consecutive inputs derived together by one worker; their key origins are hashed in one multi-buffer HASH160 call. */
+static const size_t DERIVE_GROUP_SIZE = safeheron::hash::RIPEMD160_LANES;
 
 /**
  * @brief Checks if a string is an extended key (xpub or xprv).
@@ -80,18 +72,18 @@ static bool isXPrv(const std::string &s)
 }
 
 /**
- * @brief Derives a BIP32 path on a given HD node.
- * @param node Pointer to the HD node.
+ * @brief Parses a BIP32 derivation path.
  * @param path Derivation path string (e.g., "0/1h/2'").
- * @param priv Whether to derive with private (true) or public (false) key.
+ * @return The child numbers, hardened ones with the 0x80000000 bit set.
  */
-static void derivePath(btc_hdnode *node, const std::string &path, bool priv)
+static std::vector<uint32_t> parsePath(const std::string &path)
 {
     if (!path.empty() && path.back() == '/')
     {
         throw std::invalid_argument("[ERROR]: derivePath: trailing slash not allowed");
     }
 
+    std::vector<uint32_t> steps;
     std::istringstream ss(path);
     std::string segment;
 
@@ -134,127 +126,666 @@ static void derivePath(btc_hdnode *node, const std::string &path, bool priv)
             throw std::invalid_argument("[ERROR]: derivePath: derivation index out of range");
         }
 
-        if (hardened)
+        steps.push_back(hardened ? (uint32_t)index + 0x80000000 : (uint32_t)index);
+    }
+    return steps;
+}
+
+/**
+ * @brief Derives a BIP32 path on a given HD node.
+ *
+ * With a node cache, the node after the last hardened step is looked up before any CKD is done
+ * and stored after it was derived; the non-hardened steps below it are always derived. A cached
+ * node without its private key (--cache-no-private) is only used when the private key is not
+ * needed, and the remaining steps are then derived publicly.
+ *
+ * @param node Pointer to the HD node.
+ * @param path Derivation path string (e.g., "0/1h/2'").
+ * @param priv Whether to derive with private (true) or public (false) key.
+ * @param cache Node cache, nullptr if not used.
+ * @param needPrivate Whether the derived node must keep its private key.
+ * @return Whether the derived node carries its private key.
+ */
+static bool derivePath(btc_hdnode *node, const std::string &path, bool priv, NodeCache *cache, bool needPrivate)
+{
+    const std::vector<uint32_t> steps = parsePath(path);
+
+    size_t cachedSteps = 0;
+    for (size_t i = 0; i < steps.size(); i++)
+    {
+        if (steps[i] >= 0x80000000)
+            cachedSteps = i + 1;
+    }
+    const bool useCache = cache != nullptr && priv && cachedSteps > 0;
+
+    NodeCache::Key key;
+    size_t start = 0;
+    bool hasPrv = priv;
+    if (useCache)
+    {
+        key = NodeCache::makeKey(*node, steps.data(), cachedSteps);
+        btc_hdnode cached;
+        bool cachedPrv = false;
+        if (cache->lookup(key, &cached, &cachedPrv) && (cachedPrv || !needPrivate))
         {
-            index += 0x80000000;
+            *node = cached;
+            start = cachedSteps;
+            hasPrv = cachedPrv;
         }
+        SecureArena::wipe(&cached, sizeof(cached));
+    }
 
-        bool result = priv ? btc_hdnode_private_ckd(node, index)
-                           : btc_hdnode_public_ckd(node, index);
+    for (size_t i = start; i < steps.size(); i++)
+    {
+        const uint32_t index = steps[i];
+        bool result = hasPrv ? btc_hdnode_private_ckd(node, index)
+                             : btc_hdnode_public_ckd(node, index);
 
         if (!result)
         {
-            if (!priv && index >= 0x80000000)
+            if (!hasPrv && index >= 0x80000000)
                 throw std::invalid_argument("[ERROR]: derivePath: cannot derive hardened key from xpub");
             throw std::runtime_error("[ERROR]: derivePath: CKD operation failed");
         }
+
+        if (useCache && start == 0 && i + 1 == cachedSteps)
+        {
+            cache->insert(key, *node, true);
+        }
     }
+    return hasPrv;
 }
 
 /**
- * @brief Handles a hex seed input, performs derivation and prints xpub:xprv.
- * @param seedStr The hex seed string.
- * @param path The derivation path.
+ * @brief A derived HD node together with the knowledge whether it carries a private key.
+ */
+struct DerivedNode
+{
+    btc_hdnode node;
+    bool hasPrv;
+    uint8_t rootPublicKey[BTC_ECKEY_COMPRESSED_LENGTH]; // public key the path was derived from
+};
+
+/**
+ * @brief BIP380 key origin of a derived key: fingerprint of the root key and the path from it.
+ */
+struct KeyOrigin
+{
+    char fingerprint[9];
+    std::string path;
+};
+
+/**
+ * @brief Writes a key origin in the key expression form "[fingerprint/path]".
+ * @param origin The key origin.
+ * @return "[fingerprint/path]", or "[fingerprint]" for an empty path.
+ */
+static std::string formatOrigin(const KeyOrigin &origin)
+{
+    std::string result = "[";
+    result += origin.fingerprint;
+    if (!origin.path.empty())
+    {
+        result += "/";
+        result += origin.path;
+    }
+    result += "]";
+    return result;
+}
+
+/**
+ * @brief Rewrites a derivation path with 'h' as the only hardened marker, as used in key origins.
+ * @param path Derivation path string (e.g., "0/1H/2'").
+ * @return The same path with "H" and "'" replaced by "h".
  */
-static void handleSeed(const std::string &seedStr, const std::string &path)
+static std::string normalizeOriginPath(const std::string &path)
 {
-    std::string clean = removeWhitespace(seedStr);
+    std::string result = path;
+    std::replace(result.begin(), result.end(), 'H', 'h');
+    std::replace(result.begin(), result.end(), '\'', 'h');
+    return result;
+}
 
-    if (!isHex(clean))
+/**
+ * @brief Serializes a node into a fixed-size binary record (layout in DeriveKey.h).
+ *
+ * The private key is left zeroed when the node has none or --public-only was requested.
+ *
+ * @param derived The derived node.
+ * @param index Input line index.
+ * @param options Output options.
+ * @return The BINARY_RECORD_SIZE byte record.
+ */
+static std::string formatBinaryRecord(const DerivedNode &derived, uint32_t index, const DeriveKeyOptions &options)
+{
+    const btc_hdnode &node = derived.node;
+    const bool withPrv = derived.hasPrv && !options.publicOnly;
+
+    unsigned char record[BINARY_RECORD_SIZE] = {0};
+    WriteLE32(record + 0, index);
+    record[4] = (unsigned char)node.depth;
+    record[5] = withPrv ? BINARY_RECORD_HAS_PRIVATE_KEY : 0;
+    WriteBE32(record + 8, node.fingerprint);
+    WriteBE32(record + 12, node.child_num);
+    memcpy(record + 16, node.chain_code, BTC_BIP32_CHAINCODE_SIZE);
+    memcpy(record + 48, node.public_key, BTC_ECKEY_COMPRESSED_LENGTH);
+    if (withPrv)
     {
-        throw std::invalid_argument("[ERROR]: handleSeed: invalid characters in seed");
+        memcpy(record + 81, node.private_key, BTC_ECKEY_PKEY_LENGTH);
     }
-    if (clean.length() % 2 != 0 || clean.length() < 32 || clean.length() > 128)
+
+    std::string output(reinterpret_cast<const char *>(record), sizeof(record));
+    SecureArena::wipe(record, sizeof(record));
+    return output;
+}
+
+/**
+ * @brief Serializes a node into one NDJSON record.
+ *
+ * Keys that are not printed (no private key, --public-only, --private-only) are null.
+ * With --origin the key origin is added as an object with fingerprint and path.
+ *
+ * @param derived The derived node.
+ * @param index Input line index.
+ * @param options Output options.
+ * @param origin Key origin, nullptr if not requested.
+ * @param arena Secure arena the serialized xprv is built in.
+ * @return The JSON record, newline terminated.
+ */
+static std::string formatJsonRecord(const DerivedNode &derived, uint32_t index, const DeriveKeyOptions &options, const KeyOrigin *origin,
+                                    SecureArena &arena)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    thread_local JsonWriter json;
+
+    char fingerprint[9];
+    for (int i = 0; i < 8; i++)
+    {
+        fingerprint[i] = hexDigits[(derived.node.fingerprint >> (28 - 4 * i)) & 0xf];
+    }
+    fingerprint[8] = '\0';
+
+    // the buffer must not grow (and leave a copy behind) once the xprv is in it
+    json.clear();
+    json.reserve(JsonWriter::DEFAULT_CAPACITY + (origin != nullptr ? origin->path.size() : 0));
+    json.beginObject().numberField("index", index);
+    if (!options.privateOnly)
+    {
+        char xpub[EXTENDED_KEY_BUFFER_SIZE];
+        serializeExtendedKey(&derived.node, chain, false, xpub);
+        json.stringField("xpub", xpub);
+    }
+    else
     {
-        throw std::invalid_argument("[ERROR]: handleSeed: seed length out of range");
+        json.nullField("xpub");
     }
+    if (derived.hasPrv && !options.publicOnly)
+    {
+        char *xprv = arena.allocateChars(EXTENDED_KEY_BUFFER_SIZE);
+        serializeExtendedKey(&derived.node, chain, true, xprv);
+        json.stringField("xprv", xprv);
+    }
+    else
+    {
+        json.nullField("xprv");
+    }
+    json.numberField("depth", derived.node.depth)
+        .numberField("child", derived.node.child_num)
+        .stringField("fingerprint", fingerprint);
+    if (origin != nullptr)
+    {
+        json.beginObject("origin")
+            .stringField("fingerprint", origin->fingerprint)
+            .stringField("path", origin->path)
+            .endObject();
+    }
+    json.endObject();
 
-    size_t byteLen = clean.length() / 2;
-    std::vector<uint8_t> seed(byteLen);
-    int outLen = 0;
+    // the copy is wiped by deriveInOrder once printed, clear() wipes the writer's buffer
+    std::string record = json.str();
+    json.clear();
+    return record;
+}
 
-    utils_hex_to_bin(clean.c_str(), seed.data(), clean.length(), &outLen);
-    if (outLen != (int)byteLen)
+/**
+ * @brief Formats a derived node in the requested output format.
+ *
+ * In text mode only the keys selected by the options are serialized, so --public-only and
+ * --private-only skip the other key's serialization and Base58Check encoding entirely.
+ * The binary format skips Base58 encoding altogether. With a key origin every printed key
+ * is written as a key expression "[fingerprint/path]key".
+ *
+ * @param derived The derived node.
+ * @param index Input line index.
+ * @param options Output options.
+ * @param origin Key origin, nullptr if not requested.
+ * @param arena Secure arena the serialized xprv is built in.
+ * @return The output record: "xpub:xprv\n", "xpub\n", "xprv\n", a binary record or a JSON line.
+ */
+static std::string formatNode(const DerivedNode &derived, uint32_t index, const DeriveKeyOptions &options, const KeyOrigin *origin,
+                              SecureArena &arena)
+{
+    if (options.privateOnly && !derived.hasPrv)
     {
-        throw std::invalid_argument("[ERROR]: handleSeed: hex decode mismatch");
+        throw std::invalid_argument("[ERROR]: formatNode: private key not available for xpub input");
     }
 
-    btc_hdnode node;
-    if (!btc_hdnode_from_seed(seed.data(), seed.size(), &node))
+    if (options.format == OutputFormat::Binary)
+    {
+        return formatBinaryRecord(derived, index, options);
+    }
+    if (options.format == OutputFormat::Ndjson)
+    {
+        return formatJsonRecord(derived, index, options, origin, arena);
+    }
+
+    // Reserved up front so that appending never reallocates and leaves a copy of the xprv in freed
+    // memory; the record itself is wiped by deriveInOrder once it is printed.
+    const std::string prefix = origin != nullptr ? formatOrigin(*origin) : std::string();
+    std::string line;
+    line.reserve(2 * (prefix.size() + EXTENDED_KEY_BUFFER_SIZE) + 2);
+    if (!options.privateOnly)
+    {
+        char xpub[EXTENDED_KEY_BUFFER_SIZE];
+        serializeExtendedKey(&derived.node, chain, false, xpub);
+        line += prefix;
+        line += xpub;
+    }
+    if (derived.hasPrv && !options.publicOnly)
+    {
+        char *xprv = arena.allocateChars(EXTENDED_KEY_BUFFER_SIZE);
+        serializeExtendedKey(&derived.node, chain, true, xprv);
+        if (!line.empty())
+            line += ":";
+        line += prefix;
+        line += xprv;
+    }
+    line += "\n";
+    return line;
+}
+
+/**
+ * @brief Derives from raw seed bytes.
+ * @param seed Pointer to the seed bytes.
+ * @param seedLen Length of the seed in bytes.
+ * @param path The derivation path.
+ * @param cache Node cache, nullptr if not used.
+ * @param needPrivate Whether the private key is printed.
+ * @return The derived node.
+ */
+static DerivedNode handleSeedBytes(const uint8_t *seed, size_t seedLen, const std::string &path, NodeCache *cache, bool needPrivate)
+{
+    DerivedNode derived;
+    derived.hasPrv = true;
+    if (!btc_hdnode_from_seed(seed, seedLen, &derived.node))
     {
         throw std::runtime_error("[ERROR]: handleSeed: failed to create node from seed");
     }
+    memcpy(derived.rootPublicKey, derived.node.public_key, BTC_ECKEY_COMPRESSED_LENGTH);
 
     if (!path.empty())
     {
-        derivePath(&node, path, true);
+        derived.hasPrv = derivePath(&derived.node, path, true, cache, needPrivate);
     }
 
-    char xpub[112], xprv[112];
-    btc_hdnode_serialize_public(&node, chain, xpub, sizeof(xpub));
-    btc_hdnode_serialize_private(&node, chain, xprv, sizeof(xprv));
+    return derived;
+}
 
-    std::cout << xpub << ":" << xprv << std::endl;
+/**
+ * @brief Handles a hex seed input and performs derivation.
+ *
+ * The seed is validated and decoded in one pass by decodeSeedHex, straight into the secure
+ * arena, which the caller wipes once the group is printed. Whitespace is skipped wherever it
+ * occurs; the stricter argument grammar is enforced by ArgParser.
+ *
+ * @param seedStr The hex seed string.
+ * @param arena Secure arena for the seed bytes.
+ * @param path The derivation path.
+ * @param cache Node cache, nullptr if not used.
+ * @param needPrivate Whether the private key is printed.
+ * @return The derived node.
+ */
+static DerivedNode handleSeed(const std::string &seedStr, SecureArena &arena, const std::string &path, NodeCache *cache, bool needPrivate)
+{
+    uint8_t *seed = arena.allocateBytes(SEED_MAX_BYTES);
+    const SeedHexResult result = decodeSeedHex(seedStr.data(), seedStr.size(), seed, SeedHexSyntax::Lenient);
+    if (result.status != SeedHexStatus::Ok)
+    {
+        throw std::invalid_argument("[ERROR]: handleSeed: " + seedHexErrorMessage(result));
+    }
+
+    return handleSeedBytes(seed, result.size, path, cache, needPrivate);
 }
 
 /**
- * @brief Handles an extended key (xpub/xprv), performs derivation and prints output.
+ * @brief Handles an extended key (xpub/xprv) and performs derivation.
  * @param key The extended key.
  * @param path The derivation path.
+ * @param cache Node cache, nullptr if not used.
+ * @param needPrivate Whether the private key is printed.
+ * @return The derived node.
  */
-static void handleXKey(const std::string &key, const std::string &path)
+static DerivedNode handleXKey(const std::string &key, const std::string &path, NodeCache *cache, bool needPrivate)
 {
-    btc_hdnode node;
-    if (!btc_hdnode_deserialize(key.c_str(), chain, &node))
+    DerivedNode derived;
+    if (!btc_hdnode_deserialize(key.c_str(), chain, &derived.node))
     {
         throw std::invalid_argument("[ERROR]: handleXKey: invalid extended key");
     }
 
-    bool hasPrv = isXPrv(key);
+    derived.hasPrv = isXPrv(key);
+    memcpy(derived.rootPublicKey, derived.node.public_key, BTC_ECKEY_COMPRESSED_LENGTH);
     if (!path.empty())
     {
-        derivePath(&node, path, hasPrv);
+        derived.hasPrv = derivePath(&derived.node, path, derived.hasPrv, cache, needPrivate);
     }
 
-    char xpub[112];
-    btc_hdnode_serialize_public(&node, chain, xpub, sizeof(xpub));
-    std::cout << xpub;
-    if (hasPrv)
+    return derived;
+}
+
+/**
+ * @brief Tells whether the output contains private keys.
+ * @param options Output options.
+ * @return False for --public-only and address output, where cached public-only nodes suffice.
+ */
+static bool needsPrivateKey(const DeriveKeyOptions &options)
+{
+    return !options.publicOnly && options.format != OutputFormat::Address;
+}
+
+/**
+ * @brief Resolves the requested worker count (0 = one per hardware thread).
+ * @param threads Requested number of threads.
+ * @return Number of workers to use, at least 1.
+ */
+static unsigned resolveThreadCount(unsigned threads)
+{
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    return std::max(1u, threads);
+}
+
+/**
+ * @brief Derives and formats the inputs [first, last), at most DERIVE_GROUP_SIZE of them.
+ *
+ * With --origin the root public keys of the group go through one Hash160Batch call, and with
+ * --format=address the derived public keys are turned into P2PKH addresses in one
+ * encodeAddressBatch call.
+ *
+ * @param first Index of the first input.
+ * @param last Index past the last input.
+ * @param lineIndices Input line index of every input.
+ * @param originPath Derivation path as written in the key origin.
+ * @param options Output options.
+ * @param produce Derives the input with the given index.
+ * @param arena The worker's secure arena, used by produce and formatNode.
+ * @param outputs Output record slots, outputs[0] belongs to input first.
+ * @param errors Error message slots, errors[0] belongs to input first.
+ */
+static void deriveGroup(size_t first, size_t last, const std::vector<uint32_t> &lineIndices, const std::string &originPath,
+                        const DeriveKeyOptions &options, const std::function<DerivedNode(size_t, SecureArena &)> &produce,
+                        SecureArena &arena, std::string *outputs, std::string *errors)
+{
+    using safeheron::hash::HASH160_OUTPUT_SIZE;
+    static const char hexDigits[] = "0123456789abcdef";
+
+    DerivedNode nodes[DERIVE_GROUP_SIZE];
+    bool derived[DERIVE_GROUP_SIZE] = {false};
+    for (size_t i = first; i < last; i++)
     {
-        char xprv[112];
-        btc_hdnode_serialize_private(&node, chain, xprv, sizeof(xprv));
-        std::cout << ":" << xprv;
+        try
+        {
+            nodes[i - first] = produce(i, arena);
+            derived[i - first] = true;
+        }
+        catch (const std::exception &e)
+        {
+            errors[i - first] = e.what();
+        }
+    }
+
+    if (options.format == OutputFormat::Address)
+    {
+        // The derived public keys of the group are hashed and encoded in one batch.
+        uint8_t keys[DERIVE_GROUP_SIZE * BTC_ECKEY_COMPRESSED_LENGTH] = {0};
+        char addresses[DERIVE_GROUP_SIZE * ADDRESS_BUFFER_SIZE];
+        size_t keyCount = 0;
+        for (size_t i = 0; i < last - first; i++)
+        {
+            if (derived[i])
+                memcpy(keys + BTC_ECKEY_COMPRESSED_LENGTH * keyCount++, nodes[i].node.public_key, BTC_ECKEY_COMPRESSED_LENGTH);
+        }
+        encodeAddressBatch(P2PKH_ADDRESS_VERSION, keys, BTC_ECKEY_COMPRESSED_LENGTH, keyCount, addresses);
+
+        size_t addressIndex = 0;
+        for (size_t i = 0; i < last - first; i++)
+        {
+            if (derived[i])
+                outputs[i] = std::string(addresses + ADDRESS_BUFFER_SIZE * addressIndex++) + "\n";
+        }
+        SecureArena::wipe(nodes, sizeof(nodes));
+        return;
+    }
+
+    KeyOrigin origins[DERIVE_GROUP_SIZE];
+    if (options.origin)
+    {
+        uint8_t roots[DERIVE_GROUP_SIZE * BTC_ECKEY_COMPRESSED_LENGTH];
+        uint8_t hashes[DERIVE_GROUP_SIZE * HASH160_OUTPUT_SIZE];
+        size_t rootCount = 0;
+        for (size_t i = 0; i < last - first; i++)
+        {
+            if (derived[i])
+                memcpy(roots + BTC_ECKEY_COMPRESSED_LENGTH * rootCount++, nodes[i].rootPublicKey, BTC_ECKEY_COMPRESSED_LENGTH);
+        }
+        safeheron::hash::Hash160Batch(hashes, roots, BTC_ECKEY_COMPRESSED_LENGTH, rootCount);
+
+        size_t hashIndex = 0;
+        for (size_t i = 0; i < last - first; i++)
+        {
+            if (!derived[i])
+                continue;
+            const uint8_t *hash = hashes + HASH160_OUTPUT_SIZE * hashIndex++;
+            for (int j = 0; j < 4; j++)
+            {
+                origins[i].fingerprint[2 * j] = hexDigits[hash[j] >> 4];
+                origins[i].fingerprint[2 * j + 1] = hexDigits[hash[j] & 0xf];
+            }
+            origins[i].fingerprint[8] = '\0';
+            origins[i].path = originPath;
+        }
+    }
+
+    for (size_t i = first; i < last; i++)
+    {
+        if (!derived[i - first])
+            continue;
+        try
+        {
+            outputs[i - first] = formatNode(nodes[i - first], lineIndices[i], options, options.origin ? &origins[i - first] : nullptr,
+                                            arena);
+        }
+        catch (const std::exception &e)
+        {
+            errors[i - first] = e.what();
+        }
     }
-    std::cout << std::endl;
+    SecureArena::wipe(nodes, sizeof(nodes));
 }
 
 /**
- * @brief Main function for deriving keys from inputs.
- * @param values List of input strings (seeds or extended keys).
- * @param filepath Derivation path string.
+ * @brief Derives every input on a pool of worker threads and prints the results in input order.
+ *
+ * Inputs are processed in batches, which are split into groups of DERIVE_GROUP_SIZE consecutive
+ * inputs; the workers of a batch each hold an ECC context lease and fill only the result slots of
+ * their own groups, and the batch is printed by the calling thread once all of them have finished.
+ * Output stops at the first failing input: everything before it is printed, then its error is
+ * reported and the process exits. With a single thread every group is printed as soon as it is
+ * derived.
+ *
+ * Every worker owns one SecureArena for the whole run; the seed and xprv buffers of a group are
+ * bump-allocated from it and wiped in bulk once the group is formatted, and printed records are
+ * wiped before their slots are reused.
+ *
+ * @param lineIndices Input line index of every input.
+ * @param path The derivation path.
+ * @param options Output options and thread count.
+ * @param produce Derives the input with the given index.
  */
-void deriveKey(const std::vector<std::string> &values, const std::string &filepath)
+static void deriveInOrder(const std::vector<uint32_t> &lineIndices, const std::string &path, const DeriveKeyOptions &options,
+                          const std::function<DerivedNode(size_t, SecureArena &)> &produce)
 {
-    for (const auto &val : values)
+    const size_t count = lineIndices.size();
+    const unsigned threads = resolveThreadCount(options.threads);
+    const size_t batchSize = threads > 1 ? DERIVE_BATCH_SIZE : DERIVE_GROUP_SIZE;
+    const std::string originPath = normalizeOriginPath(path);
+    std::vector<std::string> outputs;
+    std::vector<std::string> errors;
+
+    // one arena per worker of the largest batch
+    const size_t maxGroups = (std::min(count, batchSize) + DERIVE_GROUP_SIZE - 1) / DERIVE_GROUP_SIZE;
+    std::vector<std::unique_ptr<SecureArena>> arenas;
+    for (size_t worker = 0; worker < std::min<size_t>(threads, maxGroups); worker++)
+        arenas.emplace_back(new SecureArena());
+
+    for (size_t begin = 0; begin < count; begin += batchSize)
     {
-        if (val.empty())
-            continue;
+        const size_t end = std::min(count, begin + batchSize);
+        const size_t groups = (end - begin + DERIVE_GROUP_SIZE - 1) / DERIVE_GROUP_SIZE;
+        outputs.assign(end - begin, std::string());
+        errors.assign(end - begin, std::string());
 
-        try
+        auto work = [&](size_t worker, size_t workers)
+        {
+            EccContextPool::Lease ecc = EccContextPool::acquire();
+            for (size_t group = worker; group < groups; group += workers)
+            {
+                const size_t first = begin + group * DERIVE_GROUP_SIZE;
+                const size_t last = std::min(end, first + DERIVE_GROUP_SIZE);
+                deriveGroup(first, last, lineIndices, originPath, options, produce, *arenas[worker],
+                            &outputs[first - begin], &errors[first - begin]);
+                arenas[worker]->reset();
+            }
+        };
+
+        const size_t workerCount = std::min<size_t>(threads, groups);
+        if (workerCount <= 1)
+        {
+            work(0, 1);
+        }
+        else
         {
-            if (isXKey(val))
+            std::vector<std::thread> workers;
+            for (size_t worker = 0; worker < workerCount; worker++)
+                workers.emplace_back(work, worker, workerCount);
+            for (auto &thread : workers)
+                thread.join();
+        }
+
+        for (size_t i = 0; i < end - begin; i++)
+        {
+            if (!errors[i].empty())
             {
-                handleXKey(val, filepath);
+                std::cout.flush();
+                std::cerr << errors[i] << std::endl;
+                exit(1);
             }
-            else
+            std::cout.write(outputs[i].data(), outputs[i].size());
+            SecureArena::wipe(&outputs[i][0], outputs[i].size());
+        }
+        std::cout.flush();
+    }
+}
+
+/**
+ * @brief Handles BIP39 mnemonic inputs: converts them to seeds and prints xpub:xprv for each.
+ *
+ * Inputs are validated in order; the seeds of all mnemonics preceding the first invalid one
+ * are computed in one batch, derived and printed, and then the error is reported.
+ *
+ * @param values The mnemonic sentences.
+ * @param path The derivation path.
+ * @param options Derivation options (passphrase, thread count, output selection).
+ * @param cache Node cache, nullptr if not used.
+ */
+static void handleMnemonics(const std::vector<std::string> &values, const std::string &path, const DeriveKeyOptions &options, NodeCache *cache)
+{
+    std::vector<std::string> mnemonics;
+    std::vector<uint32_t> lineIndices;
+    std::string error;
+
+    try
+    {
+        validatePassphrase(options.passphrase);
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            if (!values[i].empty())
             {
-                handleSeed(val, filepath);
+                mnemonics.push_back(normalizeMnemonic(values[i]));
+                lineIndices.push_back((uint32_t)i);
             }
         }
+    }
+    catch (const std::exception &e)
+    {
+        error = e.what();
+    }
+
+    auto seeds = mnemonicsToSeeds(mnemonics, options.passphrase, options.threads);
+    deriveInOrder(lineIndices, path, options, [&](size_t i, SecureArena &)
+                  { return handleSeedBytes(seeds[i].data(), seeds[i].size(), path, cache, needsPrivateKey(options)); });
+    for (auto &seed : seeds)
+        SecureArena::wipe(seed.data(), seed.size());
+    for (auto &mnemonic : mnemonics)
+        SecureArena::wipe(&mnemonic[0], mnemonic.size());
+
+    if (!error.empty())
+    {
+        std::cerr << error << std::endl;
+        exit(1);
+    }
+}
+
+/**
+ * @brief Main function for deriving keys from inputs.
+ * @param values List of input strings (seeds, extended keys or mnemonics).
+ * @param filepath Derivation path string.
+ * @param options Input interpretation and output options.
+ */
+void deriveKey(const std::vector<std::string> &values, const std::string &filepath, const DeriveKeyOptions &options)
+{
+    EccContextPool::Lease ecc = EccContextPool::acquire();
+
+    std::unique_ptr<NodeCache> cache;
+    if (!options.cacheFile.empty())
+    {
+        try
+        {
+            cache.reset(new NodeCache(options.cacheFile, options.cachePrivateKeys));
+        }
         catch (const std::exception &e)
         {
             std::cerr << e.what() << std::endl;
             exit(1);
         }
     }
+
+    if (options.mnemonic)
+    {
+        handleMnemonics(values, filepath, options, cache.get());
+        return;
+    }
+
+    std::vector<uint32_t> lineIndices;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        if (!values[i].empty())
+            lineIndices.push_back((uint32_t)i);
+    }
+
+    deriveInOrder(lineIndices, filepath, options, [&](size_t i, SecureArena &arena)
+                  {
+                      const std::string &val = values[lineIndices[i]];
+                      return isXKey(val) ? handleXKey(val, filepath, cache.get(), needsPrivateKey(options))
+                                         : handleSeed(val, arena, filepath, cache.get(), needsPrivateKey(options)); });
 }
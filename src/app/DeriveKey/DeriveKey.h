@@ -10,18 +10,70 @@
 #ifndef DERIVE_KEY_H
 #define DERIVE_KEY_H
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
+#include "../Utility/CommandLimits.h"
+#include "../Utility/OutputFormat.h"
+
+/**
+ * Layout of one --format=bin record of BINARY_RECORD_SIZE bytes. Each record describes one input line:
+ *
+ *   offset  size  field
+ *        0     4  input line index (little-endian)
+ *        4     1  depth
+ *        5     1  flags (BINARY_RECORD_HAS_PRIVATE_KEY)
+ *        6     2  reserved, zero
+ *        8     4  parent fingerprint (big-endian, as in BIP32 serialization)
+ *       12     4  child number (big-endian, as in BIP32 serialization)
+ *       16    32  chain code
+ *       48    33  compressed public key
+ *       81    32  private key, zero if not present
+ *      113    15  padding, zero
+ */
+static_assert(BINARY_RECORD_SIZE == 128, "the binary record layout is 128 bytes");
+
+/** Record flag: the private key field is filled. */
+const unsigned char BINARY_RECORD_HAS_PRIVATE_KEY = 0x01;
+
+/**
+ * @brief Options controlling how derive-key interprets its inputs and what it prints.
+ */
+struct DeriveKeyOptions
+{
+    bool mnemonic = false;    // inputs are BIP39 mnemonic sentences instead of hex seeds / extended keys
+    std::string passphrase;   // BIP39 passphrase, only used with mnemonic inputs
+    unsigned threads = 0;     // number of worker threads, 0 = one per hardware thread
+    bool publicOnly = false;  // print only the xpub of each result
+    bool privateOnly = false; // print only the xprv of each result (xpub inputs are rejected)
+    OutputFormat format = OutputFormat::Text; // text lines, BINARY_RECORD_SIZE records, NDJSON or P2PKH addresses
+    bool origin = false;      // prefix keys with their BIP380 key origin [fingerprint/path] (not with binary output)
+    std::string cacheFile;    // persistent node cache (see NodeCache.h), empty = no cache
+    bool cachePrivateKeys = true; // write private keys of cached nodes to the cache file
+};
+
 /**
  * @brief Derives BIP32 keys from seeds or extended keys.
  *
  * This function processes a list of inputs (hex seeds or extended keys), applies
- * optional BIP32 path derivation, and prints the resulting xpub:xprv or xpub only.
+ * optional BIP32 path derivation, and prints the resulting xpub:xprv or xpub only
+ * (or just one of the keys, see DeriveKeyOptions::publicOnly / privateOnly). With
+ * OutputFormat::Ndjson every input produces one JSON object with the fields index, xpub,
+ * xprv (null if not printed), depth, child and fingerprint (parent fingerprint, hex).
+ * With DeriveKeyOptions::origin every printed key becomes a key expression
+ * "[fingerprint/path]key", where fingerprint is the first 4 bytes of HASH160 of the key the
+ * path was derived from (the master key for seeds, the input key for extended keys); NDJSON
+ * records get an "origin" object instead.
+ * With OutputFormat::Address every input produces the P2PKH address of the derived public key.
+ * With DeriveKeyOptions::cacheFile the node after the last hardened path step is kept in a
+ * persistent NodeCache, so later runs with the same root and path skip the hardened CKD steps.
+ * Inputs are derived concurrently, but the output lines keep the input order.
  *
  * @param values A list of input strings (hex seed or xprv/xpub).
  * @param filepath A string representing the derivation path (e.g., "0/1h/2'/3").
+ * @param options Input interpretation and output options (see DeriveKeyOptions).
  */
-void deriveKey(const std::vector<std::string> &values, const std::string &filepath);
+void deriveKey(const std::vector<std::string> &values, const std::string &filepath, const DeriveKeyOptions &options = DeriveKeyOptions());
 
 #endif // DERIVE_KEY_H
@@ -0,0 +1,49 @@
+/**
+ * @project PV286 2024/2025 Project
+ * @file ExtendedKey.cpp
+ * @brief Implementation of BIP32 extended key serialization.
+ * @date 2026-10-18
+ *
+ * This file contains the BIP32 payload layout and its Base58Check encoding.
+ */
+
+#include "ExtendedKey.h"
+
+#include <cstring>
+
+#include "../ArgParser/crypto-encode/base58_fixed.h"
+#include "../ArgParser/crypto-hash/common.h"
+#include "../Utility/SecureArena.h"
+
+/**
+ * @brief Serializes an HD node as a Base58Check extended key.
+ * @param node The HD node.
+ * @param chain Chain parameters providing the version bytes.
+ * @param priv Serialize the private key (xprv) instead of the public key (xpub).
+ * @param out Output buffer of EXTENDED_KEY_BUFFER_SIZE characters.
+ */
+void serializeExtendedKey(const btc_hdnode *node, const btc_chainparams *chain, bool priv, char out[EXTENDED_KEY_BUFFER_SIZE])
+{
+    static_assert(safeheron::encode::base58::Base58CheckFixedSize<EXTENDED_KEY_PAYLOAD_SIZE>::MAX_LENGTH < EXTENDED_KEY_BUFFER_SIZE,
+                  "extended key buffer too small");
+
+    // version(4) | depth(1) | parent fingerprint(4) | child number(4) | chain code(32) | key(33)
+    unsigned char payload[EXTENDED_KEY_PAYLOAD_SIZE];
+    WriteBE32(payload, priv ? chain->b58prefix_bip32_privkey : chain->b58prefix_bip32_pubkey);
+    payload[4] = (unsigned char)node->depth;
+    WriteBE32(payload + 5, node->fingerprint);
+    WriteBE32(payload + 9, node->child_num);
+    memcpy(payload + 13, node->chain_code, BTC_BIP32_CHAINCODE_SIZE);
+    if (priv)
+    {
+        payload[45] = 0;
+        memcpy(payload + 46, node->private_key, BTC_ECKEY_PKEY_LENGTH);
+    }
+    else
+    {
+        memcpy(payload + 45, node->public_key, BTC_ECKEY_COMPRESSED_LENGTH);
+    }
+
+    safeheron::encode::base58::EncodeToBase58CheckFixed(payload, out);
+    SecureArena::wipe(payload, sizeof(payload));
+}
@@ -0,0 +1,41 @@
+/**
+ * @project PV286 2024/2025 Project
+ * @file ExtendedKey.h
+ * @brief Header file for BIP32 extended key serialization.
+ * @date 2026-10-18
+ *
+ * This file contains the declarations for serializing HD nodes into
+ * xpub/xprv strings without going through libbtc's generic base58 encoder.
+ */
+
+#ifndef EXTENDED_KEY_H
+#define EXTENDED_KEY_H
+
+#include <cstddef>
+
+extern "C"
+{
+#include <btc/bip32.h>
+#include <btc/chainparams.h>
+}
+
+/** Size of a serialized BIP32 extended key payload in bytes. */
+const size_t EXTENDED_KEY_PAYLOAD_SIZE = 78;
+
+/** Buffer size for a Base58Check encoded extended key (111 characters in practice), including the terminator. */
+const size_t EXTENDED_KEY_BUFFER_SIZE = 113;
+
+/**
+ * @brief Serializes an HD node as a Base58Check extended key.
+ *
+ * Produces exactly the same string as btc_hdnode_serialize_public/private, using the
+ * fixed-length encoder from crypto-encode/base58_fixed.h.
+ *
+ * @param node The HD node.
+ * @param chain Chain parameters providing the version bytes.
+ * @param priv Serialize the private key (xprv) instead of the public key (xpub).
+ * @param out Output buffer of EXTENDED_KEY_BUFFER_SIZE characters.
+ */
+void serializeExtendedKey(const btc_hdnode *node, const btc_chainparams *chain, bool priv, char out[EXTENDED_KEY_BUFFER_SIZE]);
+
+#endif // EXTENDED_KEY_H
@@ -0,0 +1,143 @@
+/**
+ * @project PV286 2024/2025 Project
+ * @file Mnemonic.cpp
+ * @brief Implementation of BIP39 mnemonic to seed conversion.
+ * @date 2026-10-18
+ *
+ * This file contains the implementation for turning BIP39 mnemonic
+ * sentences into BIP32 seeds using PBKDF2-HMAC-SHA512.
+ */
+
+#include "Mnemonic.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+#include "../ArgParser/crypto-hash/pbkdf2.h"
+#include "../Utility/SecureArena.h"
+
+/**
+ * @brief Validates a mnemonic sentence and normalises its separators.
+ * @param mnemonic The mnemonic sentence.
+ * @return The words joined by single spaces.
+ */
+std::string normalizeMnemonic(const std::string &mnemonic)
+{
+    // never longer than the input, so appending does not leave partial copies in freed memory
+    std::string result;
+    result.reserve(mnemonic.size());
+    size_t words = 0;
+    bool inWord = false;
+
+    for (char c : mnemonic)
+    {
+        if (c == ' ' || c == '\t')
+        {
+            inWord = false;
+            continue;
+        }
+        if (c < 'a' || c > 'z')
+        {
+            SecureArena::wipe(&result[0], result.size());
+            throw std::invalid_argument("[ERROR]: normalizeMnemonic: invalid character in mnemonic");
+        }
+        if (!inWord)
+        {
+            if (words > 0)
+                result += ' ';
+            words++;
+            inWord = true;
+        }
+        result += c;
+    }
+
+    if (words < 12 || words > 24 || words % 3 != 0)
+    {
+        SecureArena::wipe(&result[0], result.size());
+        throw std::invalid_argument("[ERROR]: normalizeMnemonic: mnemonic must have 12, 15, 18, 21 or 24 words");
+    }
+    return result;
+}
+
+/**
+ * @brief Checks that a passphrase can be used without NFKD normalisation.
+ * @param passphrase The BIP39 passphrase.
+ */
+void validatePassphrase(const std::string &passphrase)
+{
+    for (char c : passphrase)
+    {
+        if (c < 0x20 || c > 0x7e)
+        {
+            throw std::invalid_argument("[ERROR]: validatePassphrase: only printable ASCII passphrases are supported");
+        }
+    }
+}
+
+/**
+ * @brief Converts normalised mnemonics to BIP39 seeds.
+ * @param mnemonics Normalised mnemonic sentences.
+ * @param passphrase The BIP39 passphrase (may be empty).
+ * @param threads Number of worker threads, 0 = one per hardware thread.
+ * @return One seed per mnemonic, in input order.
+ */
+std::vector<std::array<uint8_t, BIP39_SEED_SIZE>> mnemonicsToSeeds(const std::vector<std::string> &mnemonics, const std::string &passphrase, unsigned threads)
+{
+    using namespace safeheron::hash;
+
+    std::vector<std::array<uint8_t, BIP39_SEED_SIZE>> seeds(mnemonics.size());
+    const std::string salt = "mnemonic" + passphrase;
+    const size_t groups = (mnemonics.size() + SHA512_LANES - 1) / SHA512_LANES;
+
+    // Each group of SHA512_LANES mnemonics goes through one multi-buffer PBKDF2 call.
+    auto runGroup = [&](size_t group)
+    {
+        const unsigned char *passwords[SHA512_LANES] = {};
+        size_t passwordLens[SHA512_LANES] = {};
+        const unsigned char *salts[SHA512_LANES] = {};
+        size_t saltLens[SHA512_LANES] = {};
+        unsigned char out[SHA512_LANES * PBKDF2_SHA512_OUTPUT_SIZE];
+
+        const size_t first = group * SHA512_LANES;
+        const size_t count = std::min(SHA512_LANES, mnemonics.size() - first);
+        for (size_t i = 0; i < count; i++)
+        {
+            passwords[i] = reinterpret_cast<const unsigned char *>(mnemonics[first + i].data());
+            passwordLens[i] = mnemonics[first + i].size();
+            salts[i] = reinterpret_cast<const unsigned char *>(salt.data());
+            saltLens[i] = salt.size();
+        }
+
+        PBKDF2_HMAC_SHA512_Multiway(passwords, passwordLens, salts, saltLens, count, BIP39_PBKDF2_ROUNDS, out);
+        for (size_t i = 0; i < count; i++)
+        {
+            std::copy(out + i * PBKDF2_SHA512_OUTPUT_SIZE, out + (i + 1) * PBKDF2_SHA512_OUTPUT_SIZE, seeds[first + i].begin());
+        }
+        std::fill(out, out + sizeof(out), 0);
+    };
+
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    size_t threadCount = std::min<size_t>(std::max(1u, threads), groups);
+    if (threadCount <= 1)
+    {
+        for (size_t group = 0; group < groups; group++)
+            runGroup(group);
+        return seeds;
+    }
+
+    // Groups are striped over the workers; every worker writes only its own seed slots.
+    std::vector<std::thread> workers;
+    for (size_t worker = 0; worker < threadCount; worker++)
+    {
+        workers.emplace_back([&, worker]()
+                             {
+            for (size_t group = worker; group < groups; group += threadCount)
+                runGroup(group); });
+    }
+    for (auto &thread : workers)
+        thread.join();
+
+    return seeds;
+}
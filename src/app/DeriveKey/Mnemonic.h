@@ -0,0 +1,59 @@
+/**
+ * @project PV286 2024/2025 Project
+ * @file Mnemonic.h
+ * @brief Header file for BIP39 mnemonic to seed conversion.
+ * @date 2026-10-18
+ *
+ * This file contains the function declarations for turning BIP39 mnemonic
+ * sentences (and an optional passphrase) into 64-byte BIP32 seeds.
+ */
+
+#ifndef MNEMONIC_H
+#define MNEMONIC_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** Size of a BIP39 seed in bytes. */
+const size_t BIP39_SEED_SIZE = 64;
+
+/** Number of PBKDF2 iterations mandated by BIP39. */
+const uint32_t BIP39_PBKDF2_ROUNDS = 2048;
+
+/**
+ * @brief Validates a mnemonic sentence and normalises its separators.
+ *
+ * Words must consist of lowercase ASCII letters and be separated by spaces or tabs;
+ * 12, 15, 18, 21 or 24 words are accepted. The words are not checked against the
+ * BIP39 word list, which is not shipped with the tool.
+ *
+ * @param mnemonic The mnemonic sentence.
+ * @return The words joined by single spaces.
+ */
+std::string normalizeMnemonic(const std::string &mnemonic);
+
+/**
+ * @brief Checks that a passphrase can be used without NFKD normalisation.
+ *
+ * Only printable ASCII is accepted, for which NFKD is the identity.
+ *
+ * @param passphrase The BIP39 passphrase.
+ */
+void validatePassphrase(const std::string &passphrase);
+
+/**
+ * @brief Converts normalised mnemonics to BIP39 seeds.
+ *
+ * PBKDF2-HMAC-SHA512 is run multi-buffer over groups of mnemonics, and the groups
+ * are spread over worker threads.
+ *
+ * @param mnemonics Normalised mnemonic sentences (see normalizeMnemonic).
+ * @param passphrase The BIP39 passphrase (may be empty).
+ * @param threads Number of worker threads, 0 = one per hardware thread.
+ * @return One seed per mnemonic, in input order.
+ */
+std::vector<std::array<uint8_t, BIP39_SEED_SIZE>> mnemonicsToSeeds(const std::vector<std::string> &mnemonics, const std::string &passphrase, unsigned threads = 0);
+
+#endif // MNEMONIC_H
@@ -0,0 +1,385 @@
+/**
+ * @project PV286 2024/2025 Project
+ * @file NodeCache.cpp
+ * @brief Implementation of the persistent cache of derived HD nodes.
+ * @date 2026-10-18
+ *
+ * This file contains the mmapped, fixed-slot hash table used by derivePath
+ * to skip hardened CKD steps that were already computed in an earlier run.
+ */
+
+#include "NodeCache.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../ArgParser/crypto-hash/hash160.h"
+#include "../ArgParser/crypto-hash/sha256.h"
+#include "../Utility/SecureArena.h"
+
+/** File magic, followed by the format version. */
+static const char NODE_CACHE_MAGIC[8] = {'B', 'I', 'P', '3', '8', '0', 'N', 'C'};
+static const uint32_t NODE_CACHE_VERSION = 1;
+
+/** Size of the file header: magic, version, slot count, slot size, clock, reserved. */
+static const size_t NODE_CACHE_HEADER_SIZE = 64;
+
+/** Header offsets. */
+static const size_t HEADER_VERSION = 8;
+static const size_t HEADER_SLOTS = 12;
+static const size_t HEADER_SLOT_SIZE = 16;
+static const size_t HEADER_CLOCK = 24;
+
+static_assert(sizeof(NodeCacheSlot) == 160, "NodeCacheSlot must not contain padding");
+
+/**
+ * @brief Reads a little-endian integer of the given size.
+ */
+static uint64_t readLE(const uint8_t *in, size_t size)
+{
+    uint64_t value = 0;
+    for (size_t i = size; i-- > 0;)
+        value = (value << 8) | in[i];
+    return value;
+}
+
+/**
+ * @brief Writes a little-endian integer of the given size.
+ */
+static void writeLE(uint8_t *out, uint64_t value, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        out[i] = (uint8_t)value;
+        value >>= 8;
+    }
+}
+
+/**
+ * @brief Computes the checksum of a slot.
+ * @param slot The slot.
+ * @param out Destination (8 bytes).
+ */
+static void slotChecksum(const NodeCacheSlot &slot, uint8_t out[8])
+{
+    uint8_t digest[safeheron::hash::CSHA256::OUTPUT_SIZE];
+    safeheron::hash::CSHA256()
+        .Write(slot.key, sizeof(slot.key))
+        .Write(&slot.depth, offsetof(NodeCacheSlot, checksum) - offsetof(NodeCacheSlot, depth))
+        .Finalize(digest);
+    memcpy(out, digest, 8);
+}
+
+/**
+ * @brief Holds flock() on the cache file for the lifetime of the object.
+ *
+ * A call interrupted by a signal is retried; any other failure (e.g. ENOLCK on a network file
+ * system) leaves the lock not held, which the caller must check with held().
+ */
+class FileLock
+{
+public:
+    FileLock(int fd, int operation) : fd(fd), locked(false)
+    {
+        int result;
+        do
+        {
+            result = flock(fd, operation);
+        } while (result != 0 && errno == EINTR);
+        locked = result == 0;
+    }
+    ~FileLock()
+    {
+        if (locked)
+            flock(fd, LOCK_UN);
+    }
+    bool held() const { return locked; }
+
+private:
+    int fd;
+    bool locked;
+};
+
+/**
+ * @brief Opens (or creates) the cache file and maps it.
+ * @param file Path of the cache file.
+ * @param storePrivateKeys Whether private keys are written to the file.
+ * @param slots Slot count of a newly created file; an existing file keeps its own.
+ */
+NodeCache::NodeCache(const std::string &file, bool storePrivateKeys, uint32_t slots)
+    : fd(-1), mapping(nullptr), mappingSize(0), slots(slots), storePrivate(storePrivateKeys), disabled(false)
+{
+    if (slots < NODE_CACHE_PROBE_WINDOW)
+    {
+        throw std::invalid_argument("[ERROR]: NodeCache: too few slots");
+    }
+
+    fd = open(file.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0)
+    {
+        throw std::runtime_error("[ERROR]: NodeCache: cannot open cache file " + file);
+    }
+
+    FileLock lock(fd, LOCK_EX);
+    if (!lock.held())
+    {
+        close(fd);
+        throw std::runtime_error("[ERROR]: NodeCache: cannot lock cache file " + file);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        throw std::runtime_error("[ERROR]: NodeCache: cannot stat cache file " + file);
+    }
+
+    // An existing cache keeps its slot count as long as its header is intact. A cache file of another
+    // version or with a damaged header is reinitialised, anything that is not a cache file is left alone.
+    bool valid = false;
+    if (info.st_size > 0)
+    {
+        uint8_t header[NODE_CACHE_HEADER_SIZE] = {0};
+        if (pread(fd, header, sizeof(header), 0) < (ssize_t)sizeof(NODE_CACHE_MAGIC) ||
+            memcmp(header, NODE_CACHE_MAGIC, sizeof(NODE_CACHE_MAGIC)) != 0)
+        {
+            close(fd);
+            throw std::invalid_argument("[ERROR]: NodeCache: not a node cache file " + file);
+        }
+        const uint32_t existingSlots = (uint32_t)readLE(header + HEADER_SLOTS, 4);
+        valid = readLE(header + HEADER_VERSION, 4) == NODE_CACHE_VERSION &&
+                readLE(header + HEADER_SLOT_SIZE, 4) == sizeof(NodeCacheSlot) &&
+                existingSlots >= NODE_CACHE_PROBE_WINDOW &&
+                (size_t)info.st_size == NODE_CACHE_HEADER_SIZE + (size_t)existingSlots * sizeof(NodeCacheSlot);
+        if (valid)
+            this->slots = existingSlots;
+    }
+
+    mappingSize = NODE_CACHE_HEADER_SIZE + (size_t)this->slots * sizeof(NodeCacheSlot);
+    if (!valid && (ftruncate(fd, 0) != 0 || ftruncate(fd, mappingSize) != 0))
+    {
+        close(fd);
+        throw std::runtime_error("[ERROR]: NodeCache: cannot size cache file " + file);
+    }
+
+    void *address = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED)
+    {
+        close(fd);
+        throw std::runtime_error("[ERROR]: NodeCache: cannot map cache file " + file);
+    }
+    mapping = static_cast<uint8_t *>(address);
+
+    if (!valid)
+    {
+        initialize();
+    }
+}
+
+/**
+ * @brief Unmaps and closes the cache file.
+ */
+NodeCache::~NodeCache()
+{
+    msync(mapping, mappingSize, MS_ASYNC);
+    munmap(mapping, mappingSize);
+    close(fd);
+}
+
+/**
+ * @brief Writes the header of an empty cache; the slots are already zero after ftruncate.
+ */
+void NodeCache::initialize()
+{
+    memcpy(mapping, NODE_CACHE_MAGIC, sizeof(NODE_CACHE_MAGIC));
+    writeLE(mapping + HEADER_VERSION, NODE_CACHE_VERSION, 4);
+    writeLE(mapping + HEADER_SLOTS, slots, 4);
+    writeLE(mapping + HEADER_SLOT_SIZE, sizeof(NodeCacheSlot), 4);
+    writeLE(mapping + HEADER_CLOCK, 0, 8);
+}
+
+/**
+ * @brief Returns the slot with the given index.
+ */
+NodeCacheSlot *NodeCache::slotAt(uint32_t index) const
+{
+    return reinterpret_cast<NodeCacheSlot *>(mapping + NODE_CACHE_HEADER_SIZE + (size_t)index * sizeof(NodeCacheSlot));
+}
+
+/**
+ * @brief Advances the cache clock used for the least-recently-used eviction.
+ * @return The new clock value, never 0.
+ */
+uint64_t NodeCache::tick()
+{
+    uint64_t clock = readLE(mapping + HEADER_CLOCK, 8) + 1;
+    writeLE(mapping + HEADER_CLOCK, clock, 8);
+    return clock;
+}
+
+/**
+ * @brief Computes the cache key of a node derived from a root node along a path.
+ *
+ * The key is SHA-256 over the root fingerprint (first 4 bytes of HASH160 of its public key),
+ * SHA-256 of the root chain code and the path steps (big-endian, hardened bit included).
+ * The chain code only enters the key hashed, so the file does not reveal it for the roots.
+ *
+ * @param root The node the path starts from.
+ * @param path The path steps.
+ * @param length Number of path steps.
+ * @return The key.
+ */
+NodeCache::Key NodeCache::makeKey(const btc_hdnode &root, const uint32_t *path, size_t length)
+{
+    uint8_t hash160[safeheron::hash::HASH160_OUTPUT_SIZE];
+    safeheron::hash::Hash160(hash160, root.public_key, BTC_ECKEY_COMPRESSED_LENGTH);
+    uint8_t chainCodeHash[safeheron::hash::CSHA256::OUTPUT_SIZE];
+    safeheron::hash::CSHA256().Write(root.chain_code, BTC_BIP32_CHAINCODE_SIZE).Finalize(chainCodeHash);
+
+    safeheron::hash::CSHA256 sha;
+    sha.Write(hash160, 4).Write(chainCodeHash, sizeof(chainCodeHash));
+    for (size_t i = 0; i < length; i++)
+    {
+        uint8_t step[4] = {(uint8_t)(path[i] >> 24), (uint8_t)(path[i] >> 16), (uint8_t)(path[i] >> 8), (uint8_t)path[i]};
+        sha.Write(step, sizeof(step));
+    }
+
+    Key key;
+    sha.Finalize(key.data());
+    return key;
+}
+
+/**
+ * @brief Looks up a node.
+ *
+ * A matching entry that fails its checksum is removed and reported as a miss.
+ *
+ * @param key The key (see makeKey).
+ * @param node Receives the cached node.
+ * @param hasPrivateKey Receives whether the cached node carries its private key.
+ * @return True on a hit.
+ */
+bool NodeCache::lookup(const Key &key, btc_hdnode *node, bool *hasPrivateKey)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    if (disabled)
+        return false;
+    FileLock lock(fd, LOCK_EX);
+    if (!lock.held())
+    {
+        disabled = true;
+        return false;
+    }
+
+    const uint32_t home = (uint32_t)(readLE(key.data(), 8) % slots);
+    for (uint32_t probe = 0; probe < NODE_CACHE_PROBE_WINDOW; probe++)
+    {
+        NodeCacheSlot *slot = slotAt((home + probe) % slots);
+        if (readLE(slot->stamp, 8) == 0 || memcmp(slot->key, key.data(), key.size()) != 0)
+            continue;
+
+        uint8_t checksum[8];
+        slotChecksum(*slot, checksum);
+        if (memcmp(checksum, slot->checksum, sizeof(checksum)) != 0)
+        {
+            memset(slot, 0, sizeof(*slot));
+            return false;
+        }
+
+        memset(node, 0, sizeof(*node));
+        node->depth = slot->depth;
+        node->fingerprint = (uint32_t)readLE(slot->fingerprint, 4);
+        node->child_num = (uint32_t)readLE(slot->childNum, 4);
+        memcpy(node->chain_code, slot->chainCode, sizeof(slot->chainCode));
+        memcpy(node->public_key, slot->publicKey, sizeof(slot->publicKey));
+        memcpy(node->private_key, slot->privateKey, sizeof(slot->privateKey));
+        *hasPrivateKey = (slot->flags & NODE_CACHE_HAS_PRIVATE_KEY) != 0;
+        writeLE(slot->stamp, tick(), 8);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Stores a node, replacing an entry with the same key or evicting the least recently used one.
+ *
+ * The private key is dropped unless the cache was opened with storePrivateKeys.
+ *
+ * @param key The key (see makeKey).
+ * @param node The node.
+ * @param hasPrivateKey Whether node carries its private key.
+ */
+void NodeCache::insert(const Key &key, const btc_hdnode &node, bool hasPrivateKey)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    if (disabled)
+        return;
+    FileLock lock(fd, LOCK_EX);
+    if (!lock.held())
+    {
+        disabled = true;
+        return;
+    }
+
+    const uint32_t home = (uint32_t)(readLE(key.data(), 8) % slots);
+    NodeCacheSlot *target = nullptr;
+    uint64_t oldest = UINT64_MAX;
+    for (uint32_t probe = 0; probe < NODE_CACHE_PROBE_WINDOW; probe++)
+    {
+        NodeCacheSlot *slot = slotAt((home + probe) % slots);
+        const uint64_t stamp = readLE(slot->stamp, 8);
+        if (stamp != 0 && memcmp(slot->key, key.data(), key.size()) == 0)
+        {
+            target = slot;
+            break;
+        }
+        if (stamp < oldest)
+        {
+            oldest = stamp;
+            target = slot;
+        }
+    }
+
+    const bool withPrivateKey = hasPrivateKey && storePrivate;
+    NodeCacheSlot entry;
+    memset(&entry, 0, sizeof(entry));
+    memcpy(entry.key, key.data(), key.size());
+    entry.depth = node.depth;
+    entry.flags = withPrivateKey ? NODE_CACHE_HAS_PRIVATE_KEY : 0;
+    writeLE(entry.fingerprint, node.fingerprint, 4);
+    writeLE(entry.childNum, node.child_num, 4);
+    memcpy(entry.chainCode, node.chain_code, sizeof(entry.chainCode));
+    memcpy(entry.publicKey, node.public_key, sizeof(entry.publicKey));
+    if (withPrivateKey)
+    {
+        memcpy(entry.privateKey, node.private_key, sizeof(entry.privateKey));
+    }
+    slotChecksum(entry, entry.checksum);
+    writeLE(entry.stamp, tick(), 8);
+
+    memcpy(target, &entry, sizeof(entry));
+    SecureArena::wipe(&entry, sizeof(entry));
+}
+
+/**
+ * @brief Returns whether private keys are written to the cache.
+ */
+bool NodeCache::storesPrivateKeys() const
+{
+    return storePrivate;
+}
+
+/**
+ * @brief Returns the number of slots of the cache file.
+ */
+uint32_t NodeCache::slotCount() const
+{
+    return slots;
+}
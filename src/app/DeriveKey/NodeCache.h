@@ -0,0 +1,100 @@
+/**
+ * @project PV286 2024/2025 Project
+ * @file NodeCache.h
+ * @brief Header file for the persistent cache of derived HD nodes.
+ * @date 2026-10-18
+ *
+ * This file contains the declaration of an on-disk, mmapped, fixed-slot hash table
+ * that keeps the nodes at hardened derivation steps between runs.
+ */
+
+#ifndef NODE_CACHE_H
+#define NODE_CACHE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+extern "C"
+{
+#include <btc/bip32.h>
+}
+
+/** Number of slots of a newly created cache file. */
+const uint32_t NODE_CACHE_DEFAULT_SLOTS = 4096;
+
+/** Number of consecutive slots probed for a key; the least recently used one of them is evicted. */
+const uint32_t NODE_CACHE_PROBE_WINDOW = 8;
+
+/**
+ * One cache slot. All fields are byte arrays, so the layout has no padding and is the same on every platform.
+ * Multi-byte integers are little-endian.
+ */
+struct NodeCacheSlot
+{
+    uint8_t key[32];         // NodeCache::Key of the entry
+    uint8_t stamp[8];        // last use (cache clock), 0 = empty slot
+    uint8_t depth;           // BIP32 depth
+    uint8_t flags;           // NODE_CACHE_HAS_PRIVATE_KEY
+    uint8_t reserved[2];     // zero
+    uint8_t fingerprint[4];  // parent fingerprint
+    uint8_t childNum[4];     // child number
+    uint8_t chainCode[32];   // chain code
+    uint8_t publicKey[33];   // compressed public key
+    uint8_t privateKey[32];  // private key, zero without NODE_CACHE_HAS_PRIVATE_KEY
+    uint8_t padding[3];      // zero
+    uint8_t checksum[8];     // first 8 bytes of SHA-256 over key and depth .. padding (the stamp is excluded)
+};
+
+/** Slot flag: the private key field is filled. */
+const uint8_t NODE_CACHE_HAS_PRIVATE_KEY = 0x01;
+
+/**
+ * @brief Persistent cache of HD nodes, shared between runs through a memory-mapped file.
+ *
+ * The file holds a header (magic, version, slot count, clock) followed by a fixed number of
+ * NodeCacheSlot entries, addressed by open addressing over a window of NODE_CACHE_PROBE_WINDOW
+ * slots. A full window evicts its least recently used entry. Every entry carries a checksum;
+ * entries failing it (e.g. torn writes of a killed process) are dropped, and a cache file of another
+ * version or size is reinitialised (files without the cache magic are rejected, not overwritten). The checksum detects corruption, not tampering: anyone able to
+ * write the file controls the derived keys, so it is created with mode 0600.
+ *
+ * Access is serialised with a mutex inside the process and flock() between processes. If the file
+ * cannot be locked after it was opened, the cache turns itself off: lookups miss and inserts are
+ * dropped, so shared slots are never touched without the lock.
+ */
+class NodeCache
+{
+public:
+    typedef std::array<uint8_t, 32> Key;
+
+    NodeCache(const std::string &file, bool storePrivateKeys, uint32_t slots = NODE_CACHE_DEFAULT_SLOTS);
+    ~NodeCache();
+    NodeCache(const NodeCache &) = delete;
+    NodeCache &operator=(const NodeCache &) = delete;
+
+    static Key makeKey(const btc_hdnode &root, const uint32_t *path, size_t length);
+
+    bool lookup(const Key &key, btc_hdnode *node, bool *hasPrivateKey);
+    void insert(const Key &key, const btc_hdnode &node, bool hasPrivateKey);
+
+    bool storesPrivateKeys() const;
+    uint32_t slotCount() const;
+
+private:
+    int fd;
+    uint8_t *mapping;
+    size_t mappingSize;
+    uint32_t slots;
+    bool storePrivate;
+    bool disabled;
+    std::mutex mutex;
+
+    NodeCacheSlot *slotAt(uint32_t index) const;
+    uint64_t tick();
+    void initialize();
+};
+
+#endif // NODE_CACHE_H
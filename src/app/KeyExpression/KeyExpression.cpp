@@ -1,19 +1,100 @@
-/**
- * Project: PV286 2024/2025 Project
- * @file KeyExpression.cpp
- * @author Pospíšil Zbyněk (xpospis)
- * @brief Implementation of Key expression logic
- * @date 2025-03-31
- *
- * @copyright Copyright (c) 2025
- *
- */
-
-#include "KeyExpression.h"
-
-#include <iostream>
-
-void runKeyExpression(const std::vector<std::string> &argValues) {
-    for (auto &arg : argValues)
-        std::cout << arg << std::endl;
-}
\ No newline at end of file
+/**
+ * Project: PV286 2024/2025 Project
+ * @file KeyExpression.cpp
+ * @author Pospíšil Zbyněk (xpospis)
+ * @brief Implementation of Key expression logic
+ * @date 2025-03-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "KeyExpression.h"
+#include "../Utility/JsonWriter.h"
+
+#include <iostream>
+
+
+/**
+ * Splits a key expression, which was already validated by ArgParser, into its parts
+ * @param expression key expression
+ * @return parts of the expression
+ */
+KeyExpressionInfo describeKeyExpression(const std::string &expression) {
+    KeyExpressionInfo info;
+    std::string rest = expression;
+
+    if (!rest.empty() && rest[0] == '[') {
+        size_t close = rest.find(']');
+        std::string origin = rest.substr(1, close - 1);
+        info.hasOrigin = true;
+        info.originFingerprint = origin.substr(0, 8);
+        if (origin.size() > 9)
+            info.originPath = origin.substr(9);
+        rest = rest.substr(close + 1);
+    }
+
+    if (rest.rfind("xpub", 0) == 0 || rest.rfind("xprv", 0) == 0) {
+        info.type = rest.substr(0, 4);
+        size_t slash = rest.find('/');
+        info.key = rest.substr(0, slash);
+        if (slash != std::string::npos) {
+            info.hasDerivation = true;
+            info.derivation = rest.substr(slash + 1);
+        }
+    }
+    else if (rest.rfind("04", 0) == 0) {
+        info.type = "uncompressed-pubkey";
+        info.key = rest;
+    }
+    else if (rest.rfind("02", 0) == 0 || rest.rfind("03", 0) == 0) {
+        info.type = "pubkey";
+        info.key = rest;
+    }
+    else {
+        info.type = "wif";
+        info.key = rest;
+    }
+    return info;
+}
+
+
+/**
+ * Prints the key expressions, either echoed back or as NDJSON records
+ * @param argValues validated key expressions
+ * @param format output format
+ */
+void runKeyExpression(const std::vector<std::string> &argValues, OutputFormat format) {
+    if (format != OutputFormat::Ndjson) {
+        for (auto &arg : argValues)
+            std::cout << arg << std::endl;
+        return;
+    }
+
+    JsonWriter json;
+    for (size_t i = 0; i < argValues.size(); i++) {
+        const KeyExpressionInfo info = describeKeyExpression(argValues[i]);
+        json.beginObject()
+            .numberField("index", i)
+            .stringField("expression", argValues[i])
+            .stringField("type", info.type)
+            .stringField("key", info.key);
+        if (info.hasOrigin) {
+            json.beginObject("origin")
+                .stringField("fingerprint", info.originFingerprint)
+                .stringField("path", info.originPath)
+                .endObject();
+        }
+        else {
+            json.nullField("origin");
+        }
+        if (info.hasDerivation)
+            json.stringField("derivation", info.derivation);
+        else
+            json.nullField("derivation");
+        json.endObject();
+        if (json.str().size() >= JsonWriter::DEFAULT_CAPACITY / 2)
+            json.flush(std::cout);
+    }
+    json.flush(std::cout);
+}
@@ -1,17 +1,32 @@
-/**
- * Project: PV286 2024/2025 Project
- * @file KeyExpression.h
- * @author Pospíšil Zbyněk (xpospis)
- * @brief Implementation of KeyExpression logic
- * @date 2025-03-31
- *
- * @copyright Copyright (c) 2025
- *
- */
-#pragma once
-
-#include <vector>
-#include <string>
-
-void runKeyExpression(const std::vector<std::string> &argValues);
-
+/**
+ * Project: PV286 2024/2025 Project
+ * @file KeyExpression.h
+ * @author Pospíšil Zbyněk (xpospis)
+ * @brief Implementation of KeyExpression logic
+ * @date 2025-03-31
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "../Utility/OutputFormat.h"
+
+/**
+ * Parts of an already validated key expression
+ */
+struct KeyExpressionInfo {
+    std::string type;  // pubkey, uncompressed-pubkey, wif, xpub or xprv
+    std::string key;  // the key itself, without origin and derivation steps
+    bool hasOrigin = false;  // [fingerprint/path] prefix present
+    std::string originFingerprint;  // 8 hex characters
+    std::string originPath;  // origin derivation steps without the leading slash, may be empty
+    bool hasDerivation = false;  // extended key followed by derivation steps
+    std::string derivation;  // derivation steps without the leading slash, e.g. 1/2h/*
+};
+
+KeyExpressionInfo describeKeyExpression(const std::string &expression);
+void runKeyExpression(const std::vector<std::string> &argValues, OutputFormat format = OutputFormat::Text);
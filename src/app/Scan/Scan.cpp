@@ -0,0 +1,253 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file Scan.cpp
+ * @brief Gap-limit scan of xpub address chains against a local set of used addresses
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "Scan.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include "../ArgParser/crypto-hash/hash160.h"
+#include "../ArgParser/crypto-hash/ripemd160.h"
+#include "../Utility/Address.h"
+#include "../Utility/EccContextPool.h"
+#include "../Utility/JsonWriter.h"
+#include "../Utility/StringUtilities.h"
+
+extern "C"
+{
+#include <btc/bip32.h>
+#include <btc/chainparams.h>
+}
+
+/** Number of addresses derived before their hashes are looked up, one multi-buffer HASH160 call. */
+static const size_t SCAN_GROUP = safeheron::hash::RIPEMD160_LANES;
+
+/** First hardened child index; chains only use the indices below it. */
+static const uint32_t SCAN_INDEX_LIMIT = 0x80000000;
+
+
+/**
+ * Parses a scan input: a bare xpub, which is scanned on its receive (0) and change (1) chains,
+ * or a pkh() descriptor of an xpub whose path ends with a * step, which is scanned on the single
+ * chain given by its path.
+ * A key origin is ignored, and so is a #checksum, which is not verified.
+ * @param value xpub or descriptor
+ * @return the chains to scan
+ */
+ScanSource parseScanSource(const std::string &value) {
+    ScanSource source;
+    std::string expression = StringUtilities::removeWhiteCharacters(StringUtilities::findFirstSubstringWithoutHash(value));
+
+    const bool descriptor = expression.compare(0, 4, "pkh(") == 0;
+    if (descriptor) {
+        if (expression.back() != ')')
+            throw std::invalid_argument("[ERROR]: parseScanSource: unterminated pkh() descriptor");
+        expression = expression.substr(4, expression.size() - 5);
+        const size_t originEnd = expression.find(']');
+        if (originEnd != std::string::npos)
+            expression = expression.substr(originEnd + 1);
+    }
+
+    std::vector<std::string> steps = StringUtilities::split(expression, "/");
+    source.xpub = steps[0];
+    {
+        EccContextPool::Lease ecc = EccContextPool::acquire();
+        btc_hdnode node;
+        if (source.xpub.compare(0, 4, "xpub") != 0 || !btc_hdnode_deserialize(source.xpub.c_str(), &btc_chainparams_main, &node))
+            throw std::invalid_argument("[ERROR]: parseScanSource: invalid extended public key");
+    }
+
+    if (!descriptor) {
+        if (steps.size() != 1)
+            throw std::invalid_argument("[ERROR]: parseScanSource: use pkh(XPUB/.../*) to scan a single chain");
+        source.chains = {{0}, {1}};
+        source.chainPaths = {"0", "1"};
+        return source;
+    }
+
+    if (steps.size() < 2 || steps.back() != "*")
+        throw std::invalid_argument("[ERROR]: parseScanSource: the descriptor path must end with /*");
+    std::vector<uint32_t> chain;
+    std::string chainPath;
+    for (size_t i = 1; i + 1 < steps.size(); i++) {
+        const std::string &step = steps[i];
+        if (step.empty() || step.size() > 10 || !std::all_of(step.begin(), step.end(), ::isdigit) || std::stoul(step) >= SCAN_INDEX_LIMIT)
+            throw std::invalid_argument("[ERROR]: parseScanSource: path steps must be non-hardened indices");
+        chain.push_back(static_cast<uint32_t>(std::stoul(step)));
+        chainPath += (chainPath.empty() ? "" : "/") + step;
+    }
+    source.chains.push_back(chain);
+    source.chainPaths.push_back(chainPath);
+    return source;
+}
+
+
+/**
+ * Walks one chain until options.gap consecutive addresses are unused
+ *
+ * Addresses are derived in windows of at least gap indices, each in groups of SCAN_GROUP whose
+ * public keys go through one Hash160Batch call and are then looked up in the used set. The chain
+ * ends at the first index that is gap indices past the last used one, so at most one window is
+ * derived past its end and nothing found there is reported.
+ *
+ * @param parent node above the chain's "*" step
+ * @param used used set
+ * @param gap gap limit
+ * @param result filled with the used indices and their addresses
+ */
+static void walkChain(const btc_hdnode &parent, const UsedSet &used, uint32_t gap, ScanResult *result) {
+    using safeheron::hash::HASH160_OUTPUT_SIZE;
+
+    const uint64_t window = (uint64_t(gap) + SCAN_GROUP - 1) / SCAN_GROUP * SCAN_GROUP;
+    uint8_t keys[SCAN_GROUP][33];
+    uint8_t hashes[SCAN_GROUP * HASH160_OUTPUT_SIZE];
+    uint32_t indices[SCAN_GROUP];
+    int64_t lastUsed = -1;
+
+    for (uint64_t first = 0; first < SCAN_INDEX_LIMIT && first - (lastUsed + 1) < gap; first += window) {
+        const uint64_t last = std::min<uint64_t>(SCAN_INDEX_LIMIT, first + window);
+        for (uint64_t group = first; group < last; group += SCAN_GROUP) {
+            size_t count = 0;
+            for (uint64_t index = group; index < std::min(last, group + SCAN_GROUP); index++) {
+                btc_hdnode child = parent;
+                // indices without a valid child are skipped, as BIP32 prescribes
+                if (!btc_hdnode_public_ckd(&child, static_cast<uint32_t>(index)))
+                    continue;
+                memcpy(keys[count], child.public_key, sizeof(keys[count]));
+                indices[count++] = static_cast<uint32_t>(index);
+            }
+
+            safeheron::hash::Hash160Batch(hashes, keys[0], 33, count);
+            for (size_t i = 0; i < count; i++) {
+                // the chain ended inside this window, addresses past the gap do not count
+                if (int64_t(indices[i]) - (lastUsed + 1) >= int64_t(gap))
+                    return;
+                const uint8_t *hash = hashes + HASH160_OUTPUT_SIZE * i;
+                if (!used.contains(hash))
+                    continue;
+                char address[ADDRESS_BUFFER_SIZE];
+                encodeAddress(P2PKH_ADDRESS_VERSION, hash, address);
+                result->usedIndices.push_back(indices[i]);
+                result->addresses.push_back(address);
+                lastUsed = indices[i];
+            }
+        }
+    }
+}
+
+
+/**
+ * Scans every chain of every source against the used set
+ *
+ * Each chain is an independent task: its parent node is derived once, then the chain is walked
+ * window by window (see walkChain). Workers take chains from a shared counter, so many inputs,
+ * or an input with several chains, are scanned in parallel.
+ *
+ * @param sources parsed inputs
+ * @param used used set
+ * @param options gap limit and thread count
+ * @return one result per chain, in input and chain order
+ */
+std::vector<ScanResult> scanChains(const std::vector<ScanSource> &sources, const UsedSet &used, const ScanOptions &options) {
+    static btc_chainparams *chain = (btc_chainparams *)&btc_chainparams_main;
+
+    struct ChainTask {
+        size_t source;
+        size_t chain;
+    };
+    std::vector<ChainTask> tasks;
+    for (size_t s = 0; s < sources.size(); s++)
+        for (size_t c = 0; c < sources[s].chains.size(); c++)
+            tasks.push_back({s, c});
+
+    std::vector<ScanResult> results(tasks.size());
+    std::vector<std::string> errors(tasks.size());
+    std::atomic<size_t> nextTask(0);
+
+    auto work = [&]() {
+        EccContextPool::Lease ecc = EccContextPool::acquire();
+        for (size_t t = nextTask++; t < tasks.size(); t = nextTask++) {
+            const ScanSource &source = sources[tasks[t].source];
+            results[t].input = tasks[t].source;
+            results[t].chainPath = source.chainPaths[tasks[t].chain];
+
+            btc_hdnode parent;
+            bool valid = btc_hdnode_deserialize(source.xpub.c_str(), chain, &parent);
+            for (uint32_t step : source.chains[tasks[t].chain])
+                valid = valid && btc_hdnode_public_ckd(&parent, step);
+            if (!valid) {
+                errors[t] = "[ERROR]: scanChains: cannot derive chain " + results[t].chainPath;
+                continue;
+            }
+            walkChain(parent, used, options.gap, &results[t]);
+        }
+    };
+
+    unsigned threads = options.threads == 0 ? std::thread::hardware_concurrency() : options.threads;
+    threads = std::max<size_t>(1, std::min<size_t>(threads, tasks.size()));
+    if (threads == 1) {
+        work();
+    }
+    else {
+        std::vector<std::thread> workers;
+        for (unsigned i = 0; i < threads; i++)
+            workers.emplace_back(work);
+        for (auto &thread : workers)
+            thread.join();
+    }
+
+    for (const auto &error : errors) {
+        if (!error.empty())
+            throw std::runtime_error(error);
+    }
+    return results;
+}
+
+
+/**
+ * Loads the used file, scans the chains of every input and prints every used address in input, chain
+ * and index order, as "input:path:address" lines or NDJSON records (input, path, index, address)
+ * @param values xpubs or pkh() descriptors
+ * @param usedFile path of the used file (see UsedSet)
+ * @param options scan and output options
+ */
+void runScan(const std::vector<std::string> &values, const std::string &usedFile, const ScanOptions &options) {
+    std::vector<ScanSource> sources;
+    for (const auto &value : values)
+        sources.push_back(parseScanSource(value));
+    const UsedSet used(usedFile);
+    const std::vector<ScanResult> results = scanChains(sources, used, options);
+
+    JsonWriter json;
+    for (const auto &result : results) {
+        for (size_t i = 0; i < result.usedIndices.size(); i++) {
+            const std::string path = result.chainPath + "/" + std::to_string(result.usedIndices[i]);
+            if (options.format == OutputFormat::Ndjson) {
+                json.beginObject()
+                    .numberField("input", static_cast<uint64_t>(result.input))
+                    .stringField("path", path)
+                    .numberField("index", static_cast<uint64_t>(result.usedIndices[i]))
+                    .stringField("address", result.addresses[i])
+                    .endObject();
+                if (json.str().size() >= JsonWriter::DEFAULT_CAPACITY / 2)
+                    json.flush(std::cout);
+            }
+            else {
+                std::cout << result.input << ":" << path << ":" << result.addresses[i] << "\n";
+            }
+        }
+    }
+    json.flush(std::cout);
+    std::cout.flush();
+}
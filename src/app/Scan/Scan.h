@@ -0,0 +1,50 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file Scan.h
+ * @brief Gap-limit scan of xpub address chains against a local set of used addresses
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "UsedSet.h"
+#include "../Utility/CommandLimits.h"
+#include "../Utility/OutputFormat.h"
+
+/**
+ * Address chains of one scan input
+ */
+struct ScanSource {
+    std::string xpub;  // extended public key the chains are derived from
+    std::vector<std::vector<uint32_t>> chains;  // steps from the xpub to the parent of every chain
+    std::vector<std::string> chainPaths;  // the same steps as a path, e.g. "0" or "1/0"
+};
+
+/**
+ * Used addresses found on one chain
+ */
+struct ScanResult {
+    size_t input = 0;  // index of the input
+    std::string chainPath;  // path of the chain below the xpub
+    std::vector<uint32_t> usedIndices;  // child indices of used addresses, ascending
+    std::vector<std::string> addresses;  // P2PKH address of every used index
+};
+
+/**
+ * Scan options
+ */
+struct ScanOptions {
+    uint32_t gap = DEFAULT_SCAN_GAP;  // a chain ends after this many consecutive unused addresses
+    unsigned threads = 0;  // number of worker threads, 0 = one per hardware thread
+    OutputFormat format = OutputFormat::Text;  // "input:path:address" lines or NDJSON
+};
+
+ScanSource parseScanSource(const std::string &value);
+std::vector<ScanResult> scanChains(const std::vector<ScanSource> &sources, const UsedSet &used, const ScanOptions &options);
+void runScan(const std::vector<std::string> &values, const std::string &usedFile, const ScanOptions &options);
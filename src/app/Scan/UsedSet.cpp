@@ -0,0 +1,270 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file UsedSet.cpp
+ * @brief Compact in-memory set of used P2PKH HASH160s, loaded from an mmapped file
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "UsedSet.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../ArgParser/crypto-encode/base58.h"
+#include "../Utility/Address.h"
+
+
+/**
+ * Decodes one hex digit
+ * @param c hex character
+ * @return value of the digit, -1 if c is not a hex digit
+ */
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+
+/** Number of address lines whose base58check checksums are verified together. */
+static const size_t ADDRESS_BATCH = 64;
+
+
+/**
+ * Error for a line that is neither a P2PKH address nor a P2PKH scriptPubKey
+ * @param lineNumber 1-based line number
+ * @return exception to throw
+ */
+static std::invalid_argument entryError(size_t lineNumber) {
+    return std::invalid_argument("[ERROR]: UsedSet: line " + std::to_string(lineNumber) +
+                                 ": expected a P2PKH address or scriptPubKey");
+}
+
+
+/**
+ * Extracts the HASH160 of a P2PKH scriptPubKey
+ * @param entry one line of the used file, trimmed
+ * @param hash filled with the HASH160
+ * @return true if entry is the hex of a P2PKH scriptPubKey
+ */
+static bool parseScriptPubKey(std::string_view entry, std::array<uint8_t, 20> *hash) {
+    // scriptPubKey: OP_DUP OP_HASH160 <20 bytes> OP_EQUALVERIFY OP_CHECKSIG
+    if (entry.size() != 50 || entry.compare(0, 6, "76a914") != 0 || entry.compare(46, 4, "88ac") != 0)
+        return false;
+    for (size_t i = 0; i < hash->size(); i++) {
+        const int high = hexValue(entry[6 + 2 * i]);
+        const int low = hexValue(entry[7 + 2 * i]);
+        if (high < 0 || low < 0)
+            return false;
+        (*hash)[i] = static_cast<uint8_t>(high << 4 | low);
+    }
+    return true;
+}
+
+
+/**
+ * Decodes a batch of P2PKH addresses, verifying their checksums together
+ * @param addresses address lines, trimmed
+ * @param lineNumbers their line numbers
+ * @param count number of addresses, at most ADDRESS_BATCH
+ * @param hashes receives the HASH160 of every address
+ */
+static void parseAddresses(const std::string_view *addresses, const size_t *lineNumbers, size_t count,
+                           std::vector<std::array<uint8_t, 20>> *hashes) {
+    using safeheron::encode::base58::Base58Status;
+    unsigned char payloads[ADDRESS_BATCH][ADDRESS_PAYLOAD_SIZE];
+    size_t sizes[ADDRESS_BATCH];
+    Base58Status statuses[ADDRESS_BATCH];
+    safeheron::encode::base58::DecodeFromBase58CheckBatch(addresses, count, payloads[0], ADDRESS_PAYLOAD_SIZE, sizes, statuses);
+
+    for (size_t i = 0; i < count; i++) {
+        if (statuses[i] != Base58Status::Ok || sizes[i] != ADDRESS_PAYLOAD_SIZE || payloads[i][0] != P2PKH_ADDRESS_VERSION)
+            throw entryError(lineNumbers[i]);
+        std::array<uint8_t, 20> hash;
+        std::copy(payloads[i] + 1, payloads[i] + ADDRESS_PAYLOAD_SIZE, hash.begin());
+        hashes->push_back(hash);
+    }
+}
+
+
+/**
+ * Loads the used set from a file; the file is mmapped read-only for parsing and unmapped afterwards
+ * @param file path of the used file
+ */
+UsedSet::UsedSet(const std::string &file) {
+    const int fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw std::invalid_argument("[ERROR]: UsedSet: cannot open used file " + file);
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        close(fd);
+        throw std::invalid_argument("[ERROR]: UsedSet: used file is not a regular file");
+    }
+    const size_t size = static_cast<size_t>(info.st_size);
+    if (size == 0) {
+        close(fd);
+        load(nullptr, 0);
+        return;
+    }
+
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+        throw std::runtime_error("[ERROR]: UsedSet: cannot map used file");
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    try {
+        load(static_cast<const char *>(mapping), size);
+    }
+    catch (...) {
+        munmap(mapping, size);
+        throw;
+    }
+    munmap(mapping, size);
+}
+
+
+/**
+ * Loads the used set from a buffer in the used file format
+ * @param data file contents
+ * @param size number of bytes
+ */
+UsedSet::UsedSet(const char *data, size_t size) {
+    load(data, size);
+}
+
+
+/**
+ * Parses all entries and builds the table
+ * @param data file contents
+ * @param size number of bytes
+ */
+void UsedSet::load(const char *data, size_t size) {
+    std::vector<std::array<uint8_t, 20>> hashes;
+    // address lines wait here until a batch is full, a line fails or the input ends
+    std::string_view addresses[ADDRESS_BATCH];
+    size_t addressLines[ADDRESS_BATCH];
+    size_t pending = 0;
+    size_t lineNumber = 0;
+    size_t position = 0;
+
+    while (position < size) {
+        const char *lineEnd = static_cast<const char *>(memchr(data + position, '\n', size - position));
+        const size_t end = lineEnd == nullptr ? size : static_cast<size_t>(lineEnd - data);
+        lineNumber++;
+
+        size_t first = position, last = end;
+        while (first < last && isspace(static_cast<unsigned char>(data[first])))
+            first++;
+        while (last > first && isspace(static_cast<unsigned char>(data[last - 1])))
+            last--;
+        position = end + 1;
+        if (first == last || data[first] == '#')
+            continue;
+
+        const std::string_view entry(data + first, last - first);
+        std::array<uint8_t, 20> hash;
+        if (parseScriptPubKey(entry, &hash)) {
+            hashes.push_back(hash);
+            continue;
+        }
+        if (entry.size() < 26 || entry.size() >= ADDRESS_BUFFER_SIZE) {
+            // report an earlier bad address first
+            parseAddresses(addresses, addressLines, pending, &hashes);
+            throw entryError(lineNumber);
+        }
+        addresses[pending] = entry;
+        addressLines[pending++] = lineNumber;
+        if (pending == ADDRESS_BATCH) {
+            parseAddresses(addresses, addressLines, pending, &hashes);
+            pending = 0;
+        }
+    }
+    parseAddresses(addresses, addressLines, pending, &hashes);
+
+    size_t slotCount = USED_SET_MIN_SLOTS;
+    while (slotCount < 2 * hashes.size())
+        slotCount *= 2;
+    slots.assign(slotCount, std::array<uint8_t, 20>());
+    mask = slotCount - 1;
+    for (const auto &hash : hashes)
+        insert(hash);
+}
+
+
+/**
+ * Index of the first slot probed for a hash; HASH160s are uniformly distributed, so their first bytes are used directly
+ * @param hash HASH160
+ * @param mask slot count - 1
+ * @return slot index
+ */
+static size_t slotIndex(const uint8_t *hash, size_t mask) {
+    uint64_t value;
+    memcpy(&value, hash, sizeof(value));
+    return static_cast<size_t>(value) & mask;
+}
+
+
+/**
+ * Inserts a hash, duplicates are ignored
+ * @param hash HASH160
+ */
+void UsedSet::insert(const std::array<uint8_t, 20> &hash) {
+    static const std::array<uint8_t, 20> empty = {};
+    if (hash == empty) {
+        count += hasZeroHash ? 0 : 1;
+        hasZeroHash = true;
+        return;
+    }
+    for (size_t i = slotIndex(hash.data(), mask);; i = (i + 1) & mask) {
+        if (slots[i] == hash)
+            return;
+        if (slots[i] == empty) {
+            slots[i] = hash;
+            count++;
+            return;
+        }
+    }
+}
+
+
+/**
+ * Looks a HASH160 up
+ * @param hash160 20-byte HASH160
+ * @return true if the hash is in the set
+ */
+bool UsedSet::contains(const uint8_t *hash160) const {
+    static const std::array<uint8_t, 20> empty = {};
+    if (memcmp(hash160, empty.data(), empty.size()) == 0)
+        return hasZeroHash;
+    for (size_t i = slotIndex(hash160, mask);; i = (i + 1) & mask) {
+        if (memcmp(slots[i].data(), hash160, slots[i].size()) == 0)
+            return true;
+        if (slots[i] == empty)
+            return false;
+    }
+}
+
+
+/**
+ * @return number of distinct entries
+ */
+size_t UsedSet::size() const {
+    return count;
+}
@@ -0,0 +1,46 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file UsedSet.h
+ * @brief Compact in-memory set of used P2PKH HASH160s, loaded from an mmapped file
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** Smallest number of slots of a UsedSet table. */
+const size_t USED_SET_MIN_SLOTS = 16;
+
+/**
+ * Set of HASH160s of used P2PKH outputs, standing in for a node's address index.
+ *
+ * The file holds one entry per line: a base58check P2PKH address or the hex of a P2PKH scriptPubKey
+ * (76a914{HASH160}88ac). Empty lines and lines starting with # are skipped. The file is mmapped
+ * read-only while it is parsed, and the hashes are kept in a flat open-addressing table with
+ * linear probing and a load factor of at most 1/2: 20 bytes per slot and no per-entry allocation.
+ * An all-zero slot is empty; the (practically impossible) all-zero HASH160 is tracked separately.
+ */
+class UsedSet {
+public:
+    explicit UsedSet(const std::string &file);
+    UsedSet(const char *data, size_t size);
+
+    bool contains(const uint8_t *hash160) const;
+    size_t size() const;
+
+private:
+    std::vector<std::array<uint8_t, 20>> slots;  // HASH160s, all zero = empty slot
+    size_t mask = 0;  // slots.size() - 1, the size is a power of two
+    size_t count = 0;  // number of distinct entries
+    bool hasZeroHash = false;  // the all-zero HASH160 is in the set
+
+    void load(const char *data, size_t size);
+    void insert(const std::array<uint8_t, 20> &hash);
+};
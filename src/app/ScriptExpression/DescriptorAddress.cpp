@@ -0,0 +1,254 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file DescriptorAddress.cpp
+ * @brief Base58check addresses of pkh() and sh() script expressions
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "DescriptorAddress.h"
+#include "../Utility/Address.h"
+#include "../Utility/EccContextPool.h"
+#include "../Utility/SecureArena.h"
+#include "../Utility/StringUtilities.h"
+#include "../ArgParser/crypto-encode/base58.h"
+#include "../ArgParser/crypto-encode/hex.h"
+#include "../ArgParser/crypto-hash/hash160.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+
+extern "C" {
+#include <btc/bip32.h>
+#include <btc/chainparams.h>
+#include <btc/ecc.h>
+}
+
+/** Script opcodes used by the supported redeem scripts. */
+static const uint8_t OP_DUP = 0x76;
+static const uint8_t OP_HASH160 = 0xa9;
+static const uint8_t OP_EQUALVERIFY = 0x88;
+static const uint8_t OP_CHECKSIG = 0xac;
+static const uint8_t OP_CHECKMULTISIG = 0xae;
+static const uint8_t OP_1 = 0x51;
+
+/** Version byte of mainnet WIF private keys. */
+static const uint8_t WIF_VERSION = 0x80;
+
+
+/**
+ * Strips a "name(" prefix and the matching ")" suffix.
+ * @param expression expression without whitespace
+ * @param name function name, e.g. "pkh"
+ * @param inner receives the argument list
+ * @return true if the expression is name(...)
+ */
+static bool unwrap(const std::string &expression, const std::string &name, std::string *inner) {
+    const std::string prefix = name + "(";
+    if (expression.size() <= prefix.size() || expression.compare(0, prefix.size(), prefix) != 0 || expression.back() != ')')
+        return false;
+    *inner = expression.substr(prefix.size(), expression.size() - prefix.size() - 1);
+    return true;
+}
+
+
+/**
+ * Derives the public key of an extended key expression KEY/NUM/NUMh/...
+ * @param key extended key expression without key origin
+ * @return 33-byte compressed public key
+ */
+static std::vector<uint8_t> extendedKeyPublicKey(const std::string &key) {
+    std::vector<std::string> steps = StringUtilities::split(key, "/");
+    EccContextPool::Lease ecc = EccContextPool::acquire();
+
+    btc_hdnode node;
+    if (!btc_hdnode_deserialize(steps[0].c_str(), &btc_chainparams_main, &node))
+        throw std::invalid_argument("[ERROR]: extendedKeyPublicKey: invalid extended key");
+    const bool hasPrv = steps[0].compare(0, 4, "xprv") == 0;
+
+    for (size_t i = 1; i < steps.size(); i++) {
+        std::string step = steps[i];
+        if (step == "*" || step == "*h" || step == "*H" || step == "*'") {
+            SecureArena::wipe(&node, sizeof(node));
+            throw std::invalid_argument("[ERROR]: extendedKeyPublicKey: ranged key expressions have no single address");
+        }
+        bool hardened = false;
+        if (!step.empty() && (step.back() == 'h' || step.back() == 'H' || step.back() == '\'')) {
+            hardened = true;
+            step.pop_back();
+        }
+        unsigned long index = 0;
+        try {
+            index = std::stoul(step);
+        }
+        catch (std::exception &ex) {
+            SecureArena::wipe(&node, sizeof(node));
+            throw std::invalid_argument("[ERROR]: extendedKeyPublicKey: invalid derivation step " + steps[i]);
+        }
+        if (index >= 0x80000000ul || (hardened && !hasPrv)) {
+            SecureArena::wipe(&node, sizeof(node));
+            throw std::invalid_argument("[ERROR]: extendedKeyPublicKey: cannot derive step " + steps[i]);
+        }
+
+        const uint32_t child = (uint32_t)index | (hardened ? 0x80000000u : 0);
+        const bool ok = hasPrv ? btc_hdnode_private_ckd(&node, child) : btc_hdnode_public_ckd(&node, child);
+        if (!ok) {
+            SecureArena::wipe(&node, sizeof(node));
+            throw std::invalid_argument("[ERROR]: extendedKeyPublicKey: derivation failed at step " + steps[i]);
+        }
+    }
+
+    std::vector<uint8_t> publicKey(node.public_key, node.public_key + BTC_ECKEY_COMPRESSED_LENGTH);
+    SecureArena::wipe(&node, sizeof(node));
+    return publicKey;
+}
+
+
+/**
+ * Computes the public key of a WIF private key.
+ * @param wif WIF string
+ * @return compressed or uncompressed public key, as selected by the WIF compression flag
+ */
+static std::vector<uint8_t> wifPublicKey(const std::string &wif) {
+    using safeheron::encode::base58::Base58Status;
+    // version, 32-byte key and the optional compression flag
+    uint8_t decoded[34];
+    size_t size = 0;
+    const Base58Status status = safeheron::encode::base58::DecodeFromBase58Check(wif, decoded, sizeof(decoded), &size);
+    if (status == Base58Status::InvalidCharacter || status == Base58Status::BadChecksum)
+        throw std::invalid_argument("[ERROR]: wifPublicKey: invalid WIF checksum");
+
+    const bool compressed = status == Base58Status::Ok && size == 34 && decoded[33] == 0x01;
+    if (status != Base58Status::Ok || (size != 33 && !compressed) || decoded[0] != WIF_VERSION) {
+        SecureArena::wipe(decoded, sizeof(decoded));
+        throw std::invalid_argument("[ERROR]: wifPublicKey: invalid WIF private key");
+    }
+
+    uint8_t privateKey[32];
+    memcpy(privateKey, decoded + 1, sizeof(privateKey));
+    SecureArena::wipe(decoded, sizeof(decoded));
+
+    uint8_t publicKey[BTC_ECKEY_UNCOMPRESSED_LENGTH];
+    size_t publicKeyLen = sizeof(publicKey);
+    {
+        EccContextPool::Lease ecc = EccContextPool::acquire();
+        btc_ecc_get_pubkey(privateKey, publicKey, &publicKeyLen, compressed);
+    }
+    SecureArena::wipe(privateKey, sizeof(privateKey));
+    return std::vector<uint8_t>(publicKey, publicKey + publicKeyLen);
+}
+
+
+/**
+ * Returns the serialized public key of a key expression.
+ * @param key key expression
+ * @return 33-byte compressed or 65-byte uncompressed public key
+ */
+std::vector<uint8_t> keyExpressionPublicKey(const std::string &key) {
+    const size_t originEnd = key.find(']');
+    const std::string bare = originEnd == std::string::npos ? key : key.substr(originEnd + 1);
+
+    if (bare.compare(0, 4, "xpub") == 0 || bare.compare(0, 4, "xprv") == 0)
+        return extendedKeyPublicKey(bare);
+
+    if (bare.size() == 2 * BTC_ECKEY_COMPRESSED_LENGTH || bare.size() == 2 * BTC_ECKEY_UNCOMPRESSED_LENGTH) {
+        uint8_t bytes[BTC_ECKEY_UNCOMPRESSED_LENGTH];
+        size_t size = 0;
+        if (safeheron::encode::hex::DecodeFromHex(bare, bytes, sizeof(bytes), &size) == safeheron::encode::hex::HexStatus::Ok)
+            return std::vector<uint8_t>(bytes, bytes + size);
+    }
+
+    return wifPublicKey(bare);
+}
+
+
+/**
+ * Appends a data push of at most 75 bytes to a script.
+ * @param script script to extend
+ * @param data pushed bytes
+ */
+static void pushData(std::vector<uint8_t> *script, const std::vector<uint8_t> &data) {
+    script->push_back((uint8_t)data.size());
+    script->insert(script->end(), data.begin(), data.end());
+}
+
+
+/**
+ * Returns the redeem script of a pk(), pkh() or multi() expression.
+ * @param expression expression without whitespace
+ * @return script bytes
+ */
+std::vector<uint8_t> redeemScript(const std::string &expression) {
+    std::string inner;
+    std::vector<uint8_t> script;
+
+    if (unwrap(expression, "pk", &inner)) {
+        pushData(&script, keyExpressionPublicKey(inner));
+        script.push_back(OP_CHECKSIG);
+        return script;
+    }
+
+    if (unwrap(expression, "pkh", &inner)) {
+        const std::vector<uint8_t> publicKey = keyExpressionPublicKey(inner);
+        std::vector<uint8_t> hash(safeheron::hash::HASH160_OUTPUT_SIZE);
+        safeheron::hash::Hash160(hash.data(), publicKey.data(), publicKey.size());
+        script.push_back(OP_DUP);
+        script.push_back(OP_HASH160);
+        pushData(&script, hash);
+        script.push_back(OP_EQUALVERIFY);
+        script.push_back(OP_CHECKSIG);
+        return script;
+    }
+
+    if (unwrap(expression, "multi", &inner)) {
+        std::vector<std::string> tokens = StringUtilities::split(inner, ",");
+        const size_t n = tokens.size() - 1;
+        size_t k = 0;
+        try {
+            k = std::stoul(tokens[0]);
+        }
+        catch (std::exception &ex) {
+            throw std::invalid_argument("[ERROR]: redeemScript: invalid threshold " + tokens[0]);
+        }
+        if (k < 1 || k > n || n > 16)
+            throw std::invalid_argument("[ERROR]: redeemScript: multi() needs 1 <= k <= n <= 16");
+
+        script.push_back((uint8_t)(OP_1 + k - 1));
+        for (size_t i = 1; i < tokens.size(); i++)
+            pushData(&script, keyExpressionPublicKey(tokens[i]));
+        script.push_back((uint8_t)(OP_1 + n - 1));
+        script.push_back(OP_CHECKMULTISIG);
+        return script;
+    }
+
+    throw std::invalid_argument("[ERROR]: redeemScript: unsupported expression inside sh()");
+}
+
+
+/**
+ * Returns the mainnet address of a script expression.
+ * @param descriptor script expression without checksum
+ * @return base58check address
+ */
+std::string descriptorAddress(const std::string &descriptor) {
+    const std::string expression = StringUtilities::removeWhiteCharacters(descriptor);
+    std::string inner;
+
+    if (unwrap(expression, "pkh", &inner)) {
+        const std::vector<uint8_t> publicKey = keyExpressionPublicKey(inner);
+        return p2pkhAddress(publicKey.data(), publicKey.size());
+    }
+
+    if (unwrap(expression, "sh", &inner)) {
+        const std::vector<uint8_t> script = redeemScript(inner);
+        if (script.size() > MAX_REDEEM_SCRIPT_SIZE)
+            throw std::invalid_argument("[ERROR]: descriptorAddress: redeem script exceeds " + std::to_string(MAX_REDEEM_SCRIPT_SIZE) + " bytes");
+        return p2shAddress(script.data(), script.size());
+    }
+
+    throw std::invalid_argument("[ERROR]: descriptorAddress: only pkh() and sh() expressions have an address");
+}
@@ -0,0 +1,45 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file DescriptorAddress.h
+ * @brief Base58check addresses of pkh() and sh() script expressions
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+/** Largest redeem script allowed in P2SH (MAX_SCRIPT_ELEMENT_SIZE of Bitcoin Core). */
+const size_t MAX_REDEEM_SCRIPT_SIZE = 520;
+
+
+/**
+ * Returns the serialized public key of a key expression: a hex public key, a WIF private key or
+ * an extended key with a fixed derivation path. The key origin, if any, is ignored.
+ * @param key key expression
+ * @return 33-byte compressed or 65-byte uncompressed public key
+ * @throws std::invalid_argument for ranged extended keys, hardened steps below an xpub and invalid keys
+ */
+std::vector<uint8_t> keyExpressionPublicKey(const std::string &key);
+
+/**
+ * Returns the redeem script of a pk(), pkh() or multi() expression.
+ * @param expression expression without whitespace
+ * @return script bytes
+ */
+std::vector<uint8_t> redeemScript(const std::string &expression);
+
+/**
+ * Returns the mainnet address of a script expression: P2PKH for pkh(KEY), P2SH of the redeem
+ * script for sh(pk(KEY)), sh(pkh(KEY)) and sh(multi(k,KEY_1,...,KEY_n)).
+ * @param descriptor script expression without checksum, whitespace between tokens is ignored
+ * @return base58check address
+ * @throws std::invalid_argument for expressions without an address (pk(), multi(), raw()) or invalid keys
+ */
+std::string descriptorAddress(const std::string &descriptor);
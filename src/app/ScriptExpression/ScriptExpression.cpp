@@ -10,7 +10,9 @@
  */
 
 #include "ScriptExpression.h"
+#include "DescriptorAddress.h"
 #include "../Utility/StringUtilities.h"
+#include "../Utility/JsonWriter.h"
 #include <algorithm>
 #include <iostream>
 #include <string>
@@ -183,10 +185,34 @@ std::string ScriptExpression::createDecsum(std::string s, bool includeInput) {
  */
 void ScriptExpression::computeChecksum() {
     std::string firstSubstringWithoutHash = StringUtilities::findFirstSubstringWithoutHash(this->Script);
+    if (this->Format == OutputFormat::Ndjson) {
+        this->printJson(firstSubstringWithoutHash, this->createDecsum(firstSubstringWithoutHash, false), -1);
+        return;
+    }
     std::cout << this->createDecsum(firstSubstringWithoutHash, true) << std::endl;
 }
 
 
+/**
+ * Function prints one NDJSON record describing the script expression.
+ * @param descriptor is the expression without checksum
+ * @param checksum is the computed checksum of the descriptor
+ * @param verified is 1 or 0 for the result of checksum verification, -1 (null) if verification was not requested
+ */
+void ScriptExpression::printJson(const std::string &descriptor, const std::string &checksum, int verified) {
+    JsonWriter json;
+    json.beginObject()
+        .stringField("descriptor", descriptor)
+        .stringField("checksum", checksum);
+    if (verified < 0)
+        json.nullField("verified");
+    else
+        json.boolField("verified", verified == 1);
+    json.endObject();
+    json.flush(std::cout);
+}
+
+
 /**
  * Function for verifying checksum function. First it divides SCRIPT#CHECKUSM into SCRIPT and CHECKSUM.
  * Then checkDecsum is called with creating new checksum. Function prints out "OK" in case checkDecsum is successful and
@@ -201,8 +227,13 @@ void ScriptExpression::verifyChecksum() {
     bool checkDecsum = this->checkDecsum(scriptExpression);
     std::string checksumCalculated = this->createDecsum(script, false);
 
-    if (checkDecsum && (checksumCalculated == checksumProvided)) {
-        std::cout << "OK" << std::endl;
+    bool verified = checkDecsum && (checksumCalculated == checksumProvided);
+    if (this->Format == OutputFormat::Ndjson)
+        this->printJson(script, checksumCalculated, verified ? 1 : 0);
+
+    if (verified) {
+        if (this->Format == OutputFormat::Text)
+            std::cout << "OK" << std::endl;
     }
     else {
         std::cerr << "Error: Provided checksum is not correct for provided expression." << std::endl;
@@ -211,6 +242,22 @@ void ScriptExpression::verifyChecksum() {
 }
 
 
+/**
+ * Function prints the base58check address of the expression (see descriptorAddress).
+ * Expressions without an address, such as pk() or raw(), print an error message.
+ */
+void ScriptExpression::printAddress() {
+    std::string descriptor = StringUtilities::findFirstSubstringWithoutHash(this->Script);
+    try {
+        std::cout << descriptorAddress(descriptor) << std::endl;
+    }
+    catch (std::exception &ex) {
+        std::cerr << ex.what() << std::endl;
+        exit(1);
+    }
+}
+
+
 /**
  * Function that is called when parsing arguments using script-expression subcommand
  */
@@ -219,6 +266,15 @@ void ScriptExpression::parse() {
         this->computeChecksum();
     } else if (this->VerifyChecksumFlag == true){
         this->verifyChecksum();
+        if (this->Format == OutputFormat::Address)
+            this->printAddress();
+    }
+    else if (this->Format == OutputFormat::Ndjson) {
+        std::string descriptor = StringUtilities::findFirstSubstringWithoutHash(this->Script);
+        this->printJson(descriptor, this->createDecsum(descriptor, false), -1);
+    }
+    else if (this->Format == OutputFormat::Address) {
+        this->printAddress();
     }
     else {
         std::cout << this->Script << std::endl;
@@ -232,11 +288,13 @@ void ScriptExpression::parse() {
  * @param argValuesVector is vector of provided values
  * @param computeChecksumFlag is flag which tells if compute checksum flag was mentioned
  * @param verifyChecksumFlag is flag which tells if verify checksum flag was mentione
+ * @param format is the output format (text or NDJSON)
  */
-ScriptExpression::ScriptExpression(std::vector<std::string> argValuesVector,bool computeChecksumFlag, bool verifyChecksumFlag) {
+ScriptExpression::ScriptExpression(std::vector<std::string> argValuesVector,bool computeChecksumFlag, bool verifyChecksumFlag, OutputFormat format) {
     this->ArgValuesVector = argValuesVector;
     this->ComputeChecksumFlag = computeChecksumFlag;
     this->VerifyChecksumFlag = verifyChecksumFlag;
+    this->Format = format;
 
     argValuesVector.erase(remove(argValuesVector.begin(), argValuesVector.end(), "bip380"), argValuesVector.end());
     argValuesVector.erase(remove(argValuesVector.begin(), argValuesVector.end(), "script-expression"), argValuesVector.end());
@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 
+#include "../Utility/OutputFormat.h"
 
 class ScriptExpression {
 private:
@@ -24,6 +25,7 @@ private:
 
 	bool ComputeChecksumFlag;
 	bool VerifyChecksumFlag;
+	OutputFormat Format;
 	std::vector<std::string> ArgValuesVector;
 	std::string Script;
 
@@ -34,7 +36,9 @@ private:
 
 	void computeChecksum();
 	void verifyChecksum();
+	void printJson(const std::string &descriptor, const std::string &checksum, int verified);
+	void printAddress();
 public:
-	ScriptExpression(std::vector<std::string> argValuesVector, bool computeChecksumFlag, bool verifyChecksumFlag);
+	ScriptExpression(std::vector<std::string> argValuesVector, bool computeChecksumFlag, bool verifyChecksumFlag, OutputFormat format = OutputFormat::Text);
 	void parse();
 };
\ No newline at end of file
@@ -0,0 +1,77 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file Address.cpp
+ * @brief Base58Check P2PKH and P2SH addresses, single and batched
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "Address.h"
+
+#include <cstring>
+#include <vector>
+
+#include "../ArgParser/crypto-encode/base58_fixed.h"
+#include "../ArgParser/crypto-hash/hash160.h"
+
+
+/**
+ * Encodes a HASH160 as a base58check address.
+ * @param version address version byte
+ * @param hash160 20-byte HASH160
+ * @param out buffer of ADDRESS_BUFFER_SIZE characters
+ * @return length of the address
+ */
+size_t encodeAddress(uint8_t version, const uint8_t *hash160, char *out) {
+    static_assert(safeheron::encode::base58::Base58CheckFixedSize<ADDRESS_PAYLOAD_SIZE>::MAX_LENGTH < ADDRESS_BUFFER_SIZE,
+                  "ADDRESS_BUFFER_SIZE too small");
+
+    unsigned char payload[ADDRESS_PAYLOAD_SIZE];
+    payload[0] = version;
+    memcpy(payload + 1, hash160, safeheron::hash::HASH160_OUTPUT_SIZE);
+    return safeheron::encode::base58::EncodeToBase58CheckFixed(payload, out);
+}
+
+
+/**
+ * Computes the addresses of count messages of len bytes each.
+ * @param version address version byte
+ * @param input count*len bytes
+ * @param len length of one message
+ * @param count number of messages
+ * @param out count*ADDRESS_BUFFER_SIZE characters
+ */
+void encodeAddressBatch(uint8_t version, const uint8_t *input, size_t len, size_t count, char *out) {
+    std::vector<unsigned char> hashes(count * safeheron::hash::HASH160_OUTPUT_SIZE);
+    safeheron::hash::Hash160Batch(hashes.data(), input, len, count);
+    for (size_t i = 0; i < count; i++)
+        encodeAddress(version, hashes.data() + i * safeheron::hash::HASH160_OUTPUT_SIZE, out + i * ADDRESS_BUFFER_SIZE);
+}
+
+
+/**
+ * Returns the P2PKH address of a public key.
+ * @param publicKey serialized public key
+ * @param len length of the public key
+ * @return base58check address
+ */
+std::string p2pkhAddress(const uint8_t *publicKey, size_t len) {
+    char address[ADDRESS_BUFFER_SIZE];
+    encodeAddressBatch(P2PKH_ADDRESS_VERSION, publicKey, len, 1, address);
+    return address;
+}
+
+
+/**
+ * Returns the P2SH address of a redeem script.
+ * @param script redeem script bytes
+ * @param len length of the script
+ * @return base58check address
+ */
+std::string p2shAddress(const uint8_t *script, size_t len) {
+    char address[ADDRESS_BUFFER_SIZE];
+    encodeAddressBatch(P2SH_ADDRESS_VERSION, script, len, 1, address);
+    return address;
+}
@@ -0,0 +1,66 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file Address.h
+ * @brief Base58Check P2PKH and P2SH addresses, single and batched
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+/** Mainnet version byte of pay-to-pubkey-hash addresses. */
+const uint8_t P2PKH_ADDRESS_VERSION = 0x00;
+
+/** Mainnet version byte of pay-to-script-hash addresses. */
+const uint8_t P2SH_ADDRESS_VERSION = 0x05;
+
+/** Size of an address payload: version byte followed by the HASH160. */
+const size_t ADDRESS_PAYLOAD_SIZE = 21;
+
+/** Buffer size of an encoded address including the terminator (a 25-byte base58check string has at most 34 characters). */
+const size_t ADDRESS_BUFFER_SIZE = 36;
+
+
+/**
+ * Encodes a HASH160 as a base58check address.
+ * @param version address version byte (P2PKH_ADDRESS_VERSION or P2SH_ADDRESS_VERSION)
+ * @param hash160 20-byte HASH160 of the public key or the redeem script
+ * @param out buffer of ADDRESS_BUFFER_SIZE characters, null terminated on return
+ * @return length of the address
+ */
+size_t encodeAddress(uint8_t version, const uint8_t *hash160, char *out);
+
+/**
+ * Computes the addresses of count messages of len bytes each, stored back to back.
+ * The HASH160 of all messages goes through Hash160Batch, so the RIPEMD-160 stage runs
+ * multi-buffer; the payloads are then encoded with the fixed-length base58check encoder.
+ * @param version address version byte
+ * @param input count*len bytes, e.g. compressed public keys for P2PKH
+ * @param len length of one message
+ * @param count number of messages
+ * @param out count*ADDRESS_BUFFER_SIZE characters, one null terminated address per slot
+ */
+void encodeAddressBatch(uint8_t version, const uint8_t *input, size_t len, size_t count, char *out);
+
+/**
+ * Returns the P2PKH address of a public key.
+ * @param publicKey serialized public key (33 or 65 bytes)
+ * @param len length of the public key
+ * @return base58check address
+ */
+std::string p2pkhAddress(const uint8_t *publicKey, size_t len);
+
+/**
+ * Returns the P2SH address of a redeem script.
+ * @param script redeem script bytes
+ * @param len length of the script
+ * @return base58check address
+ */
+std::string p2shAddress(const uint8_t *script, size_t len);
@@ -0,0 +1,36 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file CommandLimits.h
+ * @brief Bounds and defaults of sub-command arguments, and output sizes printed in the help
+ * @date 2026-10-18
+ *
+ * Shared by ArgParser, which validates the arguments and prints the help, and by the sub-commands,
+ * so the parser does not include the sub-command headers.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+/** Upper bound of --threads. */
+const unsigned MAX_DERIVE_THREADS = 256;
+
+/** Size of one derive-key --format=bin record, layout in DeriveKey.h. */
+const size_t BINARY_RECORD_SIZE = 128;
+
+/** Number of child indices searched when --range is not provided. */
+const uint32_t DEFAULT_CHILD_SEARCH_RANGE = 1000;
+
+/** Upper bound of --range and of every path template step, the number of non-hardened child indices. */
+const uint32_t MAX_CHILD_SEARCH_RANGE = 0x80000000;
+
+/** Number of consecutive unused addresses that ends a chain when --gap is not provided (BIP44). */
+const uint32_t DEFAULT_SCAN_GAP = 20;
+
+/** Upper bound of --gap. */
+const uint32_t MAX_SCAN_GAP = 100000;
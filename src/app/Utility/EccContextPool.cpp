@@ -0,0 +1,118 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file EccContextPool.cpp
+ * @brief Lifetime management of the secp256k1 context shared by libbtc
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "EccContextPool.h"
+
+#include <cstdlib>
+#include <mutex>
+
+extern "C"
+{
+#include <btc/ecc.h>
+}
+
+
+static std::mutex contextMutex;  // serialises start/stop of the shared context
+static size_t leaseCount = 0;  // number of live leases, guarded by contextMutex
+static bool contextStarted = false;  // btc_ecc_start() was called, guarded by contextMutex
+static bool shutdownRegistered = false;  // shutdown() is registered with atexit(), guarded by contextMutex
+
+
+/**
+ * Takes a reference on the shared context, starting it on first use; the context is stopped at exit
+ */
+void EccContextPool::retain() {
+    std::lock_guard<std::mutex> lock(contextMutex);
+    leaseCount++;
+    if (!contextStarted) {
+        btc_ecc_start();
+        contextStarted = true;
+        if (!shutdownRegistered)
+            shutdownRegistered = std::atexit(EccContextPool::shutdown) == 0;
+    }
+}
+
+
+/**
+ * Drops a reference on the shared context, which stays started for the next lease
+ */
+void EccContextPool::release() {
+    std::lock_guard<std::mutex> lock(contextMutex);
+    leaseCount--;
+}
+
+
+/**
+ * Stops the shared context if it was started and no lease is held. Registered with atexit() by the
+ * first lease; an exit() while workers still hold leases leaves the context to the operating system.
+ */
+void EccContextPool::shutdown() {
+    std::lock_guard<std::mutex> lock(contextMutex);
+    if (contextStarted && leaseCount == 0) {
+        btc_ecc_stop();
+        contextStarted = false;
+    }
+}
+
+
+/**
+ * Acquires a lease on the shared secp256k1 context. Must be held by every thread performing EC operations.
+ * @return lease, which keeps the context alive until it is destroyed
+ */
+EccContextPool::Lease EccContextPool::acquire() {
+    return Lease();
+}
+
+
+/**
+ * Returns the number of currently held leases
+ * @return number of leases
+ */
+size_t EccContextPool::activeLeases() {
+    std::lock_guard<std::mutex> lock(contextMutex);
+    return leaseCount;
+}
+
+
+/**
+ * Tells whether the shared context has been started
+ * @return true once a lease has been acquired, until shutdown()
+ */
+bool EccContextPool::started() {
+    std::lock_guard<std::mutex> lock(contextMutex);
+    return contextStarted;
+}
+
+
+EccContextPool::Lease::Lease() : active(true) {
+    EccContextPool::retain();
+}
+
+
+EccContextPool::Lease::~Lease() {
+    if (active)
+        EccContextPool::release();
+}
+
+
+EccContextPool::Lease::Lease(Lease &&other) noexcept : active(other.active) {
+    other.active = false;
+}
+
+
+EccContextPool::Lease &EccContextPool::Lease::operator=(Lease &&other) noexcept {
+    if (this != &other) {
+        if (active)
+            EccContextPool::release();
+        active = other.active;
+        other.active = false;
+    }
+    return *this;
+}
@@ -0,0 +1,55 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file EccContextPool.h
+ * @brief Lifetime management of the secp256k1 context shared by libbtc
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+
+
+/**
+ * libbtc keeps a single secp256k1 context behind btc_ecc_start()/btc_ecc_stop(), and every EC operation
+ * (btc_hdnode_* derivation, deserialisation of xprv keys, ...) implicitly uses it. The context is only read
+ * by those operations, so it can be shared by any number of threads as long as it is neither created,
+ * randomised nor destroyed while they use it.
+ *
+ * EccContextPool makes that contract explicit: every thread that performs EC math holds a Lease for the
+ * duration of the work. The context is started lazily by the first lease, so commands that never touch
+ * EC math (--help, hex public keys, raw() descriptors, ...) do not pay for creating and randomising it.
+ * Once started it is kept until the process exits, even while no lease is held, because argument
+ * validation and the command itself would otherwise start it twice. The start is serialised so that
+ * workers never observe a half-initialised context.
+ */
+class EccContextPool {
+public:
+    /**
+     * RAII handle keeping the shared context alive. Movable, not copyable.
+     */
+    class Lease {
+    private:
+        bool active;
+
+    public:
+        Lease();
+        ~Lease();
+        Lease(Lease &&other) noexcept;
+        Lease &operator=(Lease &&other) noexcept;
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+    };
+
+    static Lease acquire();
+    static size_t activeLeases();
+    static bool started();
+    static void shutdown();
+
+private:
+    static void retain();
+    static void release();
+};
@@ -0,0 +1,221 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file JsonWriter.cpp
+ * @brief Streaming writer for newline-delimited JSON records
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "JsonWriter.h"
+
+#include <cstring>
+
+#include "SecureArena.h"
+
+
+/**
+ * Constructor, reserves the record buffer
+ * @param capacity initial buffer capacity in bytes
+ */
+JsonWriter::JsonWriter(size_t capacity) {
+    this->buffer.reserve(capacity);
+}
+
+
+/**
+ * Appends a quoted, escaped JSON string
+ * @param data string bytes (UTF-8 is passed through)
+ * @param length number of bytes
+ */
+void JsonWriter::appendString(const char *data, size_t length) {
+    static const char hexDigits[] = "0123456789abcdef";
+
+    this->buffer += '"';
+    for (size_t i = 0; i < length; i++) {
+        const unsigned char c = static_cast<unsigned char>(data[i]);
+        switch (c) {
+            case '"': this->buffer += "\\\""; break;
+            case '\\': this->buffer += "\\\\"; break;
+            case '\n': this->buffer += "\\n"; break;
+            case '\r': this->buffer += "\\r"; break;
+            case '\t': this->buffer += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    const char escape[] = {'\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0xf]};
+                    this->buffer.append(escape, sizeof(escape));
+                }
+                else {
+                    this->buffer += static_cast<char>(c);
+                }
+        }
+    }
+    this->buffer += '"';
+}
+
+
+/**
+ * Appends the separator (if needed) and the key of the next field
+ * @param name field name, must not need escaping
+ */
+void JsonWriter::appendKey(const char *name) {
+    if (this->needComma)
+        this->buffer += ',';
+    this->buffer += '"';
+    this->buffer += name;
+    this->buffer += "\":";
+    this->needComma = true;
+}
+
+
+/**
+ * Opens a new record
+ * @return this writer
+ */
+JsonWriter &JsonWriter::beginObject() {
+    this->buffer += '{';
+    this->depth++;
+    this->needComma = false;
+    return *this;
+}
+
+
+/**
+ * Opens a nested object field
+ * @param name field name
+ * @return this writer
+ */
+JsonWriter &JsonWriter::beginObject(const char *name) {
+    appendKey(name);
+    return beginObject();
+}
+
+
+/**
+ * Closes the innermost object, the outermost one also terminates the record
+ * @return this writer
+ */
+JsonWriter &JsonWriter::endObject() {
+    this->buffer += '}';
+    this->depth--;
+    this->needComma = true;
+    if (this->depth == 0) {
+        this->buffer += '\n';
+        this->needComma = false;
+    }
+    return *this;
+}
+
+
+/**
+ * Appends a string field
+ * @param name field name
+ * @param value field value
+ * @return this writer
+ */
+JsonWriter &JsonWriter::stringField(const char *name, const std::string &value) {
+    appendKey(name);
+    appendString(value.data(), value.size());
+    return *this;
+}
+
+
+/**
+ * Appends a string field
+ * @param name field name
+ * @param value null terminated field value
+ * @return this writer
+ */
+JsonWriter &JsonWriter::stringField(const char *name, const char *value) {
+    appendKey(name);
+    appendString(value, strlen(value));
+    return *this;
+}
+
+
+/**
+ * Appends an unsigned integer field
+ * @param name field name
+ * @param value field value
+ * @return this writer
+ */
+JsonWriter &JsonWriter::numberField(const char *name, uint64_t value) {
+    appendKey(name);
+    char digits[20];
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (count > 0)
+        this->buffer += digits[--count];
+    return *this;
+}
+
+
+/**
+ * Appends a boolean field
+ * @param name field name
+ * @param value field value
+ * @return this writer
+ */
+JsonWriter &JsonWriter::boolField(const char *name, bool value) {
+    appendKey(name);
+    this->buffer += value ? "true" : "false";
+    return *this;
+}
+
+
+/**
+ * Appends a null field
+ * @param name field name
+ * @return this writer
+ */
+JsonWriter &JsonWriter::nullField(const char *name) {
+    appendKey(name);
+    this->buffer += "null";
+    return *this;
+}
+
+
+/**
+ * Returns the records written since the last clear/flush
+ * @return buffered output
+ */
+const std::string &JsonWriter::str() const {
+    return this->buffer;
+}
+
+
+/**
+ * Makes room for at least capacity bytes of records, so that appending up to that size never moves
+ * the buffer (and never leaves a copy of its contents behind in freed memory)
+ * @param capacity buffer capacity in bytes
+ */
+void JsonWriter::reserve(size_t capacity) {
+    this->buffer.reserve(capacity);
+}
+
+
+/**
+ * Wipes and discards the buffered output, keeping the buffer capacity; records may hold private
+ * keys (derive-key --format=ndjson)
+ */
+void JsonWriter::clear() {
+    SecureArena::wipe(&this->buffer[0], this->buffer.size());
+    this->buffer.clear();
+    this->depth = 0;
+    this->needComma = false;
+}
+
+
+/**
+ * Writes the buffered records to a stream and clears the buffer
+ * @param out output stream
+ */
+void JsonWriter::flush(std::ostream &out) {
+    out.write(this->buffer.data(), static_cast<std::streamsize>(this->buffer.size()));
+    out.flush();
+    clear();
+}
@@ -0,0 +1,55 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file JsonWriter.h
+ * @brief Streaming writer for newline-delimited JSON records
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+
+/**
+ * Builds NDJSON records into a preallocated buffer. Values are appended with hand-written
+ * escaping and number formatting, no iostream formatting is involved; the buffer keeps its
+ * capacity across records, so steady-state output does not allocate.
+ *
+ * Usage: beginObject(), a sequence of *Field() calls (nested objects via beginObject(name)),
+ * endObject(). Closing the outermost object terminates the record with a newline.
+ */
+class JsonWriter {
+private:
+    std::string buffer;
+    unsigned depth = 0;  // number of open objects
+    bool needComma = false;  // a value was written at the current level
+
+    void appendKey(const char *name);
+    void appendString(const char *data, size_t length);
+
+public:
+    static const size_t DEFAULT_CAPACITY = 1024;
+
+    explicit JsonWriter(size_t capacity = DEFAULT_CAPACITY);
+
+    JsonWriter &beginObject();
+    JsonWriter &beginObject(const char *name);
+    JsonWriter &endObject();
+
+    JsonWriter &stringField(const char *name, const std::string &value);
+    JsonWriter &stringField(const char *name, const char *value);
+    JsonWriter &numberField(const char *name, uint64_t value);
+    JsonWriter &boolField(const char *name, bool value);
+    JsonWriter &nullField(const char *name);
+
+    const std::string &str() const;
+    void reserve(size_t capacity);
+    void clear();
+    void flush(std::ostream &out);
+};
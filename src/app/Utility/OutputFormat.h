@@ -0,0 +1,23 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file OutputFormat.h
+ * @brief Output formats selectable with --format=
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+
+/**
+ * Output formats of the sub-commands. Text is the original line output, Binary is only
+ * supported by derive-key, Address by derive-key and script-expression.
+ */
+enum class OutputFormat {
+    Text,    // human readable lines
+    Binary,  // fixed-size binary records
+    Ndjson,  // one JSON object per line
+    Address  // one base58check address per line
+};
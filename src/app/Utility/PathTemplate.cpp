@@ -0,0 +1,50 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file PathTemplate.cpp
+ * @brief Parser of find-child path templates
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "PathTemplate.h"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+#include "CommandLimits.h"
+#include "StringUtilities.h"
+
+
+/**
+ * Parses a path template, used both to validate the find-child argument and to run the search.
+ *
+ * The template is a sequence of non-hardened NUM steps, NUM from the range [0,...,2^31-1], separated
+ * by "/", with exactly one * step standing for the searched child index; the default template is "*".
+ *
+ * @param pathTemplate template to be parsed
+ * @return the steps before and after "*"
+ */
+PathTemplate parsePathTemplate(const std::string &pathTemplate) {
+    PathTemplate parsed;
+    bool wildcard = false;
+    for (const auto &step : StringUtilities::split(pathTemplate, "/")) {
+        if (step == "*") {
+            if (wildcard)
+                throw std::invalid_argument("[ERROR]: parsePathTemplate: more than one * step");
+            wildcard = true;
+            continue;
+        }
+        if (step.empty() || step.size() > 10 || !std::all_of(step.begin(), step.end(), ::isdigit))
+            throw std::invalid_argument("[ERROR]: parsePathTemplate: steps must be non-hardened indices");
+        const unsigned long index = std::stoul(step);
+        if (index >= MAX_CHILD_SEARCH_RANGE)
+            throw std::invalid_argument("[ERROR]: parsePathTemplate: index out of range");
+        (wildcard ? parsed.suffix : parsed.prefix).push_back(static_cast<uint32_t>(index));
+    }
+    if (!wildcard)
+        throw std::invalid_argument("[ERROR]: parsePathTemplate: missing * step");
+    return parsed;
+}
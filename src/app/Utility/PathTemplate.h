@@ -0,0 +1,26 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file PathTemplate.h
+ * @brief Parser of find-child path templates
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+/**
+ * Steps of a path template around its "*" step
+ */
+struct PathTemplate {
+    std::vector<uint32_t> prefix;  // steps before "*"
+    std::vector<uint32_t> suffix;  // steps after "*"
+};
+
+PathTemplate parsePathTemplate(const std::string &pathTemplate);
@@ -0,0 +1,129 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file SecureArena.cpp
+ * @brief Locked, reusable bump allocator for secret buffers (seeds, private keys)
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "SecureArena.h"
+
+#include <stdexcept>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+/**
+ * Maps, locks and pre-faults the arena
+ * @param capacity number of usable bytes, rounded up to whole pages
+ */
+SecureArena::SecureArena(size_t capacity) {
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size = (capacity == 0 ? page : (capacity + page - 1) / page * page);
+
+    void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+        throw std::runtime_error("[ERROR]: SecureArena: cannot allocate secure memory");
+    base = static_cast<uint8_t *>(mapping);
+
+#ifdef MADV_DONTDUMP
+    madvise(base, size, MADV_DONTDUMP);
+#endif
+    // mlock() also faults the pages in, so the derive loop never takes a page fault on them
+    isLocked = mlock(base, size) == 0;
+}
+
+
+/**
+ * Wipes, unlocks and unmaps the arena
+ */
+SecureArena::~SecureArena() {
+    wipe(base, size);
+    if (isLocked)
+        munlock(base, size);
+    munmap(base, size);
+}
+
+
+/**
+ * Hands out a buffer; its contents are undefined until written
+ * @param bytes buffer size
+ * @param alignment power of two the buffer address is a multiple of
+ * @return the buffer, valid until the next reset()
+ */
+void *SecureArena::allocate(size_t bytes, size_t alignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+        throw std::invalid_argument("[ERROR]: SecureArena: alignment must be a power of two");
+    const size_t start = (offset + alignment - 1) & ~(alignment - 1);
+    if (start > size || bytes > size - start)
+        throw std::length_error("[ERROR]: SecureArena: arena exhausted");
+    offset = start + bytes;
+    return base + start;
+}
+
+
+/**
+ * @param bytes buffer size
+ * @return a byte buffer, valid until the next reset()
+ */
+uint8_t *SecureArena::allocateBytes(size_t bytes) {
+    return static_cast<uint8_t *>(allocate(bytes, 1));
+}
+
+
+/**
+ * @param bytes buffer size
+ * @return a character buffer, valid until the next reset()
+ */
+char *SecureArena::allocateChars(size_t bytes) {
+    return static_cast<char *>(allocate(bytes, 1));
+}
+
+
+/**
+ * Wipes every buffer handed out since the previous reset and makes the space available again
+ */
+void SecureArena::reset() {
+    wipe(base, offset);
+    offset = 0;
+}
+
+
+/**
+ * @return number of usable bytes
+ */
+size_t SecureArena::capacity() const {
+    return size;
+}
+
+
+/**
+ * @return number of bytes handed out since the last reset, including alignment padding
+ */
+size_t SecureArena::used() const {
+    return offset;
+}
+
+
+/**
+ * @return true if the arena is locked in RAM
+ */
+bool SecureArena::locked() const {
+    return isLocked;
+}
+
+
+/**
+ * Zeroes memory holding a secret; the writes go through a volatile pointer so that the
+ * compiler cannot drop them as dead stores
+ * @param data buffer
+ * @param bytes buffer size
+ */
+void SecureArena::wipe(void *data, size_t bytes) {
+    volatile uint8_t *p = static_cast<volatile uint8_t *>(data);
+    while (bytes-- > 0)
+        *p++ = 0;
+}
@@ -0,0 +1,55 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file SecureArena.h
+ * @brief Locked, reusable bump allocator for secret buffers (seeds, private keys)
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+/** Default capacity of a SecureArena, enough for the secrets of one derivation group. */
+const size_t SECURE_ARENA_DEFAULT_CAPACITY = 16 * 1024;
+
+
+/**
+ * Fixed-size region of anonymous memory from which short-lived secrets are bump-allocated.
+ *
+ * The region is allocated once, locked in RAM with mlock() so that it never reaches swap and
+ * excluded from core dumps. mlock() is best effort: when RLIMIT_MEMLOCK is too small the arena
+ * still works, locked() just reports false. Allocations are never freed one by one; reset()
+ * wipes everything handed out since the previous reset and makes the space available again, so
+ * a worker can reuse one arena for every input it derives without touching the heap.
+ *
+ * Not thread-safe: every thread uses its own arena.
+ */
+class SecureArena {
+public:
+    explicit SecureArena(size_t capacity = SECURE_ARENA_DEFAULT_CAPACITY);
+    ~SecureArena();
+    SecureArena(const SecureArena &) = delete;
+    SecureArena &operator=(const SecureArena &) = delete;
+
+    void *allocate(size_t size, size_t alignment = 16);
+    uint8_t *allocateBytes(size_t size);
+    char *allocateChars(size_t size);
+    void reset();
+
+    size_t capacity() const;
+    size_t used() const;
+    bool locked() const;
+
+    static void wipe(void *data, size_t size);
+
+private:
+    uint8_t *base = nullptr;  // start of the mapping
+    size_t size = 0;  // mapped size, a multiple of the page size
+    size_t offset = 0;  // bytes handed out since the last reset
+    bool isLocked = false;  // mlock() succeeded
+};
@@ -0,0 +1,156 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file SeedHex.cpp
+ * @brief Single-pass validation and decoding of hex seeds
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "SeedHex.h"
+
+#include <algorithm>
+
+#include "../ArgParser/crypto-encode/hex.h"
+
+
+/**
+ * Decodes one hex digit
+ * @param c character
+ * @return value of the digit, -1 if c is not a hex digit
+ */
+static int hexDigitValue(char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+
+/**
+ * Decoder state carried across characters and blocks
+ */
+struct SeedHexState {
+    SeedHexSyntax syntax = SeedHexSyntax::Strict;
+    size_t bytes = 0;  // complete bytes written
+    int highNibble = -1;  // first digit of the current byte, -1 between bytes
+};
+
+
+/**
+ * Consumes one character
+ * @param c character
+ * @param column 1-based column of c
+ * @param state decoder state
+ * @param out seed buffer
+ * @param result filled on error
+ * @return false on error
+ */
+static bool decodeCharacter(char c, size_t column, SeedHexState *state, uint8_t *out, SeedHexResult *result) {
+    const int value = hexDigitValue(c);
+    if (value >= 0) {
+        if (state->highNibble < 0) {
+            if (state->bytes == SEED_MAX_BYTES) {
+                *result = {SeedHexStatus::TooLong, column, state->bytes};
+                return false;
+            }
+            state->highNibble = value;
+        }
+        else {
+            out[state->bytes++] = static_cast<uint8_t>(state->highNibble << 4 | value);
+            state->highNibble = -1;
+        }
+        return true;
+    }
+
+    if (state->syntax == SeedHexSyntax::Lenient && (c == ' ' || (c >= '\t' && c <= '\r')))
+        return true;
+    if (c == ' ' || c == '\t') {
+        // separators are allowed between bytes only
+        if (state->highNibble < 0 && state->bytes > 0)
+            return true;
+        *result = {SeedHexStatus::MisplacedWhitespace, column, state->bytes};
+        return false;
+    }
+
+    *result = {SeedHexStatus::InvalidCharacter, column, state->bytes};
+    return false;
+}
+
+
+/**
+ * Validates and decodes a hex seed in one pass
+ *
+ * The seed is a sequence of bytes written as two hex digits each (either case), optionally separated
+ * by spaces and tabs after a byte; 16 to 64 bytes are accepted. The lenient syntax skips any
+ * whitespace anywhere instead. Every run of hex digits that starts a byte goes through the SIMD hex
+ * decoder (safeheron::encode::hex::DecodeFromHex), which stops at the first character that is not a
+ * hex digit; that character, and a digit left without its pair, go through the per-character
+ * grammar, so the first error is always reported with its exact column.
+ *
+ * @param input seed line
+ * @param length number of characters
+ * @param out decoded seed, SEED_MAX_BYTES bytes
+ * @param syntax where whitespace is accepted
+ * @return status, column of the first offending character and number of decoded bytes
+ */
+SeedHexResult decodeSeedHex(const char *input, size_t length, uint8_t out[SEED_MAX_BYTES], SeedHexSyntax syntax) {
+    SeedHexState state;
+    state.syntax = syntax;
+    SeedHexResult result;
+    size_t i = 0;
+
+    while (i < length) {
+        if (state.highNibble < 0) {
+            // whole bytes up to the next separator or error, never more than the seed can hold
+            const size_t window = std::min(length - i, 2 * (SEED_MAX_BYTES - state.bytes));
+            size_t size = 0;
+            safeheron::encode::hex::DecodeFromHex(std::string_view(input + i, window), out + state.bytes,
+                                                  SEED_MAX_BYTES - state.bytes, &size);
+            state.bytes += size;
+            i += 2 * size;
+            if (i == length)
+                break;
+        }
+        if (!decodeCharacter(input[i], i + 1, &state, out, &result))
+            return result;
+        i++;
+    }
+
+    if (state.highNibble >= 0)
+        return {SeedHexStatus::OddLength, length, state.bytes};
+    if (state.bytes < SEED_MIN_BYTES)
+        return {SeedHexStatus::TooShort, 0, state.bytes};
+    result.size = state.bytes;
+    return result;
+}
+
+
+/**
+ * Describes a failed decodeSeedHex call
+ * @param result result of decodeSeedHex
+ * @return message without the "[ERROR]: function:" prefix
+ */
+std::string seedHexErrorMessage(const SeedHexResult &result) {
+    const std::string column = " at column " + std::to_string(result.column);
+    switch (result.status) {
+        case SeedHexStatus::Ok:
+            return "valid seed";
+        case SeedHexStatus::InvalidCharacter:
+            return "invalid characters in seed" + column;
+        case SeedHexStatus::MisplacedWhitespace:
+            return "whitespace inside a seed byte" + column;
+        case SeedHexStatus::OddLength:
+            return "seed length out of range, odd number of hex digits" + column;
+        case SeedHexStatus::TooShort:
+            return "seed length out of range, " + std::to_string(result.size) + " bytes (at least " +
+                   std::to_string(SEED_MIN_BYTES) + ")";
+        case SeedHexStatus::TooLong:
+            return "seed length out of range, more than " + std::to_string(SEED_MAX_BYTES) + " bytes" + column;
+    }
+    return "invalid seed";
+}
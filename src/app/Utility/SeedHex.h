@@ -0,0 +1,54 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file SeedHex.h
+ * @brief Single-pass validation and decoding of hex seeds
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+/** Shortest accepted seed in bytes (BIP32 recommends at least 128 bits). */
+const size_t SEED_MIN_BYTES = 16;
+
+/** Longest accepted seed in bytes. */
+const size_t SEED_MAX_BYTES = 64;
+
+/**
+ * Where decodeSeedHex accepts whitespace
+ */
+enum class SeedHexSyntax {
+    Strict,  // spaces and tabs after a complete byte only, as in the derive-key argument grammar
+    Lenient,  // any whitespace anywhere is skipped
+};
+
+/**
+ * Outcome of decodeSeedHex
+ */
+enum class SeedHexStatus {
+    Ok,
+    InvalidCharacter,  // neither a hex digit nor accepted whitespace
+    MisplacedWhitespace,  // strict syntax: space or tab at the start or between the two digits of a byte
+    OddLength,  // the last byte has a single digit
+    TooShort,  // fewer than SEED_MIN_BYTES bytes
+    TooLong,  // more than SEED_MAX_BYTES bytes
+};
+
+/**
+ * Result of decodeSeedHex
+ */
+struct SeedHexResult {
+    SeedHexStatus status = SeedHexStatus::Ok;
+    size_t column = 0;  // 1-based column of the offending character, 0 if the error has none
+    size_t size = 0;  // number of decoded bytes
+};
+
+SeedHexResult decodeSeedHex(const char *input, size_t length, uint8_t out[SEED_MAX_BYTES], SeedHexSyntax syntax = SeedHexSyntax::Strict);
+std::string seedHexErrorMessage(const SeedHexResult &result);
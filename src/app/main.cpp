@@ -4,11 +4,8 @@
 #include "ScriptExpression/ScriptExpression.h"
 #include "KeyExpression/KeyExpression.h"
 #include "DeriveKey/DeriveKey.h"
-
-extern "C"
-{
-#include <btc/ecc.h>
-}
+#include "ChildSearch/ChildSearch.h"
+#include "Scan/Scan.h"
 
 /**
  * Prints the explanatory string of an exception. If the exception is nested, recurses to print the explanatory string of the exception it holds.
@@ -34,8 +31,7 @@ void print_exception(const std::exception &ex, int level = 0)
 
 int main(int argc, char *argv[])
 {
-    btc_ecc_start();
-
+    // The secp256k1 context is started by the first EC operation, see EccContextPool
     ArgParser argParser;
 
     try
@@ -51,17 +47,59 @@ int main(int argc, char *argv[])
 
     if (argParser.argExists("derive-key"))
     {
-        deriveKey(argParser.getArgValues(), argParser.getFilepath());
+        DeriveKeyOptions options;
+        options.mnemonic = argParser.getMnemonicFlag();
+        options.passphrase = argParser.getPassphrase();
+        options.threads = argParser.getThreadCount();
+        options.publicOnly = argParser.getPublicOnlyFlag();
+        options.privateOnly = argParser.getPrivateOnlyFlag();
+        options.format = argParser.getFormat();
+        options.origin = argParser.getOriginFlag();
+        options.cacheFile = argParser.getCacheFile();
+        options.cachePrivateKeys = !argParser.getCacheNoPrivateFlag();
+        deriveKey(argParser.getArgValues(), argParser.getFilepath(), options);
     }
     else if (argParser.argExists("key-expression"))
     {
-        runKeyExpression(argParser.getArgValues());
+        runKeyExpression(argParser.getArgValues(), argParser.getFormat());
     }
     else if (argParser.argExists("script-expression"))
     {
-        ScriptExpression scriptExpression(argParser.getArgValues(), argParser.getComputeChecksumFlag(), argParser.getVerifyChecksumFlag());
+        ScriptExpression scriptExpression(argParser.getArgValues(), argParser.getComputeChecksumFlag(), argParser.getVerifyChecksumFlag(), argParser.getFormat());
         scriptExpression.parse();
     }
-    btc_ecc_stop();
+    else if (argParser.argExists("find-child"))
+    {
+        ChildSearchOptions options;
+        options.pathTemplate = argParser.getFilepath();
+        options.range = argParser.getRange();
+        options.threads = argParser.getThreadCount();
+        options.format = argParser.getFormat();
+        try
+        {
+            runChildSearch(argParser.getArgValues().front(), argParser.getTargetsFile(), options);
+        }
+        catch (const std::exception &ex)
+        {
+            print_exception(ex);
+            return 1;
+        }
+    }
+    else if (argParser.argExists("scan"))
+    {
+        ScanOptions options;
+        options.gap = argParser.getGap();
+        options.threads = argParser.getThreadCount();
+        options.format = argParser.getFormat();
+        try
+        {
+            runScan(argParser.getArgValues(), argParser.getUsedFile(), options);
+        }
+        catch (const std::exception &ex)
+        {
+            print_exception(ex);
+            return 1;
+        }
+    }
     return 0;
 }
@@ -0,0 +1,136 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file Base58Bench.cpp
+ * @brief Throughput of the generic base58 and base58check codecs at WIF and extended key lengths,
+ *        including the batch base58check decoder
+ * @date 2026-10-18
+ *
+ * A compressed WIF private key is a 34-byte payload (version, key, compression flag) plus a 4-byte
+ * checksum, 52 characters; an extended key is 78 + 4 bytes, 111 characters.
+ * Usage: Base58Bench [iterations]
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../app/ArgParser/crypto-encode/base58.h"
+#include "../app/ArgParser/crypto-encode/base58_imp.h"
+
+
+/** Number of timed calls per case when no count is given. */
+static const int DEFAULT_ITERATIONS = 200000;
+
+/** Number of distinct inputs cycled through, so that no result can be hoisted out of the loop. */
+static const size_t INPUT_COUNT = 64;
+
+using namespace safeheron::encode::base58;
+
+
+/**
+ * Builds pseudo-random payloads of one length
+ * @param length payload length in bytes
+ * @param version version bytes the payloads start with
+ * @return INPUT_COUNT payloads
+ */
+static std::vector<std::vector<unsigned char>> makePayloads(size_t length, const std::vector<unsigned char> &version) {
+    std::vector<std::vector<unsigned char>> payloads(INPUT_COUNT, std::vector<unsigned char>(length));
+    uint32_t state = 0x2b7e1516;
+    for (auto &payload : payloads) {
+        for (auto &byte : payload) {
+            state = state * 1664525 + 1013904223;
+            byte = static_cast<unsigned char>(state >> 24);
+        }
+        std::copy(version.begin(), version.end(), payload.begin());
+    }
+    return payloads;
+}
+
+
+/**
+ * Times a function over the inputs and prints nanoseconds per input
+ * @param name case label
+ * @param iterations number of calls
+ * @param call function taking the input index and returning a value that depends on the result
+ * @param inputsPerCall number of inputs one call processes
+ */
+template<typename Call>
+static void measure(const char *name, int iterations, Call call, size_t inputsPerCall = 1) {
+    size_t sink = 0;
+    for (size_t i = 0; i < INPUT_COUNT; i++)
+        sink += call(i);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+        sink += call(static_cast<size_t>(i) % INPUT_COUNT);
+    const auto end = std::chrono::steady_clock::now();
+
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations / inputsPerCall;
+    printf("%-32s %10.1f ns/input  (checksum %zu)\n", name, ns, sink & 0xffff);
+}
+
+
+/**
+ * Measures encode, decode and their checksummed variants for one payload length
+ * @param label length label
+ * @param payloadLength payload length without the checksum
+ * @param version version bytes of the payloads
+ * @param iterations number of calls per case
+ */
+static void benchLength(const char *label, size_t payloadLength, const std::vector<unsigned char> &version, int iterations) {
+    const auto payloads = makePayloads(payloadLength, version);
+    std::vector<std::vector<unsigned char>> withChecksum;
+    std::vector<std::string> encoded, encodedCheck;
+    for (const auto &payload : payloads) {
+        encodedCheck.push_back(_internal::EncodeBase58Check(payload));
+        std::vector<unsigned char> data;
+        _internal::DecodeBase58(encodedCheck.back(), data);
+        withChecksum.push_back(data);
+        encoded.push_back(_internal::EncodeBase58(data));
+    }
+    printf("%s: %zu + 4 bytes, %zu characters\n", label, payloadLength, encoded[0].size());
+
+    const std::string encodeName = std::string(label) + " EncodeBase58";
+    measure(encodeName.c_str(), iterations, [&](size_t i) {
+        return _internal::EncodeBase58(withChecksum[i]).size();
+    });
+    const std::string decodeName = std::string(label) + " DecodeBase58";
+    measure(decodeName.c_str(), iterations, [&](size_t i) {
+        std::vector<unsigned char> data;
+        return _internal::DecodeBase58(encoded[i], data) ? data.size() + data[5] : 0;
+    });
+    const std::string encodeCheckName = std::string(label) + " EncodeBase58Check";
+    measure(encodeCheckName.c_str(), iterations, [&](size_t i) {
+        return _internal::EncodeBase58Check(payloads[i]).size();
+    });
+    const std::string decodeCheckName = std::string(label) + " DecodeBase58Check";
+    measure(decodeCheckName.c_str(), iterations, [&](size_t i) {
+        std::vector<unsigned char> data;
+        return _internal::DecodeBase58Check(encodedCheck[i], data) ? data.size() + data[5] : 0;
+    });
+
+    const std::vector<std::string_view> views(encodedCheck.begin(), encodedCheck.end());
+    std::vector<unsigned char> out(INPUT_COUNT * payloadLength);
+    std::vector<size_t> sizes(INPUT_COUNT);
+    std::vector<Base58Status> statuses(INPUT_COUNT);
+    const std::string batchName = std::string(label) + " DecodeBase58CheckBatch";
+    measure(batchName.c_str(), std::max(1, iterations / static_cast<int>(INPUT_COUNT)), [&](size_t) {
+        DecodeFromBase58CheckBatch(views.data(), INPUT_COUNT, out.data(), payloadLength, sizes.data(), statuses.data());
+        return sizes[0] + out[5] + static_cast<size_t>(statuses[INPUT_COUNT - 1]);
+    }, INPUT_COUNT);
+}
+
+
+int main(int argc, char *argv[]) {
+    const int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : DEFAULT_ITERATIONS;
+    benchLength("WIF", 34, {0x80}, iterations);
+    benchLength("xkey", 78, {0x04, 0x88, 0xb2, 0x1e}, iterations);
+    return 0;
+}
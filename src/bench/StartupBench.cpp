@@ -0,0 +1,143 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file StartupBench.cpp
+ * @brief Cold-start latency of every bip380 sub-command
+ * @date 2026-10-18
+ *
+ * Every case spawns a fresh bip380 process, so the measured wall time covers process startup,
+ * argument parsing, the secp256k1 context (when the command needs one) and the command itself.
+ * Usage: StartupBench [binary] [runs]
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+
+/** Number of measured runs per case when no count is given. */
+static const int DEFAULT_RUNS = 50;
+
+static const std::string TV1_SEED = "000102030405060708090a0b0c0d0e0f";
+static const std::string TV1_XPUB = "xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8";
+static const std::string TV1_XPRV = "xprv9s21ZrQH143K3QTDL4LXw2F7HEK3wJUD2nW2nRk4stbPy6cq3jPPqjiChkVvvNKmPGJxWUtg6LnF5kejMRNNU3TGtRBeJgk33yuGBxrMPHi";
+static const std::string G_COMPRESSED = "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798";
+
+/**
+ * One measured command line
+ */
+struct BenchCase {
+    std::string name;  // label in the report
+    std::vector<std::string> args;  // arguments after the binary
+};
+
+
+/**
+ * Writes a temporary file
+ * @param contents file contents
+ * @return path of the file
+ */
+static std::string temporaryFile(const std::string &contents) {
+    char path[] = "/tmp/bip380-bench-XXXXXX";
+    const int fd = mkstemp(path);
+    if (fd < 0 || write(fd, contents.data(), contents.size()) != static_cast<ssize_t>(contents.size())) {
+        perror("temporary file");
+        exit(1);
+    }
+    close(fd);
+    return path;
+}
+
+
+/**
+ * Runs the binary once with stdin, stdout and stderr on /dev/null
+ * @param binary path of bip380
+ * @param args arguments
+ * @param status filled with the exit status
+ * @return wall time in milliseconds
+ */
+static double runOnce(const std::string &binary, const std::vector<std::string> &args, int *status) {
+    std::vector<char *> argv;
+    argv.push_back(const_cast<char *>(binary.c_str()));
+    for (const auto &arg : args)
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    const auto start = std::chrono::steady_clock::now();
+    pid_t pid;
+    if (posix_spawn(&pid, binary.c_str(), &actions, nullptr, argv.data(), environ) != 0) {
+        perror(binary.c_str());
+        exit(1);
+    }
+    waitpid(pid, status, 0);
+    const auto end = std::chrono::steady_clock::now();
+    posix_spawn_file_actions_destroy(&actions);
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+
+int main(int argc, char *argv[]) {
+    const std::string binary = argc > 1 ? argv[1] : "./bip380";
+    const int runs = argc > 2 ? std::max(1, atoi(argv[2])) : DEFAULT_RUNS;
+
+    const std::string targets = temporaryFile(G_COMPRESSED + "\n");
+    const std::string used = temporaryFile("");
+
+    const std::vector<BenchCase> cases = {
+            {"help", {"--help"}},
+            {"key-expression pubkey", {"key-expression", G_COMPRESSED}},
+            {"key-expression xpub", {"key-expression", TV1_XPUB + "/0/1"}},
+            {"key-expression xprv", {"key-expression", TV1_XPRV}},
+            {"script-expression raw", {"script-expression", "raw(deadbeef)"}},
+            {"script-expression checksum", {"script-expression", "--compute-checksum", "pkh(" + G_COMPRESSED + ")"}},
+            {"script-expression address", {"script-expression", "--format=address", "pkh(" + G_COMPRESSED + ")"}},
+            {"derive-key seed", {"derive-key", TV1_SEED}},
+            {"derive-key xpub path", {"derive-key", TV1_XPUB, "--path", "0/1"}},
+            {"find-child", {"find-child", TV1_XPUB, "--targets", targets, "--range", "8"}},
+            {"scan", {"scan", TV1_XPUB, "--used", used, "--gap", "1"}},
+    };
+
+    printf("%-28s %6s %10s %10s %10s\n", "case", "runs", "min ms", "median ms", "mean ms");
+    int failures = 0;
+    for (const auto &benchCase : cases) {
+        int status = 0;
+        runOnce(binary, benchCase.args, &status);  // warm the page cache
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            printf("%-28s failed with status %d\n", benchCase.name.c_str(), status);
+            failures++;
+            continue;
+        }
+
+        std::vector<double> times;
+        for (int i = 0; i < runs; i++)
+            times.push_back(runOnce(binary, benchCase.args, &status));
+        std::sort(times.begin(), times.end());
+        double total = 0;
+        for (double time : times)
+            total += time;
+        printf("%-28s %6d %10.3f %10.3f %10.3f\n", benchCase.name.c_str(), runs, times.front(), times[times.size() / 2],
+               total / times.size());
+    }
+
+    unlink(targets.c_str());
+    unlink(used.c_str());
+    return failures == 0 ? 0 : 1;
+}
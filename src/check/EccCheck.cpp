@@ -0,0 +1,160 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file EccCheck.cpp
+ * @brief Check of libbtc's secp256k1 scalar multiplication, run by `make check`
+ * @date 2026-10-18
+ *
+ * Fails if btc_ecc_get_pubkey, as linked from the installed libbtc, computes wrong points:
+ *  - k*G for known scalars is compared with the points from the secp256k1 specification,
+ *  - k*G is compared with G + (k-1)*G, computed by btc_ecc_public_key_tweak_add, for scalars that
+ *    together read every 4-bit digit at every window position of a 4-bit windowed multiplication.
+ *
+ * It only sees the results of the multiplication, not the precomputed tables of secp256k1.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+extern "C"
+{
+#include <btc/ecc.h>
+}
+
+
+/** Number of 4-bit windows of a 256-bit scalar, and of digits per window. */
+static const int SCALAR_WINDOWS = 64;
+static const int WINDOW_DIGITS = 16;
+
+/**
+ * Scalar with its expected compressed point
+ */
+struct KnownPoint {
+    const char *scalar;  // 32-byte big-endian scalar, hex
+    const char *point;  // compressed k*G, hex
+};
+
+static const KnownPoint KNOWN_POINTS[] = {
+        {"0000000000000000000000000000000000000000000000000000000000000001",
+         "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"},
+        {"0000000000000000000000000000000000000000000000000000000000000002",
+         "02c6047f9441ed7d6d3045406e95c07cd85c778e4b8cef3ca7abac09b95c709ee5"},
+        {"0000000000000000000000000000000000000000000000000000000000000003",
+         "02f9308a019258c31049344f85f89d5229b531c845836f99b08601f113bce036f9"},
+        {"fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140",
+         "0379be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"},
+};
+
+
+/**
+ * Encodes bytes as lowercase hex
+ * @param data bytes
+ * @param size number of bytes
+ * @return hex string
+ */
+static std::string toHex(const uint8_t *data, size_t size) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    for (size_t i = 0; i < size; i++) {
+        hex += digits[data[i] >> 4];
+        hex += digits[data[i] & 0xf];
+    }
+    return hex;
+}
+
+
+/**
+ * Decodes a 32-byte hex scalar
+ * @param hex 64 hex characters
+ * @param out scalar, big-endian
+ */
+static void scalarFromHex(const char *hex, uint8_t out[32]) {
+    for (int i = 0; i < 32; i++) {
+        unsigned value = 0;
+        sscanf(hex + 2 * i, "%2x", &value);
+        out[i] = static_cast<uint8_t>(value);
+    }
+}
+
+
+/**
+ * Builds a scalar whose window i (counted from the least significant nibble) holds the digit
+ * (i + shift) mod 16; the scalars for shift 0..15 read every digit at every window. The top
+ * nibbles are never both 0xf, so every such scalar is below the group order.
+ * @param shift digit rotation
+ * @param out scalar, big-endian
+ */
+static void windowScalar(int shift, uint8_t out[32]) {
+    for (int window = 0; window < SCALAR_WINDOWS; window++) {
+        const uint8_t digit = static_cast<uint8_t>((window + shift) % WINDOW_DIGITS);
+        uint8_t &byte = out[31 - window / 2];
+        byte = window % 2 == 0 ? digit : static_cast<uint8_t>(byte | digit << 4);
+    }
+}
+
+
+/**
+ * Computes k*G with btc_ecc_get_pubkey and as G + (k-1)*G with tweak_add and compares the points
+ * @param scalar k, big-endian, at least 2
+ * @param generator compressed G
+ * @return true if both points are equal
+ */
+static bool matchesTweakAdd(const uint8_t scalar[32], const uint8_t generator[33]) {
+    uint8_t tweak[32];
+    memcpy(tweak, scalar, sizeof(tweak));
+    // k - 1, borrowing through trailing zero bytes
+    for (int i = 31; i >= 0; i--) {
+        if (tweak[i]-- != 0)
+            break;
+    }
+
+    uint8_t product[BTC_ECKEY_COMPRESSED_LENGTH];
+    size_t length = sizeof(product);
+    btc_ecc_get_pubkey(scalar, product, &length, true);
+
+    uint8_t sum[BTC_ECKEY_COMPRESSED_LENGTH];
+    memcpy(sum, generator, sizeof(sum));
+    return btc_ecc_public_key_tweak_add(sum, tweak) && memcmp(product, sum, sizeof(sum)) == 0;
+}
+
+
+int main() {
+    btc_ecc_start();
+    int failures = 0;
+
+    for (const auto &known : KNOWN_POINTS) {
+        uint8_t scalar[32];
+        scalarFromHex(known.scalar, scalar);
+        uint8_t point[BTC_ECKEY_COMPRESSED_LENGTH];
+        size_t length = sizeof(point);
+        btc_ecc_get_pubkey(scalar, point, &length, true);
+        if (toHex(point, length) != known.point) {
+            fprintf(stderr, "[ERROR]: EccCheck: %s*G is %s, expected %s\n", known.scalar, toHex(point, length).c_str(), known.point);
+            failures++;
+        }
+    }
+
+    uint8_t one[32] = {0};
+    one[31] = 1;
+    uint8_t generator[BTC_ECKEY_COMPRESSED_LENGTH];
+    size_t length = sizeof(generator);
+    btc_ecc_get_pubkey(one, generator, &length, true);
+
+    for (int shift = 0; shift < WINDOW_DIGITS; shift++) {
+        uint8_t scalar[32];
+        windowScalar(shift, scalar);
+        if (!matchesTweakAdd(scalar, generator)) {
+            fprintf(stderr, "[ERROR]: EccCheck: %s*G differs from G + (k-1)*G\n", toHex(scalar, sizeof(scalar)).c_str());
+            failures++;
+        }
+    }
+
+    btc_ecc_stop();
+    if (failures != 0)
+        return 1;
+    printf("EccCheck: scalar multiplication matches known points and tweak_add\n");
+    return 0;
+}
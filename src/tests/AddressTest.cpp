@@ -0,0 +1,110 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file AddressTest.cpp
+ * @brief GTest unit tests for base58check addresses of public keys and script expressions
+ * @date 2026-10-18
+ *
+ * The batched encoder is checked against the generic Base58Check encoder, and the
+ * descriptor addresses against known P2PKH and P2SH addresses.
+ *
+ * © 2025
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "../app/Utility/Address.h"
+#include "../app/ScriptExpression/DescriptorAddress.h"
+#include "../app/ArgParser/crypto-encode/base58.h"
+#include "../app/ArgParser/crypto-encode/hex.h"
+#include "../app/ArgParser/crypto-hash/hash160.h"
+
+static const std::string G_COMPRESSED = "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798";
+static const std::string G_UNCOMPRESSED = "0479be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"
+                                          "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8";
+static const std::string TV1_XPRV = "xprv9s21ZrQH143K3QTDL4LXw2F7HEK3wJUD2nW2nRk4stbPy6cq3jPPqjiChkVvvNKmPGJxWUtg6LnF5kejMRNNU3TGtRBeJgk33yuGBxrMPHi";
+static const std::string TV1_XPUB = "xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8";
+
+/**
+ * Decodes a hex string to bytes.
+ */
+static std::vector<uint8_t> fromHex(const std::string &hex)
+{
+    const std::string bytes = safeheron::encode::hex::DecodeFromHex(hex);
+    return std::vector<uint8_t>(bytes.begin(), bytes.end());
+}
+
+/**
+ * @test P2PKH addresses of the generator point, compressed and uncompressed.
+ */
+TEST(AddressTest, P2PKHKnownVectors)
+{
+    const std::vector<uint8_t> compressed = fromHex(G_COMPRESSED);
+    const std::vector<uint8_t> uncompressed = fromHex(G_UNCOMPRESSED);
+    EXPECT_EQ(p2pkhAddress(compressed.data(), compressed.size()), "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH");
+    EXPECT_EQ(p2pkhAddress(uncompressed.data(), uncompressed.size()), "1EHNa6Q4Jz2uvNExL497mE43ikXhwF6kZm");
+}
+
+/**
+ * @test The batched encoder matches HASH160 followed by the generic Base58Check encoder for every batch size.
+ */
+TEST(AddressTest, BatchMatchesGenericEncoder)
+{
+    uint32_t state = 7;
+    for (size_t count = 1; count <= 20; count++)
+    {
+        std::vector<uint8_t> keys(count * 33);
+        for (auto &byte : keys)
+        {
+            state = state * 1103515245 + 12345;
+            byte = (uint8_t)(state >> 16);
+        }
+        std::vector<char> addresses(count * ADDRESS_BUFFER_SIZE);
+        encodeAddressBatch(P2SH_ADDRESS_VERSION, keys.data(), 33, count, addresses.data());
+
+        for (size_t i = 0; i < count; i++)
+        {
+            unsigned char payload[ADDRESS_PAYLOAD_SIZE];
+            payload[0] = P2SH_ADDRESS_VERSION;
+            safeheron::hash::Hash160(payload + 1, keys.data() + 33 * i, 33);
+            EXPECT_EQ(std::string(addresses.data() + i * ADDRESS_BUFFER_SIZE),
+                      safeheron::encode::base58::EncodeToBase58Check(payload, sizeof(payload)))
+                << "count " << count << ", key " << i;
+        }
+    }
+}
+
+/**
+ * @test Addresses of pkh() and sh() expressions with hex, WIF and extended keys.
+ */
+TEST(AddressTest, DescriptorAddresses)
+{
+    EXPECT_EQ(descriptorAddress("pkh(" + G_COMPRESSED + ")"), "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH");
+    EXPECT_EQ(descriptorAddress("pkh( [d34db33f/44h/0h/0h]" + G_COMPRESSED + " )"), "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH");
+    EXPECT_EQ(descriptorAddress("pkh(5KYZdUEo39z3FPrtuX2QbbwGnNP5zTd7yyr2SC1j299sBCnWjss)"), "1HZwkjkeaoZfTSaJxDw6aKkxp45agDiEzN");
+    EXPECT_EQ(descriptorAddress("pkh(" + TV1_XPRV + ")"), "15mKKb2eos1hWa6tisdPwwDC1a5J1y9nma");
+    EXPECT_EQ(descriptorAddress("pkh(" + TV1_XPRV + "/0h/1)"), "1JQheacLPdM5ySCkrZkV66G2ApAXe1mqLj");
+    EXPECT_EQ(descriptorAddress("sh(pk(" + G_COMPRESSED + "))"), "34wjDxkCQrUPYwnCRtap5uib6XNcVaud9K");
+    EXPECT_EQ(descriptorAddress("sh(multi(1,022f8bde4d1a07209355b4a7250a5c5128e88b84bddc619ab7cba8d569b240efe4,"
+                                "025cbdf0646e5db4eaa398f365f2ea7a0e3d419b7e0330e39ce92bddedcac4f9bc))"),
+              "3ETTzkMnuA4PguZeWYtdCT6Rva3yTHATyP");
+
+    // sh(pkh(KEY)) hashes the P2PKH script of the key.
+    const std::vector<uint8_t> script = redeemScript("pkh(" + G_COMPRESSED + ")");
+    ASSERT_EQ(script.size(), 25u);
+    EXPECT_EQ(descriptorAddress("sh(pkh(" + G_COMPRESSED + "))"), p2shAddress(script.data(), script.size()));
+}
+
+/**
+ * @test Expressions without a single address are rejected.
+ */
+TEST(AddressTest, DescriptorWithoutAddress)
+{
+    EXPECT_THROW(descriptorAddress("pk(" + G_COMPRESSED + ")"), std::invalid_argument);
+    EXPECT_THROW(descriptorAddress("multi(1," + G_COMPRESSED + ")"), std::invalid_argument);
+    EXPECT_THROW(descriptorAddress("raw(deadbeef)"), std::invalid_argument);
+    EXPECT_THROW(descriptorAddress("pkh(" + TV1_XPUB + "/0/*)"), std::invalid_argument);
+    EXPECT_THROW(descriptorAddress("pkh(" + TV1_XPUB + "/0h)"), std::invalid_argument);
+    EXPECT_THROW(descriptorAddress("sh(multi(2," + G_COMPRESSED + "))"), std::invalid_argument);
+}
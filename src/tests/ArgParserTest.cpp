@@ -14,9 +14,11 @@
 
 #include <gtest/gtest.h>
 #include "../app/ArgParser/ArgParser.h"
+#include "../app/Scan/Scan.h"
 #include <stdexcept>
 #include <vector>
 #include <string>
+#include <utility>
 
 /**
  * Tests whether the arguments are correctly detected.
@@ -313,6 +315,252 @@ TEST(ArgParserTest, DeriveKeyWithPath) {
                     });
 }
 
+/**
+ * Test the --mnemonic and --passphrase options of "derive-key".
+ */
+TEST(ArgParserTest, DeriveKeyWithMnemonic) {
+    std::vector<std::string> args = {
+            "bip380",
+            "derive-key",
+            "--mnemonic",
+            "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about",
+            "--passphrase",
+            "TREZOR"
+    };
+    auto argv = makeArgv(args);
+
+    ArgParser parser;
+    parser.loadArguments(static_cast<int>(argv.size()), argv.data());
+    EXPECT_NO_THROW(parser.parse());
+    EXPECT_TRUE(parser.getMnemonicFlag());
+    EXPECT_EQ(parser.getPassphrase(), "TREZOR");
+    EXPECT_EQ(parser.getArgValues().size(), 1u);
+}
+
+/**
+ * Mnemonics with an unsupported word count or characters are rejected, and so is a passphrase without --mnemonic.
+ */
+TEST(ArgParserTest, DeriveKeyInvalidMnemonicThrows) {
+    const std::vector<std::vector<std::string>> cases = {
+            {"bip380", "derive-key", "--mnemonic", "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about"},
+            {"bip380", "derive-key", "--mnemonic", "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon About"},
+            {"bip380", "derive-key", "--passphrase", "TREZOR", "000102030405060708090a0b0c0d0e0f"},
+            {"bip380", "derive-key", "--mnemonic", "--mnemonic", "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about"},
+    };
+
+    for (const auto &args : cases) {
+        auto argv = makeArgv(args);
+        EXPECT_THROW({
+                         ArgParser parser;
+                         parser.loadArguments(static_cast<int>(argv.size()), argv.data());
+                         parser.parse();
+                     }, std::invalid_argument);
+    }
+}
+
+/**
+ * --threads accepts a decimal count up to the limit, 0 selects one thread per CPU.
+ */
+TEST(ArgParserTest, DeriveKeyThreads) {
+    std::vector<std::string> args = {"bip380", "derive-key", "--threads", "8", "000102030405060708090a0b0c0d0e0f"};
+    auto argv = makeArgv(args);
+
+    ArgParser parser;
+    parser.loadArguments(static_cast<int>(argv.size()), argv.data());
+    EXPECT_NO_THROW(parser.parse());
+    EXPECT_EQ(parser.getThreadCount(), 8u);
+
+    const std::vector<std::vector<std::string>> invalid = {
+            {"bip380", "derive-key", "--threads", "x", "000102030405060708090a0b0c0d0e0f"},
+            {"bip380", "derive-key", "--threads", "257", "000102030405060708090a0b0c0d0e0f"},
+            {"bip380", "derive-key", "--threads", "1", "--threads", "2", "000102030405060708090a0b0c0d0e0f"},
+    };
+    for (const auto &invalidArgs : invalid) {
+        auto invalidArgv = makeArgv(invalidArgs);
+        EXPECT_THROW({
+                         ArgParser invalidParser;
+                         invalidParser.loadArguments(static_cast<int>(invalidArgv.size()), invalidArgv.data());
+                         invalidParser.parse();
+                     }, std::invalid_argument);
+    }
+}
+
+/**
+ * --public-only and --private-only are accepted on their own but not together.
+ */
+TEST(ArgParserTest, DeriveKeyPublicOnlyPrivateOnly) {
+    std::vector<std::string> args = {"bip380", "derive-key", "--public-only", "000102030405060708090a0b0c0d0e0f"};
+    auto argv = makeArgv(args);
+
+    ArgParser parser;
+    parser.loadArguments(static_cast<int>(argv.size()), argv.data());
+    EXPECT_NO_THROW(parser.parse());
+    EXPECT_TRUE(parser.getPublicOnlyFlag());
+    EXPECT_FALSE(parser.getPrivateOnlyFlag());
+
+    std::vector<std::string> bothArgs = {"bip380", "derive-key", "--public-only", "--private-only", "000102030405060708090a0b0c0d0e0f"};
+    auto bothArgv = makeArgv(bothArgs);
+    ArgParser bothParser;
+    bothParser.loadArguments(static_cast<int>(bothArgv.size()), bothArgv.data());
+    EXPECT_THROW(bothParser.parse(), std::invalid_argument);
+}
+
+/**
+ * --format= accepts text, bin, ndjson and address, once.
+ */
+TEST(ArgParserTest, DeriveKeyFormat) {
+    const std::vector<std::pair<std::string, OutputFormat>> valid = {
+            {"--format=text", OutputFormat::Text},
+            {"--format=bin", OutputFormat::Binary},
+            {"--format=ndjson", OutputFormat::Ndjson},
+            {"--format=address", OutputFormat::Address},
+    };
+    for (const auto &format : valid) {
+        std::vector<std::string> args = {"bip380", "derive-key", format.first, "000102030405060708090a0b0c0d0e0f"};
+        auto argv = makeArgv(args);
+
+        ArgParser parser;
+        parser.loadArguments(static_cast<int>(argv.size()), argv.data());
+        EXPECT_NO_THROW(parser.parse()) << format.first;
+        EXPECT_EQ(parser.getFormat(), format.second) << format.first;
+    }
+
+    const std::vector<std::vector<std::string>> invalid = {
+            {"bip380", "derive-key", "--format=xml", "000102030405060708090a0b0c0d0e0f"},
+            {"bip380", "derive-key", "--format=", "000102030405060708090a0b0c0d0e0f"},
+            {"bip380", "derive-key", "--format=bin", "--format=text", "000102030405060708090a0b0c0d0e0f"},
+    };
+    for (const auto &invalidArgs : invalid) {
+        auto invalidArgv = makeArgv(invalidArgs);
+        EXPECT_THROW({
+                         ArgParser invalidParser;
+                         invalidParser.loadArguments(static_cast<int>(invalidArgv.size()), invalidArgv.data());
+                         invalidParser.parse();
+                     }, std::invalid_argument);
+    }
+}
+
+/**
+ * Test derive-key --origin, which cannot be combined with binary output or given twice.
+ */
+TEST(ArgParserTest, DeriveKeyOrigin) {
+    std::vector<std::string> args = {"bip380", "derive-key", "--origin", "--format=ndjson", "000102030405060708090a0b0c0d0e0f"};
+    auto argv = makeArgv(args);
+
+    ArgParser parser;
+    parser.loadArguments(static_cast<int>(argv.size()), argv.data());
+    EXPECT_NO_THROW(parser.parse());
+    EXPECT_TRUE(parser.getOriginFlag());
+
+    const std::vector<std::vector<std::string>> invalid = {
+            {"bip380", "derive-key", "--origin", "--format=bin", "000102030405060708090a0b0c0d0e0f"},
+            {"bip380", "derive-key", "--origin", "--origin", "000102030405060708090a0b0c0d0e0f"},
+    };
+    for (const auto &invalidArgs : invalid) {
+        auto invalidArgv = makeArgv(invalidArgs);
+        EXPECT_THROW({
+                         ArgParser invalidParser;
+                         invalidParser.loadArguments(static_cast<int>(invalidArgv.size()), invalidArgv.data());
+                         invalidParser.parse();
+                     }, std::invalid_argument);
+    }
+}
+
+/**
+ * Test --format=address, accepted by derive-key and script-expression only.
+ */
+TEST(ArgParserTest, AddressFormat) {
+    const std::vector<std::vector<std::string>> valid = {
+            {"bip380", "derive-key", "--format=address", "000102030405060708090a0b0c0d0e0f"},
+            {"bip380", "derive-key", "--format=address", "--public-only", "000102030405060708090a0b0c0d0e0f"},
+            {"bip380", "script-expression", "--format=address", "pkh(0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798)"},
+    };
+    for (const auto &validArgs : valid) {
+        auto validArgv = makeArgv(validArgs);
+        ArgParser parser;
+        parser.loadArguments(static_cast<int>(validArgv.size()), validArgv.data());
+        EXPECT_NO_THROW(parser.parse());
+        EXPECT_EQ(parser.getFormat(), OutputFormat::Address);
+    }
+
+    const std::vector<std::vector<std::string>> invalid = {
+            {"bip380", "derive-key", "--format=address", "--origin", "000102030405060708090a0b0c0d0e0f"},
+            {"bip380", "derive-key", "--format=address", "--private-only", "000102030405060708090a0b0c0d0e0f"},
+            {"bip380", "script-expression", "--format=address", "--compute-checksum", "pkh(0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798)"},
+            {"bip380", "key-expression", "--format=address", "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"},
+    };
+    for (const auto &invalidArgs : invalid) {
+        auto invalidArgv = makeArgv(invalidArgs);
+        EXPECT_THROW({
+                         ArgParser invalidParser;
+                         invalidParser.loadArguments(static_cast<int>(invalidArgv.size()), invalidArgv.data());
+                         invalidParser.parse();
+                     }, std::invalid_argument);
+    }
+}
+
+/**
+ * Test find-child arguments: targets file, path template, range and format.
+ */
+TEST(ArgParserTest, FindChild) {
+    const std::string xpub = "xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8";
+    std::vector<std::string> args = {"bip380", "find-child", xpub, "--targets", "targets.txt", "--path", "0/*/1", "--range", "2147483648", "--format=ndjson"};
+    auto argv = makeArgv(args);
+
+    ArgParser parser;
+    parser.loadArguments(static_cast<int>(argv.size()), argv.data());
+    EXPECT_NO_THROW(parser.parse());
+    EXPECT_EQ(parser.getTargetsFile(), "targets.txt");
+    EXPECT_EQ(parser.getFilepath(), "0/*/1");
+    EXPECT_EQ(parser.getRange(), 2147483648u);
+    EXPECT_EQ(parser.getFormat(), OutputFormat::Ndjson);
+
+    const std::vector<std::vector<std::string>> invalid = {
+            {"bip380", "find-child", xpub},
+            {"bip380", "find-child", xpub, "--targets", "t.txt", "--path", "0/1"},
+            {"bip380", "find-child", xpub, "--targets", "t.txt", "--path", "0h/*"},
+            {"bip380", "find-child", xpub, "--targets", "t.txt", "--range", "0"},
+            {"bip380", "find-child", xpub, "--targets", "t.txt", "--range", "2147483649"},
+            {"bip380", "find-child", xpub, "--targets", "t.txt", "--format=bin"},
+            {"bip380", "find-child", "xprv9s21ZrQH143K3QTDL4LXw2F7HEK3wJUD2nW2nRk4stbPy6cq3jPPqjiChkVvvNKmPGJxWUtg6LnF5kejMRNNU3TGtRBeJgk33yuGBxrMPHi", "--targets", "t.txt"},
+    };
+    for (const auto &invalidArgs : invalid) {
+        auto invalidArgv = makeArgv(invalidArgs);
+        EXPECT_THROW({
+                         ArgParser invalidParser;
+                         invalidParser.loadArguments(static_cast<int>(invalidArgv.size()), invalidArgv.data());
+                         invalidParser.parse();
+                     }, std::invalid_argument);
+    }
+}
+
+/**
+ * Test derive-key --cache and --cache-no-private.
+ */
+TEST(ArgParserTest, DeriveKeyCache) {
+    std::vector<std::string> args = {"bip380", "derive-key", "--cache", "nodes.cache", "--cache-no-private", "--path", "84h/0h/0h", "000102030405060708090a0b0c0d0e0f"};
+    auto argv = makeArgv(args);
+
+    ArgParser parser;
+    parser.loadArguments(static_cast<int>(argv.size()), argv.data());
+    EXPECT_NO_THROW(parser.parse());
+    EXPECT_EQ(parser.getCacheFile(), "nodes.cache");
+    EXPECT_TRUE(parser.getCacheNoPrivateFlag());
+
+    const std::vector<std::vector<std::string>> invalid = {
+            {"bip380", "derive-key", "--cache-no-private", "000102030405060708090a0b0c0d0e0f"},
+            {"bip380", "derive-key", "--cache", "a", "--cache", "b", "000102030405060708090a0b0c0d0e0f"},
+    };
+    for (const auto &invalidArgs : invalid) {
+        auto invalidArgv = makeArgv(invalidArgs);
+        EXPECT_THROW({
+                         ArgParser invalidParser;
+                         invalidParser.loadArguments(static_cast<int>(invalidArgv.size()), invalidArgv.data());
+                         invalidParser.parse();
+                     }, std::invalid_argument);
+    }
+}
+
 /**
  * Example test verifying that argExists() behaves as expected.
  * Checks directly argExists(), not parse().
@@ -886,4 +1134,46 @@ TEST(ArgParserTest, dangerousArgc) {
                      parser.loadArguments(argc, const_cast<char **>(argv));
                  }, std::invalid_argument);
 }
- */
\ No newline at end of file
+ */
+
+/**
+ * Test scan arguments: used file, gap limit, descriptors and format.
+ */
+TEST(ArgParserTest, Scan) {
+    const std::string xpub = "xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8";
+    std::vector<std::string> args = {"bip380", "scan", "pkh(" + xpub + "/0/*)", "--used", "used.txt", "--gap", "100", "--threads", "2", "--format=ndjson"};
+    auto argv = makeArgv(args);
+
+    ArgParser parser;
+    parser.loadArguments(static_cast<int>(argv.size()), argv.data());
+    EXPECT_NO_THROW(parser.parse());
+    EXPECT_EQ(parser.getUsedFile(), "used.txt");
+    EXPECT_EQ(parser.getGap(), 100u);
+    EXPECT_EQ(parser.getThreadCount(), 2u);
+    EXPECT_EQ(parser.getFormat(), OutputFormat::Ndjson);
+
+    std::vector<std::string> defaults = {"bip380", "scan", xpub, "--used", "used.txt"};
+    auto defaultsArgv = makeArgv(defaults);
+    ArgParser defaultsParser;
+    defaultsParser.loadArguments(static_cast<int>(defaultsArgv.size()), defaultsArgv.data());
+    EXPECT_NO_THROW(defaultsParser.parse());
+    EXPECT_EQ(defaultsParser.getGap(), DEFAULT_SCAN_GAP);
+
+    const std::vector<std::vector<std::string>> invalid = {
+            {"bip380", "scan", xpub},
+            {"bip380", "scan", xpub, "--used", "used.txt", "--gap", "0"},
+            {"bip380", "scan", xpub, "--used", "used.txt", "--gap", "100001"},
+            {"bip380", "scan", xpub, "--used", "used.txt", "--format=bin"},
+            {"bip380", "scan", xpub + "/0", "--used", "used.txt"},
+            {"bip380", "scan", xpub, xpub, "--used", "used.txt"},
+            {"bip380", "scan", xpub, "--used", "a.txt", "--used", "b.txt"},
+    };
+    for (const auto &invalidArgs : invalid) {
+        auto invalidArgv = makeArgv(invalidArgs);
+        EXPECT_THROW({
+                         ArgParser invalidParser;
+                         invalidParser.loadArguments(static_cast<int>(invalidArgv.size()), invalidArgv.data());
+                         invalidParser.parse();
+                     }, std::invalid_argument);
+    }
+}
@@ -0,0 +1,249 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file Base58Test.cpp
+ * @brief GTest unit tests for the limb-based generic base58 codec and its buffer-based API
+ * @date 2026-10-18
+ *
+ * The codec is compared with the byte-at-a-time implementation it replaced (kept below as the
+ * reference) on random inputs, including lengths beyond the stack buffers.
+ *
+ * © 2025
+ */
+
+#include <gtest/gtest.h>
+#include <cctype>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../app/ArgParser/crypto-encode/base58.h"
+#include "../app/ArgParser/crypto-encode/base58_imp.h"
+
+using namespace safeheron::encode::base58;
+
+static const char *BASE58_ALPHABET = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+/**
+ * Reference encoder: "b58 = b58 * 256 + byte" one byte and one digit at a time.
+ */
+static std::string referenceEncode(const std::vector<unsigned char> &data)
+{
+    size_t zeroes = 0;
+    while (zeroes < data.size() && data[zeroes] == 0)
+        zeroes++;
+    std::vector<unsigned char> b58((data.size() - zeroes) * 138 / 100 + 1);
+    size_t length = 0;
+    for (size_t k = zeroes; k < data.size(); k++)
+    {
+        int carry = data[k];
+        size_t i = 0;
+        for (auto it = b58.rbegin(); (carry != 0 || i < length) && it != b58.rend(); ++it, ++i)
+        {
+            carry += 256 * (*it);
+            *it = carry % 58;
+            carry /= 58;
+        }
+        length = i;
+    }
+    auto it = b58.begin() + (b58.size() - length);
+    while (it != b58.end() && *it == 0)
+        it++;
+    std::string str(zeroes, '1');
+    while (it != b58.end())
+        str += BASE58_ALPHABET[*(it++)];
+    return str;
+}
+
+/**
+ * Reference decoder: "b256 = b256 * 58 + digit" one character and one byte at a time.
+ */
+static bool referenceDecode(const std::string &input, std::vector<unsigned char> &out)
+{
+    const char *psz = input.c_str();
+    while (*psz && isspace((unsigned char)*psz))
+        psz++;
+    size_t zeroes = 0;
+    while (*psz == '1')
+    {
+        zeroes++;
+        psz++;
+    }
+    std::vector<unsigned char> b256(strlen(psz) * 733 / 1000 + 1);
+    size_t length = 0;
+    while (*psz && !isspace((unsigned char)*psz))
+    {
+        const char *digit = strchr(BASE58_ALPHABET, *psz);
+        if (digit == nullptr || *psz == '\0')
+            return false;
+        int carry = static_cast<int>(digit - BASE58_ALPHABET);
+        size_t i = 0;
+        for (auto it = b256.rbegin(); (carry != 0 || i < length) && it != b256.rend(); ++it, ++i)
+        {
+            carry += 58 * (*it);
+            *it = carry % 256;
+            carry /= 256;
+        }
+        length = i;
+        psz++;
+    }
+    while (isspace((unsigned char)*psz))
+        psz++;
+    if (*psz != 0)
+        return false;
+    auto it = b256.begin() + (b256.size() - length);
+    while (it != b256.end() && *it == 0)
+        it++;
+    out.assign(zeroes, 0x00);
+    out.insert(out.end(), it, b256.end());
+    return true;
+}
+
+/**
+ * @test Random byte strings, with and without leading zero bytes, encode like the reference and decode back.
+ */
+TEST(Base58Test, EncodeMatchesReference)
+{
+    std::mt19937 random(58);
+    for (int round = 0; round < 3000; round++)
+    {
+        std::vector<unsigned char> data(round < 2700 ? random() % 120 : random() % 700);
+        for (auto &byte : data)
+            byte = static_cast<unsigned char>(random());
+        for (size_t i = 0, zeroes = random() % 4 == 0 ? random() % 5 : 0; i < zeroes && i < data.size(); i++)
+            data[i] = 0;
+
+        const std::string encoded = _internal::EncodeBase58(data);
+        ASSERT_EQ(encoded, referenceEncode(data)) << round;
+        std::vector<unsigned char> decoded;
+        ASSERT_TRUE(_internal::DecodeBase58(encoded, decoded));
+        ASSERT_EQ(decoded, data) << encoded;
+    }
+    EXPECT_EQ(_internal::EncodeBase58(std::vector<unsigned char>()), "");
+    EXPECT_EQ(_internal::EncodeBase58(std::vector<unsigned char>(3, 0)), "111");
+}
+
+/**
+ * @test Random strings of base58 characters, spaces and invalid characters decode like the reference.
+ */
+TEST(Base58Test, DecodeMatchesReference)
+{
+    static const char extra[] = "11  \t0OIl+";
+    std::mt19937 random(380);
+    for (int round = 0; round < 5000; round++)
+    {
+        std::string input;
+        const size_t length = round < 4000 ? random() % 160 : random() % 900;
+        for (size_t i = 0; i < length; i++)
+        {
+            if (random() % 64 == 0)
+                input += extra[random() % (sizeof(extra) - 1)];
+            else
+                input += BASE58_ALPHABET[random() % 58];
+        }
+
+        std::vector<unsigned char> expected, decoded;
+        const bool valid = referenceDecode(input, expected);
+        ASSERT_EQ(_internal::DecodeBase58(input, decoded), valid) << input;
+        if (valid)
+        {
+            ASSERT_EQ(decoded, expected) << input;
+        }
+    }
+}
+
+/**
+ * @test Base58Check round trips through the public API and rejects a modified checksum.
+ */
+TEST(Base58Test, CheckRoundTrip)
+{
+    const std::string payload("\x80\x01\x02\x03\x00\xff", 6);
+    const std::string encoded = EncodeToBase58Check(payload);
+    EXPECT_EQ(DecodeFromBase58Check(encoded), payload);
+
+    std::string modified = encoded;
+    modified.back() = modified.back() == 'a' ? 'b' : 'a';
+    EXPECT_THROW(DecodeFromBase58Check(modified), std::exception);
+}
+
+/**
+ * @test The buffer-based API reports every failure through its status and writes exactly the
+ * decoded bytes.
+ */
+TEST(Base58Test, BufferApiStatus)
+{
+    // compressed WIF key from BIP380: 0x80, 32-byte key, 0x01
+    const std::string wif = "L4rK1yDtCWekvXuE6oXD9jCYfFNV2cWRpVuPLBcCU2z8TrisoyY1";
+    unsigned char payload[34];
+    size_t size = 0;
+    ASSERT_EQ(DecodeFromBase58Check(wif, payload, sizeof(payload), &size), Base58Status::Ok);
+    EXPECT_EQ(size, 34u);
+    EXPECT_EQ(payload[0], 0x80);
+    EXPECT_EQ(payload[33], 0x01);
+
+    char encoded[Base58MaxEncodedLength(sizeof(payload) + 4)];
+    size_t length = 0;
+    ASSERT_EQ(EncodeToBase58Check(payload, sizeof(payload), encoded, sizeof(encoded), &length), Base58Status::Ok);
+    EXPECT_EQ(std::string(encoded, length), wif);
+    EXPECT_EQ(EncodeToBase58Check(payload, sizeof(payload), encoded, length - 1, &length), Base58Status::BufferTooSmall);
+
+    EXPECT_EQ(DecodeFromBase58Check(wif, payload, 33, &size), Base58Status::BufferTooSmall);
+    EXPECT_EQ(DecodeFromBase58Check(wif.substr(0, 51) + "2", payload, sizeof(payload), &size), Base58Status::BadChecksum);
+    EXPECT_EQ(DecodeFromBase58Check("1", payload, sizeof(payload), &size), Base58Status::BadChecksum);
+    EXPECT_EQ(DecodeFromBase58Check(wif.substr(0, 10) + "0" + wif.substr(11), payload, sizeof(payload), &size),
+              Base58Status::InvalidCharacter);
+    EXPECT_EQ(DecodeFromBase58(std::string_view("1 1"), payload, sizeof(payload), &size), Base58Status::InvalidCharacter);
+
+    // leading '1's decode to zero bytes, surrounding whitespace is skipped
+    ASSERT_EQ(DecodeFromBase58(std::string_view(" 112 "), payload, sizeof(payload), &size), Base58Status::Ok);
+    ASSERT_EQ(size, 3u);
+    EXPECT_EQ(payload[0], 0);
+    EXPECT_EQ(payload[1], 0);
+    EXPECT_EQ(payload[2], 1);
+    EXPECT_EQ(DecodeFromBase58(std::string_view("112"), payload, 2, &size), Base58Status::BufferTooSmall);
+    EXPECT_EQ(EncodeToBase58(payload, 3, encoded, sizeof(encoded), &length), Base58Status::Ok);
+    EXPECT_EQ(std::string(encoded, length), "112");
+}
+
+/**
+ * @test The batch decoder gives the same status, size and payload as decoding every entry on its own.
+ */
+TEST(Base58Test, CheckBatchMatchesSingle)
+{
+    srandom(41);
+    std::vector<std::string> strings;
+    for (int i = 0; i < 61; i++)
+    {
+        std::vector<unsigned char> payload(i % 5 == 0 ? random() % 140 : i % 2 == 0 ? 34 : 78);
+        for (auto &byte : payload)
+            byte = (unsigned char)random();
+        std::string encoded = _internal::EncodeBase58Check(payload);
+        if (i % 7 == 3)
+            encoded.back() = encoded.back() == 'a' ? 'b' : 'a';
+        if (i % 11 == 5)
+            encoded[encoded.size() / 2] = '0';
+        strings.push_back(encoded);
+    }
+    strings.push_back("");
+    strings.push_back("1");
+
+    const size_t stride = 80;
+    std::vector<std::string_view> views(strings.begin(), strings.end());
+    std::vector<unsigned char> out(views.size() * stride);
+    std::vector<size_t> sizes(views.size());
+    std::vector<Base58Status> statuses(views.size());
+    DecodeFromBase58CheckBatch(views.data(), views.size(), out.data(), stride, sizes.data(), statuses.data());
+
+    for (size_t i = 0; i < views.size(); i++)
+    {
+        unsigned char expected[stride];
+        size_t size = 0;
+        const Base58Status status = DecodeFromBase58Check(views[i], expected, stride, &size);
+        ASSERT_EQ(statuses[i], status) << strings[i];
+        if (status == Base58Status::Ok)
+        {
+            ASSERT_EQ(sizes[i], size) << strings[i];
+            EXPECT_EQ(memcmp(out.data() + i * stride, expected, size), 0) << strings[i];
+        }
+    }
+}
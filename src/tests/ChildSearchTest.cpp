@@ -0,0 +1,122 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file ChildSearchTest.cpp
+ * @brief GTest unit tests for the find-child reverse index lookup
+ * @date 2026-10-18
+ *
+ * Targets are derived with libbtc and then searched for by public key and by HASH160.
+ *
+ * © 2025
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../app/ChildSearch/ChildSearch.h"
+#include "../app/ArgParser/crypto-encode/hex.h"
+#include "../app/ArgParser/crypto-hash/hash160.h"
+
+extern "C"
+{
+#include <btc/bip32.h>
+#include <btc/chainparams.h>
+}
+
+static const std::string MASTER_XPUB = "xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8";
+
+/**
+ * Derives a non-hardened path below MASTER_XPUB and returns the raw compressed public key.
+ */
+static std::string childPublicKey(const std::vector<uint32_t> &path)
+{
+    btc_hdnode node;
+    EXPECT_TRUE(btc_hdnode_deserialize(MASTER_XPUB.c_str(), &btc_chainparams_main, &node));
+    for (uint32_t step : path)
+        EXPECT_TRUE(btc_hdnode_public_ckd(&node, step));
+    return std::string(reinterpret_cast<const char *>(node.public_key), 33);
+}
+
+/**
+ * HASH160 of a raw public key, hex encoded.
+ */
+static std::string hash160Hex(const std::string &publicKey)
+{
+    unsigned char hash[safeheron::hash::HASH160_OUTPUT_SIZE];
+    safeheron::hash::Hash160(hash, reinterpret_cast<const unsigned char *>(publicKey.data()), publicKey.size());
+    return safeheron::encode::hex::EncodeToHex(hash, sizeof(hash));
+}
+
+/**
+ * @test The targets file accepts public keys and HASH160s, skips comments and duplicates and rejects anything else.
+ */
+TEST(ChildSearchTest, LoadTargets)
+{
+    std::istringstream in("0279BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798\n"
+                          "\n"
+                          "# comment\n"
+                          "  751e76e8199196d454941c45d1b3a323f1433bd6\n"
+                          "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798\n");
+    ChildSearchTargets targets = loadChildSearchTargets(in);
+    ASSERT_EQ(targets.lines.size(), 2u);
+    EXPECT_EQ(targets.lines[0], "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798");
+    EXPECT_EQ(targets.lines[1], "751e76e8199196d454941c45d1b3a323f1433bd6");
+    EXPECT_EQ(targets.publicKeys.size(), 1u);
+    EXPECT_EQ(targets.hashes.size(), 1u);
+
+    const std::vector<std::string> invalid = {
+        "0479be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798\n",
+        "751e76e8199196d454941c45d1b3a323f1433bd\n",
+        "751e76e8199196d454941c45d1b3a323f1433bdg\n",
+    };
+    for (const auto &text : invalid)
+    {
+        std::istringstream bad(text);
+        EXPECT_THROW(loadChildSearchTargets(bad), std::invalid_argument) << text;
+    }
+}
+
+/**
+ * @test Public key and HASH160 targets are found at their child index, in parallel and across chunks.
+ */
+TEST(ChildSearchTest, FindsTargets)
+{
+    std::ostringstream file;
+    file << safeheron::encode::hex::EncodeToHex(childPublicKey({1, 7})) << "\n"
+         << hash160Hex(childPublicKey({1, 4100})) << "\n"
+         << "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798\n";
+    std::istringstream in(file.str());
+    const ChildSearchTargets targets = loadChildSearchTargets(in);
+
+    ChildSearchOptions options;
+    options.pathTemplate = "1/*";
+    options.range = 4200;
+    options.threads = 4;
+    const std::vector<int64_t> found = searchChildren(MASTER_XPUB, targets, options);
+    EXPECT_EQ(found, (std::vector<int64_t>{7, 4100, -1}));
+
+    options.range = 50;
+    options.threads = 1;
+    EXPECT_EQ(searchChildren(MASTER_XPUB, targets, options), (std::vector<int64_t>{7, -1, -1}));
+}
+
+/**
+ * @test Steps below the * step are derived for every child.
+ */
+TEST(ChildSearchTest, TemplateWithSuffix)
+{
+    std::istringstream in(hash160Hex(childPublicKey({12, 3})));
+    const ChildSearchTargets targets = loadChildSearchTargets(in);
+
+    ChildSearchOptions options;
+    options.pathTemplate = "*/3";
+    options.range = 20;
+    EXPECT_EQ(searchChildren(MASTER_XPUB, targets, options), (std::vector<int64_t>{12}));
+
+    for (const std::string &invalid : std::vector<std::string>{"0/1", "*/*", "0h/*", "0//*"})
+    {
+        options.pathTemplate = invalid;
+        EXPECT_THROW(searchChildren(MASTER_XPUB, targets, options), std::invalid_argument) << invalid;
+    }
+}
@@ -17,8 +17,12 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <cstdio>
 
 #include "../app/DeriveKey/DeriveKey.h"
+#include "../app/DeriveKey/ExtendedKey.h"
+#include "../app/DeriveKey/NodeCache.h"
 
 /**
  * Helper to capture std::cout output.
@@ -402,3 +406,324 @@ TEST(DeriveKeyTest, MultipleSeedsWithEmptyLinesIgnored)
     EXPECT_NE(output.find("xpub"), std::string::npos);
     EXPECT_NE(output.find("xprv"), std::string::npos);
 }
+
+/**
+ * @test BIP39 mnemonic with passphrase should produce the reference master key of the BIP39 test vectors.
+ */
+TEST(DeriveKeyTest, MnemonicWithPassphraseMatchesReference)
+{
+    std::vector<std::string> values = {
+        "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about",
+        "legal winner thank year wave sausage worth useful legal winner thank yellow"};
+    DeriveKeyOptions options;
+    options.mnemonic = true;
+    options.passphrase = "TREZOR";
+    std::ostringstream out;
+    CoutRedirect redirect(out.rdbuf());
+
+    EXPECT_NO_THROW(deriveKey(values, "", options));
+
+    EXPECT_EQ(out.str(),
+              "xpub661MyMwAqRbcGB88KaFbLGiYAat55APKhtWg4uYMkXAmfuSTbq2QYsn9sKJCj1YqZPafsboef4h4YbXXhNhPwMbkHTpkf3zLhx7HvFw1NDy:"
+              "xprv9s21ZrQH143K3h3fDYiay8mocZ3afhfULfb5GX8kCBdno77K4HiA15Tg23wpbeF1pLfs1c5SPmYHrEpTuuRhxMwvKDwqdKiGJS9XFKzUsAF\n"
+              "xpub661MyMwAqRbcFAEb7d5FeyQpgzpW1yk1koNRtHHhuayKXL7Ls2Kg3GdMzWHSDAfpkzzxKfB9pDHeF8iWTcnovFuJ4DYPBbPBWq7oUFW31LB:"
+              "xprv9s21ZrQH143K2gA81bYFHqU68xz1cX2APaSq5tt6MFSLeXnCKV1RVUJt9FWNTbrrryem4ZckN8k4Ls1H6nwdvDTvnV7zEXs2HgPezuVccsq\n");
+}
+
+/**
+ * @test Mnemonic with an unsupported word count should trigger an error.
+ */
+TEST(DeriveKeyTest, MnemonicWithInvalidWordCountFails)
+{
+    std::vector<std::string> values = {
+        "abandon abandon abandon abandon abandon about"};
+    DeriveKeyOptions options;
+    options.mnemonic = true;
+    EXPECT_EXIT({ deriveKey(values, "", options); }, ::testing::ExitedWithCode(1), ".*mnemonic must have.*");
+}
+
+/**
+ * @test Public-only and private-only modes print exactly one of the keys of the full output.
+ */
+TEST(DeriveKeyTest, PublicOnlyAndPrivateOnlySplitFullOutput)
+{
+    const std::string xpub = "xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8";
+    const std::string xprv = "xprv9s21ZrQH143K3QTDL4LXw2F7HEK3wJUD2nW2nRk4stbPy6cq3jPPqjiChkVvvNKmPGJxWUtg6LnF5kejMRNNU3TGtRBeJgk33yuGBxrMPHi";
+    std::vector<std::string> values = {"000102030405060708090a0b0c0d0e0f", xprv};
+
+    DeriveKeyOptions publicOnly;
+    publicOnly.publicOnly = true;
+    DeriveKeyOptions privateOnly;
+    privateOnly.privateOnly = true;
+
+    std::ostringstream publicOut;
+    {
+        CoutRedirect redirect(publicOut.rdbuf());
+        deriveKey(values, "", publicOnly);
+    }
+    std::ostringstream privateOut;
+    {
+        CoutRedirect redirect(privateOut.rdbuf());
+        deriveKey(values, "", privateOnly);
+    }
+
+    EXPECT_EQ(publicOut.str(), xpub + "\n" + xpub + "\n");
+    EXPECT_EQ(privateOut.str(), xprv + "\n" + xprv + "\n");
+}
+
+/**
+ * @test Private-only mode fails for xpub inputs, which have no private key.
+ */
+TEST(DeriveKeyTest, PrivateOnlyWithXpubFails)
+{
+    std::vector<std::string> values = {
+        "xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8"};
+    DeriveKeyOptions options;
+    options.privateOnly = true;
+    EXPECT_EXIT({ deriveKey(values, "", options); }, ::testing::ExitedWithCode(1), ".*private key not available.*");
+}
+
+/**
+ * @test Binary records carry the same keys as the text output, with the input line index and flags.
+ */
+TEST(DeriveKeyTest, BinaryRecordsMatchTextOutput)
+{
+    std::vector<std::string> values = {
+        "000102030405060708090a0b0c0d0e0f",
+        "",
+        "xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8"};
+
+    std::ostringstream text;
+    {
+        CoutRedirect redirect(text.rdbuf());
+        deriveKey(values, "0/1");
+    }
+    DeriveKeyOptions options;
+    options.format = OutputFormat::Binary;
+    std::ostringstream binary;
+    {
+        CoutRedirect redirect(binary.rdbuf());
+        deriveKey(values, "0/1", options);
+    }
+
+    const std::string records = binary.str();
+    ASSERT_EQ(records.size(), 2 * BINARY_RECORD_SIZE);
+
+    std::istringstream lines(text.str());
+    const uint32_t expectedIndices[] = {0, 2};
+    for (size_t r = 0; r < 2; r++)
+    {
+        const unsigned char *record = reinterpret_cast<const unsigned char *>(records.data()) + r * BINARY_RECORD_SIZE;
+        EXPECT_EQ(record[0] | record[1] << 8 | record[2] << 16 | (uint32_t)record[3] << 24, expectedIndices[r]);
+
+        btc_hdnode node;
+        node.depth = record[4];
+        node.fingerprint = (uint32_t)record[8] << 24 | record[9] << 16 | record[10] << 8 | record[11];
+        node.child_num = (uint32_t)record[12] << 24 | record[13] << 16 | record[14] << 8 | record[15];
+        std::copy(record + 16, record + 48, node.chain_code);
+        std::copy(record + 48, record + 81, node.public_key);
+        std::copy(record + 81, record + 113, node.private_key);
+
+        char xpub[EXTENDED_KEY_BUFFER_SIZE], xprv[EXTENDED_KEY_BUFFER_SIZE];
+        serializeExtendedKey(&node, &btc_chainparams_main, false, xpub);
+        std::string expectedLine = xpub;
+        if (record[5] & BINARY_RECORD_HAS_PRIVATE_KEY)
+        {
+            serializeExtendedKey(&node, &btc_chainparams_main, true, xprv);
+            expectedLine += std::string(":") + xprv;
+        }
+        else
+        {
+            EXPECT_TRUE(std::all_of(record + 81, record + 113, [](unsigned char c) { return c == 0; }));
+        }
+
+        std::string line;
+        std::getline(lines, line);
+        EXPECT_EQ(line, expectedLine);
+        EXPECT_TRUE(std::all_of(record + 113, record + BINARY_RECORD_SIZE, [](unsigned char c) { return c == 0; }));
+    }
+}
+
+/**
+ * @test NDJSON records hold the same keys as the text output plus the node metadata.
+ */
+TEST(DeriveKeyTest, NdjsonRecordsMatchTextOutput)
+{
+    std::vector<std::string> values = {
+        "000102030405060708090a0b0c0d0e0f",
+        "xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8"};
+    DeriveKeyOptions options;
+    options.format = OutputFormat::Ndjson;
+    std::ostringstream out;
+    {
+        CoutRedirect redirect(out.rdbuf());
+        deriveKey(values, "0/1", options);
+    }
+
+    EXPECT_EQ(out.str(),
+              "{\"index\":0,\"xpub\":\"xpub6AvUGrnEpfvJBbfx7sQ89Q8hEMPM65UteqEX4yUbUiES2jHfjexmfJoxCGSwFMZiPBaKQT1RiKWrKfuDV4vpgVs4Xn8PpPTR2i79rwHd4Zr\","
+              "\"xprv\":\"xprv9ww7sMFLzJMzy7bV1qs7nGBxgKYrgcm3HcJvGb4yvNhT9vxXC7eX7WVULzCfxucFEn2TsVvJw25hH9d4mchywguGQCZvRgsiRaTY1HCqN8G\","
+              "\"depth\":2,\"child\":1,\"fingerprint\":\"9cc81b61\"}\n"
+              "{\"index\":1,\"xpub\":\"xpub6AvUGrnEpfvJBbfx7sQ89Q8hEMPM65UteqEX4yUbUiES2jHfjexmfJoxCGSwFMZiPBaKQT1RiKWrKfuDV4vpgVs4Xn8PpPTR2i79rwHd4Zr\","
+              "\"xprv\":null,\"depth\":2,\"child\":1,\"fingerprint\":\"9cc81b61\"}\n");
+}
+
+/**
+ * @test Origin mode prefixes every key with the master fingerprint and the normalised path.
+ */
+TEST(DeriveKeyTest, OriginPrefixesKeys)
+{
+    const std::string xpub = "xpub6AvUGrnEpfvJBbfx7sQ89Q8hEMPM65UteqEX4yUbUiES2jHfjexmfJoxCGSwFMZiPBaKQT1RiKWrKfuDV4vpgVs4Xn8PpPTR2i79rwHd4Zr";
+    const std::string xprv = "xprv9ww7sMFLzJMzy7bV1qs7nGBxgKYrgcm3HcJvGb4yvNhT9vxXC7eX7WVULzCfxucFEn2TsVvJw25hH9d4mchywguGQCZvRgsiRaTY1HCqN8G";
+    std::vector<std::string> values = {
+        "000102030405060708090a0b0c0d0e0f",
+        "xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8"};
+    DeriveKeyOptions options;
+    options.origin = true;
+    std::ostringstream out;
+    {
+        CoutRedirect redirect(out.rdbuf());
+        deriveKey(values, "0/1", options);
+    }
+    EXPECT_EQ(out.str(), "[3442193e/0/1]" + xpub + ":[3442193e/0/1]" + xprv + "\n[3442193e/0/1]" + xpub + "\n");
+
+    options.publicOnly = true;
+    std::ostringstream hardened;
+    {
+        CoutRedirect redirect(hardened.rdbuf());
+        deriveKey({values[0]}, "0H/1'", options);
+    }
+    EXPECT_EQ(hardened.str().substr(0, 23), "[3442193e/0h/1h]xpub6AS");
+}
+
+/**
+ * @test Origin fingerprints computed in batches match libbtc's HASH160 of each master key.
+ */
+TEST(DeriveKeyTest, OriginFingerprintsMatchMasterKeys)
+{
+    std::vector<std::string> values;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 37; i++)
+    {
+        uint8_t seed[16];
+        std::string hex;
+        char byte[3];
+        for (int j = 0; j < 16; j++)
+        {
+            seed[j] = (uint8_t)(i * 31 + j * 7);
+            snprintf(byte, sizeof(byte), "%02x", seed[j]);
+            hex += byte;
+        }
+        values.push_back(hex);
+
+        btc_hdnode master;
+        ASSERT_TRUE(btc_hdnode_from_seed(seed, sizeof(seed), &master));
+        uint8_t hash[20];
+        btc_hdnode_get_hash160(&master, hash);
+        char fingerprint[9];
+        snprintf(fingerprint, sizeof(fingerprint), "%02x%02x%02x%02x", hash[0], hash[1], hash[2], hash[3]);
+        expected.push_back(std::string("[") + fingerprint + "/5]");
+    }
+
+    DeriveKeyOptions options;
+    options.origin = true;
+    options.publicOnly = true;
+    options.threads = 3;
+    std::ostringstream out;
+    {
+        CoutRedirect redirect(out.rdbuf());
+        deriveKey(values, "5", options);
+    }
+
+    std::istringstream lines(out.str());
+    std::string line;
+    for (const auto &prefix : expected)
+    {
+        ASSERT_TRUE(std::getline(lines, line));
+        EXPECT_EQ(line.substr(0, prefix.size()), prefix);
+    }
+    EXPECT_FALSE(std::getline(lines, line));
+}
+
+/**
+ * @test With a node cache the node after the last hardened step is taken from the cache.
+ */
+TEST(DeriveKeyTest, NodeCacheServesHardenedSteps)
+{
+    const std::string path = ::testing::TempDir() + "bip380_derive.cache";
+    std::remove(path.c_str());
+    std::vector<std::string> values = {"000102030405060708090a0b0c0d0e0f"};
+
+    std::ostringstream plain;
+    {
+        CoutRedirect redirect(plain.rdbuf());
+        deriveKey(values, "0h/1/2h/2");
+    }
+    DeriveKeyOptions options;
+    options.cacheFile = path;
+    for (int run = 0; run < 2; run++)
+    {
+        std::ostringstream cached;
+        {
+            CoutRedirect redirect(cached.rdbuf());
+            deriveKey(values, "0h/1/2h/2", options);
+        }
+        EXPECT_EQ(cached.str(), plain.str()) << "run " << run;
+    }
+
+    // Replace the cached 0h/1/2h node by the master node: the output is then master/2.
+    uint8_t seed[16];
+    for (int i = 0; i < 16; i++)
+        seed[i] = (uint8_t)i;
+    btc_hdnode master;
+    ASSERT_TRUE(btc_hdnode_from_seed(seed, sizeof(seed), &master));
+    const uint32_t steps[] = {0x80000000, 1, 0x80000002};
+    {
+        NodeCache cache(path, true);
+        cache.insert(NodeCache::makeKey(master, steps, 3), master, true);
+    }
+    std::ostringstream planted, expected;
+    {
+        CoutRedirect redirect(planted.rdbuf());
+        deriveKey(values, "0h/1/2h/2", options);
+    }
+    {
+        CoutRedirect redirect(expected.rdbuf());
+        deriveKey(values, "2");
+    }
+    EXPECT_EQ(planted.str(), expected.str());
+    std::remove(path.c_str());
+}
+
+/**
+ * @test Nodes cached without private keys only serve public-only output.
+ */
+TEST(DeriveKeyTest, NodeCacheWithoutPrivateKeys)
+{
+    const std::string path = ::testing::TempDir() + "bip380_derive_public.cache";
+    std::remove(path.c_str());
+    std::vector<std::string> values = {"000102030405060708090a0b0c0d0e0f"};
+
+    DeriveKeyOptions options;
+    options.cacheFile = path;
+    options.cachePrivateKeys = false;
+    std::ostringstream full, cachedFull;
+    {
+        CoutRedirect redirect(full.rdbuf());
+        deriveKey(values, "44h/0h/0h/0/1", options);
+    }
+    {
+        CoutRedirect redirect(cachedFull.rdbuf());
+        deriveKey(values, "44h/0h/0h/0/1", options);
+    }
+    EXPECT_EQ(cachedFull.str(), full.str());
+
+    options.publicOnly = true;
+    std::ostringstream publicOnly;
+    {
+        CoutRedirect redirect(publicOnly.rdbuf());
+        deriveKey(values, "44h/0h/0h/0/1", options);
+    }
+    EXPECT_EQ(publicOnly.str(), full.str().substr(0, full.str().find(':')) + "\n");
+    std::remove(path.c_str());
+}
@@ -0,0 +1,185 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file EccContextPoolTest.cpp
+ * @brief GTest unit tests for the shared ECC context and concurrent derivation
+ * @date 2026-10-18
+ *
+ * Stress tests deriving keys from many threads at once and comparing the results
+ * with a single-threaded run.
+ *
+ * © 2025
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "../app/Utility/EccContextPool.h"
+#include "../app/DeriveKey/DeriveKey.h"
+
+extern "C"
+{
+#include <btc/bip32.h>
+#include <btc/chainparams.h>
+}
+
+/**
+ * Generates distinct hex seeds of varying length.
+ */
+static std::vector<std::string> makeSeeds(size_t count)
+{
+    static const char hex[] = "0123456789abcdef";
+    std::vector<std::string> seeds;
+    uint32_t state = 0x12345678;
+    for (size_t i = 0; i < count; i++)
+    {
+        std::string seed;
+        size_t bytes = 16 + i % 49;
+        for (size_t j = 0; j < bytes; j++)
+        {
+            state = state * 1103515245 + 12345;
+            seed += hex[(state >> 16) & 0xf];
+            seed += hex[(state >> 20) & 0xf];
+        }
+        seeds.push_back(seed);
+    }
+    return seeds;
+}
+
+/**
+ * Runs deriveKey and returns everything it printed.
+ */
+static std::string captureDeriveKey(const std::vector<std::string> &values, const std::string &path, unsigned threads)
+{
+    std::ostringstream out;
+    std::streambuf *old = std::cout.rdbuf(out.rdbuf());
+    DeriveKeyOptions options;
+    options.threads = threads;
+    deriveKey(values, path, options);
+    std::cout.rdbuf(old);
+    return out.str();
+}
+
+/**
+ * Leases are reference counted and released when they go out of scope or are moved from.
+ */
+TEST(EccContextPoolTest, LeasesAreCounted)
+{
+    const size_t base = EccContextPool::activeLeases();
+    {
+        EccContextPool::Lease first = EccContextPool::acquire();
+        EXPECT_EQ(EccContextPool::activeLeases(), base + 1);
+        EccContextPool::Lease moved = std::move(first);
+        EXPECT_EQ(EccContextPool::activeLeases(), base + 1);
+        EccContextPool::Lease second = EccContextPool::acquire();
+        EXPECT_EQ(EccContextPool::activeLeases(), base + 2);
+    }
+    EXPECT_EQ(EccContextPool::activeLeases(), base);
+}
+
+/**
+ * The context stays started after the last lease is released, and shutdown() leaves it alone while leases are held.
+ */
+TEST(EccContextPoolTest, ContextOutlivesLeases)
+{
+    {
+        EccContextPool::Lease ecc = EccContextPool::acquire();
+        EXPECT_TRUE(EccContextPool::started());
+    }
+    EXPECT_TRUE(EccContextPool::started());
+
+    ASSERT_GT(EccContextPool::activeLeases(), 0u);
+    EccContextPool::shutdown();
+    EXPECT_TRUE(EccContextPool::started());
+}
+
+/**
+ * Many threads deriving from the same shared context produce the same keys as a serial run.
+ */
+TEST(EccContextPoolTest, ConcurrentDerivationMatchesSerial)
+{
+    const std::vector<std::string> seeds = makeSeeds(64);
+    btc_chainparams *chain = (btc_chainparams *)&btc_chainparams_main;
+
+    auto derive = [&](const std::string &seedHex)
+    {
+        std::vector<uint8_t> seed;
+        for (size_t i = 0; i < seedHex.size(); i += 2)
+            seed.push_back(static_cast<uint8_t>(std::stoul(seedHex.substr(i, 2), nullptr, 16)));
+
+        btc_hdnode node;
+        btc_hdnode_from_seed(seed.data(), seed.size(), &node);
+        btc_hdnode_private_ckd(&node, 0x80000000 | 44);
+        btc_hdnode_public_ckd(&node, 7);
+        char xpub[112];
+        btc_hdnode_serialize_public(&node, chain, xpub, sizeof(xpub));
+        return std::string(xpub);
+    };
+
+    std::vector<std::string> expected;
+    for (const auto &seed : seeds)
+        expected.push_back(derive(seed));
+
+    const size_t threadCount = 8;
+    const size_t rounds = 8;
+    std::vector<std::vector<std::string>> results(threadCount);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&, t]()
+                             {
+            EccContextPool::Lease ecc = EccContextPool::acquire();
+            for (size_t round = 0; round < rounds; round++)
+                for (size_t i = 0; i < seeds.size(); i++)
+                    results[t].push_back(derive(seeds[(i + t) % seeds.size()])); });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    for (size_t t = 0; t < threadCount; t++)
+    {
+        ASSERT_EQ(results[t].size(), rounds * seeds.size());
+        for (size_t i = 0; i < results[t].size(); i++)
+            EXPECT_EQ(results[t][i], expected[(i % seeds.size() + t) % seeds.size()]);
+    }
+}
+
+/**
+ * deriveKey with many worker threads prints exactly the serial output, in input order.
+ */
+TEST(EccContextPoolTest, ParallelDeriveKeyMatchesSerial)
+{
+    std::vector<std::string> values = makeSeeds(2500);
+    values.push_back("xprv9s21ZrQH143K3QTDL4LXw2F7HEK3wJUD2nW2nRk4stbPy6cq3jPPqjiChkVvvNKmPGJxWUtg6LnF5kejMRNNU3TGtRBeJgk33yuGBxrMPHi");
+    values.push_back("xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8");
+
+    const std::string path = "0/1/2/3";
+    const std::string serial = captureDeriveKey(values, path, 1);
+    ASSERT_EQ(std::count(serial.begin(), serial.end(), '\n'), static_cast<long>(values.size()));
+    EXPECT_EQ(captureDeriveKey(values, path, 3), serial);
+    EXPECT_EQ(captureDeriveKey(values, path, 16), serial);
+}
+
+/**
+ * With many worker threads, the outputs preceding an invalid input are printed before exiting.
+ */
+TEST(EccContextPoolTest, ParallelDeriveKeyStopsAtFirstError)
+{
+    std::vector<std::string> values = makeSeeds(40);
+    values[25] = "not a seed";
+
+    const std::vector<std::string> prefix(values.begin(), values.begin() + 25);
+    const std::string expected = captureDeriveKey(prefix, "", 1);
+
+    // stdout is sent to stderr in the child so that the printed lines can be matched
+    EXPECT_EXIT({
+        DeriveKeyOptions options;
+        options.threads = 8;
+        std::cout.rdbuf(std::cerr.rdbuf());
+        deriveKey(values, "", options);
+    }, ::testing::ExitedWithCode(1), "^" + expected + "\\[ERROR\\]: handleSeed: invalid characters in seed at column 1\n$");
+}
@@ -0,0 +1,145 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file ExtendedKeyTest.cpp
+ * @brief GTest unit tests for the fixed-length Base58Check encoder and extended key serialization
+ * @date 2026-10-18
+ *
+ * The in-project encoder is checked against the generic Base58Check encoder and
+ * against libbtc's btc_hdnode_serialize_* functions.
+ *
+ * © 2025
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "../app/DeriveKey/ExtendedKey.h"
+#include "../app/ArgParser/crypto-encode/base58.h"
+#include "../app/ArgParser/crypto-encode/base58_fixed.h"
+#include "../app/ArgParser/crypto-hash/hash256.h"
+
+/**
+ * Deterministic pseudo-random byte generator for the tests.
+ */
+class TestRandom
+{
+public:
+    explicit TestRandom(uint32_t seed) : state(seed) {}
+    unsigned char next()
+    {
+        state = state * 1103515245 + 12345;
+        return (unsigned char)(state >> 16);
+    }
+
+private:
+    uint32_t state;
+};
+
+/**
+ * Encodes a payload with the fixed-length encoder and the generic one and compares the results.
+ */
+template <size_t N>
+static void expectSameAsGeneric(const unsigned char (&payload)[N])
+{
+    char fixed[safeheron::encode::base58::Base58CheckFixedSize<N>::MAX_LENGTH + 1];
+    size_t length = safeheron::encode::base58::EncodeToBase58CheckFixed(payload, fixed);
+    std::string generic = safeheron::encode::base58::EncodeToBase58Check(payload, N);
+    EXPECT_EQ(std::string(fixed), generic);
+    EXPECT_EQ(length, generic.size());
+}
+
+/**
+ * @test SHA256D matches the CHash256 hasher for lengths around the block boundaries.
+ */
+TEST(ExtendedKeyTest, SHA256DMatchesHash256)
+{
+    TestRandom random(1);
+    std::vector<unsigned char> data(300);
+    for (auto &byte : data)
+        byte = random.next();
+
+    for (size_t len = 0; len <= data.size(); len++)
+    {
+        unsigned char expected[32], actual[32];
+        safeheron::hash::CHash256().Write(data.data(), len).Finalize(expected);
+        safeheron::hash::SHA256D(actual, data.data(), len);
+        EXPECT_EQ(std::string(expected, expected + 32), std::string(actual, actual + 32)) << "length " << len;
+    }
+}
+
+/**
+ * @test The fixed-length encoder matches the generic one, including payloads with leading zero bytes.
+ */
+TEST(ExtendedKeyTest, FixedEncoderMatchesGeneric)
+{
+    TestRandom random(2);
+    for (int round = 0; round < 500; round++)
+    {
+        unsigned char payload78[78];
+        unsigned char payload21[21];
+        unsigned char payload1[1];
+        for (auto &byte : payload78)
+            byte = random.next();
+        for (auto &byte : payload21)
+            byte = random.next();
+        payload1[0] = random.next();
+
+        // Exercise leading zero bytes and leading zero limbs.
+        size_t zeroes = round % 20;
+        for (size_t i = 0; i < zeroes; i++)
+        {
+            payload78[i] = 0;
+            payload21[i] = 0;
+        }
+        if (round % 7 == 0)
+            payload1[0] = 0;
+
+        expectSameAsGeneric(payload78);
+        expectSameAsGeneric(payload21);
+        expectSameAsGeneric(payload1);
+    }
+
+    unsigned char zeroPayload[78] = {0};
+    expectSameAsGeneric(zeroPayload);
+    unsigned char fullPayload[78];
+    std::fill(fullPayload, fullPayload + 78, 0xff);
+    expectSameAsGeneric(fullPayload);
+}
+
+/**
+ * @test serializeExtendedKey produces exactly the libbtc serialization for derived nodes on both networks.
+ */
+TEST(ExtendedKeyTest, SerializationMatchesLibbtc)
+{
+    const btc_chainparams *chains[] = {&btc_chainparams_main, &btc_chainparams_test};
+    TestRandom random(3);
+
+    for (int round = 0; round < 100; round++)
+    {
+        unsigned char seed[64];
+        size_t seedLen = 16 + round % 49;
+        for (size_t i = 0; i < seedLen; i++)
+            seed[i] = random.next();
+
+        btc_hdnode node;
+        ASSERT_TRUE(btc_hdnode_from_seed(seed, (int)seedLen, &node));
+        for (int depth = 0; depth < 4; depth++)
+        {
+            for (const btc_chainparams *chain : chains)
+            {
+                char expected[EXTENDED_KEY_BUFFER_SIZE], actual[EXTENDED_KEY_BUFFER_SIZE];
+
+                btc_hdnode_serialize_public(&node, chain, expected, sizeof(expected));
+                serializeExtendedKey(&node, chain, false, actual);
+                EXPECT_STREQ(actual, expected);
+
+                btc_hdnode_serialize_private(&node, chain, expected, sizeof(expected));
+                serializeExtendedKey(&node, chain, true, actual);
+                EXPECT_STREQ(actual, expected);
+            }
+            uint32_t index = (uint32_t)random.next() << 24 | (uint32_t)random.next() << 8 | random.next();
+            ASSERT_TRUE(btc_hdnode_private_ckd(&node, index));
+        }
+    }
+}
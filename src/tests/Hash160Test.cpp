@@ -0,0 +1,119 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file Hash160Test.cpp
+ * @brief GTest unit tests for the RIPEMD-160 and HASH160 implementations
+ * @date 2026-10-18
+ *
+ * RIPEMD-160 is checked against the reference test vectors, the multi-buffer
+ * variant against the scalar hasher and HASH160 against libbtc.
+ *
+ * © 2025
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "../app/ArgParser/crypto-hash/hash160.h"
+#include "../app/ArgParser/crypto-hash/ripemd160.h"
+#include "../app/ArgParser/crypto-hash/sha256.h"
+
+extern "C"
+{
+#include <btc/bip32.h>
+}
+
+/**
+ * Hex encodes a byte buffer.
+ */
+static std::string toHex(const unsigned char *data, size_t len)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    for (size_t i = 0; i < len; i++)
+    {
+        hex += digits[data[i] >> 4];
+        hex += digits[data[i] & 0xf];
+    }
+    return hex;
+}
+
+/**
+ * RIPEMD-160 of a string with the scalar hasher, hex encoded.
+ */
+static std::string ripemd160Hex(const std::string &message)
+{
+    unsigned char hash[safeheron::hash::CRIPEMD160::OUTPUT_SIZE];
+    safeheron::hash::CRIPEMD160().Write(reinterpret_cast<const unsigned char *>(message.data()), message.size()).Finalize(hash);
+    return toHex(hash, sizeof(hash));
+}
+
+/**
+ * @test The scalar hasher reproduces the RIPEMD-160 reference test vectors.
+ */
+TEST(Hash160Test, RIPEMD160TestVectors)
+{
+    EXPECT_EQ(ripemd160Hex(""), "9c1185a5c5e9fc54612808977ee8f548b2258d31");
+    EXPECT_EQ(ripemd160Hex("a"), "0bdc9d2d256b3ee9daae347be6f4dc835a467ffe");
+    EXPECT_EQ(ripemd160Hex("abc"), "8eb208f7e05d987a9b044a8e98c6b087f15a0bfc");
+    EXPECT_EQ(ripemd160Hex("message digest"), "5d0689ef49d2fae572b881b123a85ffa21595f36");
+    EXPECT_EQ(ripemd160Hex("abcdefghijklmnopqrstuvwxyz"), "f71c27109c692c1b56bbdceb5b9d2865b3708dbc");
+    EXPECT_EQ(ripemd160Hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"), "12a053384a9c0c88e405a06c27dcf49ada62eb2b");
+    EXPECT_EQ(ripemd160Hex(std::string(1000000, 'a')), "52783243c1697bdbe16d37f97f68f08325dc1528");
+}
+
+/**
+ * @test The multi-buffer variant matches the scalar hasher for every message count up to a few lane widths.
+ */
+TEST(Hash160Test, MultiwayMatchesScalar)
+{
+    const size_t maxCount = 3 * safeheron::hash::RIPEMD160_LANES + 1;
+    std::vector<unsigned char> input(32 * maxCount);
+    for (size_t i = 0; i < input.size(); i++)
+        input[i] = (unsigned char)(i * 131 + 7);
+
+    for (size_t count = 0; count <= maxCount; count++)
+    {
+        std::vector<unsigned char> output(20 * count + 1, 0xaa);
+        safeheron::hash::RIPEMD160_32Multiway(output.data(), input.data(), count);
+        for (size_t i = 0; i < count; i++)
+        {
+            unsigned char expected[20];
+            safeheron::hash::CRIPEMD160().Write(input.data() + 32 * i, 32).Finalize(expected);
+            EXPECT_EQ(toHex(output.data() + 20 * i, 20), toHex(expected, 20)) << "count " << count << " message " << i;
+        }
+        EXPECT_EQ(output[20 * count], 0xaa);
+    }
+}
+
+/**
+ * @test Hash160 and Hash160Batch match libbtc's HASH160 of public keys.
+ */
+TEST(Hash160Test, MatchesLibbtc)
+{
+    const size_t count = 19;
+    std::vector<unsigned char> keys(33 * count);
+    std::vector<std::string> expected;
+    for (size_t i = 0; i < count; i++)
+    {
+        unsigned char seed[32];
+        for (size_t j = 0; j < sizeof(seed); j++)
+            seed[j] = (unsigned char)(i * 17 + j);
+        btc_hdnode node;
+        ASSERT_TRUE(btc_hdnode_from_seed(seed, sizeof(seed), &node));
+        std::copy(node.public_key, node.public_key + 33, keys.begin() + 33 * i);
+
+        uint8_t hash[20];
+        btc_hdnode_get_hash160(&node, hash);
+        expected.push_back(toHex(hash, sizeof(hash)));
+
+        unsigned char single[safeheron::hash::HASH160_OUTPUT_SIZE];
+        safeheron::hash::Hash160(single, node.public_key, 33);
+        EXPECT_EQ(toHex(single, sizeof(single)), expected.back());
+    }
+
+    std::vector<unsigned char> batch(20 * count);
+    safeheron::hash::Hash160Batch(batch.data(), keys.data(), 33, count);
+    for (size_t i = 0; i < count; i++)
+        EXPECT_EQ(toHex(batch.data() + 20 * i, 20), expected[i]);
+}
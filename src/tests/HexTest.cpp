@@ -0,0 +1,111 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file HexTest.cpp
+ * @brief GTest unit tests for the strict hex decoder
+ * @date 2026-10-18
+ *
+ * Lengths around the 32-character block are checked with an invalid character at every position,
+ * so the SIMD blocks and the pair-by-pair tail report the same first error.
+ *
+ * © 2025
+ */
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../app/ArgParser/crypto-encode/hex.h"
+
+using safeheron::encode::hex::DecodeFromHex;
+using safeheron::encode::hex::HexStatus;
+
+/**
+ * Builds a hex string of the given length with digits of both cases.
+ */
+static std::string makeHex(size_t length)
+{
+    static const char digits[] = "0123456789abcdefABCDEF";
+    std::string hex;
+    for (size_t i = 0; i < length; i++)
+        hex += digits[(i * 7 + 3) % 22];
+    return hex;
+}
+
+/**
+ * Decodes hex one digit at a time, the reference for the decoder.
+ */
+static std::vector<unsigned char> referenceDecode(const std::string &hex)
+{
+    std::vector<unsigned char> bytes;
+    for (size_t i = 0; i + 1 < hex.size(); i += 2)
+        bytes.push_back((unsigned char)std::stoul(hex.substr(i, 2), nullptr, 16));
+    return bytes;
+}
+
+/**
+ * @test Valid strings of every length up to a few blocks decode like the reference; odd lengths
+ * report the unpaired last digit.
+ */
+TEST(HexTest, DecodesValidStrings)
+{
+    for (size_t length = 0; length <= 100; length++)
+    {
+        const std::string hex = makeHex(length);
+        std::vector<unsigned char> out(length / 2 + 1, 0xaa);
+        size_t size = 0, position = 0;
+        const HexStatus status = DecodeFromHex(hex, out.data(), length / 2, &size, &position);
+
+        EXPECT_EQ(status, length % 2 == 0 ? HexStatus::Ok : HexStatus::OddLength) << "length " << length;
+        EXPECT_EQ(size, length / 2);
+        EXPECT_EQ(position, length % 2 == 0 ? length : length - 1);
+        EXPECT_EQ(std::vector<unsigned char>(out.begin(), out.begin() + size), referenceDecode(hex)) << "length " << length;
+        EXPECT_EQ(out[length / 2], 0xaa);
+    }
+}
+
+/**
+ * @test The first invalid character is reported at its position, with the complete pairs before it
+ * decoded, for characters just outside the hex ranges and bytes above 0x7f.
+ */
+TEST(HexTest, ReportsFirstInvalidCharacter)
+{
+    for (size_t length : {2, 31, 32, 33, 64, 66, 96, 130})
+    {
+        for (size_t bad = 0; bad < length; bad++)
+        {
+            for (char c : {'/', ':', '@', 'G', '`', 'g', ' ', '\0', '\x80', '\xc6'})
+            {
+                std::string hex = makeHex(length);
+                hex[bad] = c;
+                // a second error after the first one must not change the result
+                if (bad + 3 < length)
+                    hex[bad + 3] = 'x';
+                std::vector<unsigned char> out(length / 2);
+                size_t size = 0, position = 0;
+                EXPECT_EQ(DecodeFromHex(hex, out.data(), out.size(), &size, &position), HexStatus::InvalidCharacter);
+                EXPECT_EQ(position, bad) << "length " << length << " character " << (int)c;
+                EXPECT_EQ(size, bad / 2);
+                EXPECT_EQ(std::vector<unsigned char>(out.begin(), out.begin() + size),
+                          referenceDecode(hex.substr(0, bad - bad % 2)));
+            }
+        }
+    }
+}
+
+/**
+ * @test A buffer shorter than the decoded data is rejected before anything is written, and the
+ * string variant throws on invalid input.
+ */
+TEST(HexTest, RejectsSmallBufferAndInvalidStrings)
+{
+    unsigned char out[4] = {0xaa, 0xaa, 0xaa, 0xaa};
+    size_t size = 1;
+    EXPECT_EQ(DecodeFromHex("0011223344", out, sizeof(out), &size), HexStatus::BufferTooSmall);
+    EXPECT_EQ(size, 0u);
+    EXPECT_EQ(out[0], 0xaa);
+
+    EXPECT_EQ(DecodeFromHex(std::string("00ff")), std::string("\x00\xff", 2));
+    EXPECT_THROW(DecodeFromHex(std::string("00f")), std::runtime_error);
+    EXPECT_THROW(DecodeFromHex(std::string("00fg")), std::runtime_error);
+}
@@ -0,0 +1,48 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file JsonWriterTest.cpp
+ * @brief GTest unit tests for the NDJSON writer
+ * @date 2026-10-18
+ *
+ * © 2025
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+#include "../app/Utility/JsonWriter.h"
+
+/**
+ * Fields of all types, nested objects and record termination.
+ */
+TEST(JsonWriterTest, WritesRecords) {
+    JsonWriter json;
+    json.beginObject()
+        .numberField("zero", 0)
+        .numberField("max", UINT64_MAX)
+        .boolField("yes", true)
+        .nullField("nothing")
+        .beginObject("nested")
+        .stringField("a", "b")
+        .endObject()
+        .stringField("after", std::string("c"))
+        .endObject();
+    json.beginObject().endObject();
+
+    EXPECT_EQ(json.str(),
+              "{\"zero\":0,\"max\":18446744073709551615,\"yes\":true,\"nothing\":null,\"nested\":{\"a\":\"b\"},\"after\":\"c\"}\n"
+              "{}\n");
+}
+
+/**
+ * Strings are escaped, and flushing writes and clears the buffer.
+ */
+TEST(JsonWriterTest, EscapesAndFlushes) {
+    JsonWriter json(16);
+    json.beginObject().stringField("s", std::string("q\"b\\n\n\t\x01\xc3\xa9", 10)).endObject();
+
+    std::ostringstream out;
+    json.flush(out);
+    EXPECT_EQ(out.str(), "{\"s\":\"q\\\"b\\\\n\\n\\t\\u0001\xc3\xa9\"}\n");
+    EXPECT_TRUE(json.str().empty());
+}
@@ -14,3 +14,52 @@
 
 #include <gtest/gtest.h>
 #include "../app/KeyExpression/KeyExpression.h"
+#include <sstream>
+#include <iostream>
+
+/**
+ * Key expressions are split into origin, key and derivation steps.
+ */
+TEST(KeyExpressionTest, DescribeKeyExpression) {
+    KeyExpressionInfo info = describeKeyExpression(
+            "[deadbeef/0h/1/2]xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8/1/2h/*");
+    EXPECT_EQ(info.type, "xpub");
+    EXPECT_EQ(info.key, "xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8");
+    EXPECT_TRUE(info.hasOrigin);
+    EXPECT_EQ(info.originFingerprint, "deadbeef");
+    EXPECT_EQ(info.originPath, "0h/1/2");
+    EXPECT_TRUE(info.hasDerivation);
+    EXPECT_EQ(info.derivation, "1/2h/*");
+
+    info = describeKeyExpression("[deadbeef]5KYZdUEo39z3FPrtuX2QbbwGnNP5zTd7yyr2SC1j299sBCnWjss");
+    EXPECT_EQ(info.type, "wif");
+    EXPECT_TRUE(info.hasOrigin);
+    EXPECT_EQ(info.originPath, "");
+    EXPECT_FALSE(info.hasDerivation);
+
+    info = describeKeyExpression("04a34b99f22c790c4e36b2b3c2c35a36db06226e41c692fc82b8b56ac1c540c5bd5b8dec5235a0fa8722476c7709c02559e3aa73aa03918ba2d492eea75abea235");
+    EXPECT_EQ(info.type, "uncompressed-pubkey");
+    EXPECT_FALSE(info.hasOrigin);
+}
+
+/**
+ * NDJSON output has one object per expression with the parsed fields.
+ */
+TEST(KeyExpressionTest, NdjsonOutput) {
+    std::vector<std::string> values = {
+            "0260b2003c386519fc9eadf2b5cf124dd8eea4c4e68d5e154050a9346ea98ce600",
+            "[d34db33f/4/5]03fff97bd5755eeea420453a14355235d382f6472f8568a18b2f057a1460297556"};
+
+    std::stringstream buffer;
+    std::streambuf *sbuf = std::cout.rdbuf();
+    std::cout.rdbuf(buffer.rdbuf());
+    runKeyExpression(values, OutputFormat::Ndjson);
+    std::cout.rdbuf(sbuf);
+
+    EXPECT_EQ(buffer.str(),
+              "{\"index\":0,\"expression\":\"0260b2003c386519fc9eadf2b5cf124dd8eea4c4e68d5e154050a9346ea98ce600\",\"type\":\"pubkey\","
+              "\"key\":\"0260b2003c386519fc9eadf2b5cf124dd8eea4c4e68d5e154050a9346ea98ce600\",\"origin\":null,\"derivation\":null}\n"
+              "{\"index\":1,\"expression\":\"[d34db33f/4/5]03fff97bd5755eeea420453a14355235d382f6472f8568a18b2f057a1460297556\",\"type\":\"pubkey\","
+              "\"key\":\"03fff97bd5755eeea420453a14355235d382f6472f8568a18b2f057a1460297556\","
+              "\"origin\":{\"fingerprint\":\"d34db33f\",\"path\":\"4/5\"},\"derivation\":null}\n");
+}
@@ -1,8 +1,6 @@
 #include <gtest/gtest.h>
 
-extern "C" {
-    #include <btc/ecc.h>
-    }
+#include "../app/Utility/EccContextPool.h"
 
 /**
  * main() for Google Test. 
@@ -11,8 +9,6 @@ extern "C" {
  */
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
-    btc_ecc_start();
-    int result = RUN_ALL_TESTS();
-    btc_ecc_stop();
-    return result;
+    EccContextPool::Lease ecc = EccContextPool::acquire();
+    return RUN_ALL_TESTS();
 }
\ No newline at end of file
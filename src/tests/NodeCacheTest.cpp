@@ -0,0 +1,175 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file NodeCacheTest.cpp
+ * @brief GTest unit tests for the persistent node cache
+ * @date 2026-10-18
+ *
+ * Checks persistence across instances, integrity checks, eviction and the
+ * option to keep private keys out of the cache file.
+ *
+ * © 2025
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "../app/DeriveKey/NodeCache.h"
+
+/**
+ * Fresh cache file path in the test temporary directory.
+ */
+static std::string cachePath(const std::string &name)
+{
+    std::string path = ::testing::TempDir() + "bip380_" + name + ".cache";
+    std::remove(path.c_str());
+    return path;
+}
+
+/**
+ * Master node of a seed filled with one byte value.
+ */
+static btc_hdnode masterNode(uint8_t fill)
+{
+    uint8_t seed[32];
+    std::fill(seed, seed + sizeof(seed), fill);
+    btc_hdnode node;
+    EXPECT_TRUE(btc_hdnode_from_seed(seed, sizeof(seed), &node));
+    return node;
+}
+
+/**
+ * Cache key of a single-step path below the master node of masterNode(fill).
+ */
+static NodeCache::Key keyFor(uint8_t fill, uint32_t step)
+{
+    btc_hdnode root = masterNode(fill);
+    return NodeCache::makeKey(root, &step, 1);
+}
+
+/**
+ * @test Entries survive reopening the file, and keys depend on root and path.
+ */
+TEST(NodeCacheTest, PersistsAcrossInstances)
+{
+    const std::string path = cachePath("persist");
+    btc_hdnode node = masterNode(1);
+    ASSERT_TRUE(btc_hdnode_private_ckd(&node, 0x80000000));
+    {
+        NodeCache cache(path, true);
+        cache.insert(keyFor(1, 0x80000000), node, true);
+    }
+
+    NodeCache cache(path, true, 64);
+    EXPECT_EQ(cache.slotCount(), NODE_CACHE_DEFAULT_SLOTS);
+
+    btc_hdnode cached;
+    bool hasPrivateKey = false;
+    ASSERT_TRUE(cache.lookup(keyFor(1, 0x80000000), &cached, &hasPrivateKey));
+    EXPECT_TRUE(hasPrivateKey);
+    EXPECT_EQ(cached.depth, node.depth);
+    EXPECT_EQ(cached.fingerprint, node.fingerprint);
+    EXPECT_EQ(cached.child_num, node.child_num);
+    EXPECT_EQ(0, memcmp(cached.chain_code, node.chain_code, sizeof(node.chain_code)));
+    EXPECT_EQ(0, memcmp(cached.public_key, node.public_key, sizeof(node.public_key)));
+    EXPECT_EQ(0, memcmp(cached.private_key, node.private_key, sizeof(node.private_key)));
+
+    EXPECT_FALSE(cache.lookup(keyFor(1, 0x80000001), &cached, &hasPrivateKey));
+    EXPECT_FALSE(cache.lookup(keyFor(2, 0x80000000), &cached, &hasPrivateKey));
+    std::remove(path.c_str());
+}
+
+/**
+ * @test A damaged entry is reported as a miss and dropped; foreign files are refused.
+ */
+TEST(NodeCacheTest, IntegrityChecks)
+{
+    const std::string path = cachePath("integrity");
+    const NodeCache::Key key = keyFor(3, 0x80000000);
+    {
+        NodeCache cache(path, true, 8);
+        cache.insert(key, masterNode(3), true);
+    }
+
+    // Flip one chain code byte of every slot; only the used slot has a stamp.
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        for (uint32_t slot = 0; slot < 8; slot++)
+        {
+            const std::streamoff offset = 64 + slot * sizeof(NodeCacheSlot) + offsetof(NodeCacheSlot, chainCode);
+            char byte;
+            file.seekg(offset);
+            file.get(byte);
+            file.seekp(offset);
+            file.put((char)(byte ^ 1));
+        }
+    }
+
+    NodeCache cache(path, true);
+    btc_hdnode cached;
+    bool hasPrivateKey;
+    EXPECT_FALSE(cache.lookup(key, &cached, &hasPrivateKey));
+    cache.insert(key, masterNode(3), true);
+    EXPECT_TRUE(cache.lookup(key, &cached, &hasPrivateKey));
+    std::remove(path.c_str());
+
+    const std::string foreign = cachePath("foreign");
+    std::ofstream(foreign) << "not a cache\n";
+    EXPECT_THROW(NodeCache(foreign, true), std::invalid_argument);
+    std::ifstream check(foreign);
+    std::string line;
+    std::getline(check, line);
+    EXPECT_EQ(line, "not a cache");
+    std::remove(foreign.c_str());
+}
+
+/**
+ * @test A full probe window evicts its least recently used entry.
+ */
+TEST(NodeCacheTest, EvictsLeastRecentlyUsed)
+{
+    const std::string path = cachePath("evict");
+    NodeCache cache(path, true, NODE_CACHE_PROBE_WINDOW);
+    const btc_hdnode node = masterNode(4);
+    btc_hdnode cached;
+    bool hasPrivateKey;
+
+    for (uint32_t i = 0; i < NODE_CACHE_PROBE_WINDOW; i++)
+        cache.insert(keyFor(4, i), node, true);
+    ASSERT_TRUE(cache.lookup(keyFor(4, 0), &cached, &hasPrivateKey));
+
+    cache.insert(keyFor(4, 100), node, true);
+    EXPECT_TRUE(cache.lookup(keyFor(4, 0), &cached, &hasPrivateKey));
+    EXPECT_FALSE(cache.lookup(keyFor(4, 1), &cached, &hasPrivateKey));
+    EXPECT_TRUE(cache.lookup(keyFor(4, 100), &cached, &hasPrivateKey));
+    for (uint32_t i = 2; i < NODE_CACHE_PROBE_WINDOW; i++)
+        EXPECT_TRUE(cache.lookup(keyFor(4, i), &cached, &hasPrivateKey)) << i;
+    std::remove(path.c_str());
+}
+
+/**
+ * @test Without storePrivateKeys no private key reaches the file.
+ */
+TEST(NodeCacheTest, KeepsPrivateKeysOut)
+{
+    const std::string path = cachePath("noprivate");
+    const btc_hdnode node = masterNode(5);
+    {
+        NodeCache cache(path, false);
+        EXPECT_FALSE(cache.storesPrivateKeys());
+        cache.insert(keyFor(5, 0), node, true);
+
+        btc_hdnode cached;
+        bool hasPrivateKey = true;
+        ASSERT_TRUE(cache.lookup(keyFor(5, 0), &cached, &hasPrivateKey));
+        EXPECT_FALSE(hasPrivateKey);
+        EXPECT_EQ(0, memcmp(cached.public_key, node.public_key, sizeof(node.public_key)));
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const std::string privateKey(reinterpret_cast<const char *>(node.private_key), sizeof(node.private_key));
+    EXPECT_EQ(contents.find(privateKey), std::string::npos);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,45 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file PathTemplateTest.cpp
+ * @brief GTest unit tests for the find-child path template parser
+ * @date 2026-10-18
+ *
+ * The same parser validates the find-child argument and drives the search, so every template the
+ * argument parser accepts is one the search can run.
+ *
+ * © 2025
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../app/Utility/PathTemplate.h"
+
+/**
+ * @test The steps before and after the * step are returned in order.
+ */
+TEST(PathTemplateTest, SplitsAroundWildcard)
+{
+    PathTemplate parsed = parsePathTemplate("*");
+    EXPECT_TRUE(parsed.prefix.empty());
+    EXPECT_TRUE(parsed.suffix.empty());
+
+    parsed = parsePathTemplate("44/0/*/2147483647/7");
+    EXPECT_EQ(parsed.prefix, (std::vector<uint32_t>{44, 0}));
+    EXPECT_EQ(parsed.suffix, (std::vector<uint32_t>{2147483647, 7}));
+}
+
+/**
+ * @test Templates without exactly one * step, with hardened, empty or out of range steps are rejected.
+ */
+TEST(PathTemplateTest, RejectsInvalidTemplates)
+{
+    for (const std::string &invalid : std::vector<std::string>{
+             "", "0/1", "*/*", "**", "0h/*", "0'/*", "0//*", "/*", "*/", "2147483648/*", "00000000001/*", "-1/*", "0/ 1/*"})
+    {
+        EXPECT_THROW(parsePathTemplate(invalid), std::invalid_argument) << invalid;
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file ScanTest.cpp
+ * @brief GTest unit tests for the gap-limit scan and its used address set
+ * @date 2026-10-18
+ *
+ * Used addresses are derived with libbtc and then found again by walking the chains.
+ *
+ * © 2025
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "../app/Scan/Scan.h"
+#include "../app/Scan/UsedSet.h"
+#include "../app/Utility/Address.h"
+#include "../app/ArgParser/crypto-hash/hash160.h"
+
+extern "C"
+{
+#include <btc/bip32.h>
+#include <btc/chainparams.h>
+}
+
+static const std::string MASTER_XPUB = "xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8";
+
+/**
+ * Derives a non-hardened path below MASTER_XPUB and returns the P2PKH address of the child.
+ */
+static std::string childAddress(const std::vector<uint32_t> &path)
+{
+    btc_hdnode node;
+    EXPECT_TRUE(btc_hdnode_deserialize(MASTER_XPUB.c_str(), &btc_chainparams_main, &node));
+    for (uint32_t step : path)
+        EXPECT_TRUE(btc_hdnode_public_ckd(&node, step));
+    return p2pkhAddress(node.public_key, 33);
+}
+
+/**
+ * Builds a used set from its file contents.
+ */
+static UsedSet usedSet(const std::string &contents)
+{
+    return UsedSet(contents.data(), contents.size());
+}
+
+/**
+ * @test The used file accepts addresses and scriptPubKeys, skips comments and duplicates and rejects anything else.
+ */
+TEST(ScanTest, LoadUsedSet)
+{
+    const UsedSet used = usedSet("1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH\r\n"
+                                 "\n"
+                                 "# comment\n"
+                                 "  76a914000000000000000000000000000000000000000088ac  \n"
+                                 "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH");
+    EXPECT_EQ(used.size(), 2u);
+
+    // HASH160 of the generator point, the payload of 1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH
+    const uint8_t generator[20] = {0x75, 0x1e, 0x76, 0xe8, 0x19, 0x91, 0x96, 0xd4, 0x54, 0x94,
+                                   0x1c, 0x45, 0xd1, 0xb3, 0xa3, 0x23, 0xf1, 0x43, 0x3b, 0xd6};
+    const uint8_t zero[20] = {0};
+    uint8_t other[20] = {0};
+    other[19] = 1;
+    EXPECT_TRUE(used.contains(generator));
+    EXPECT_TRUE(used.contains(zero));
+    EXPECT_FALSE(used.contains(other));
+    EXPECT_EQ(usedSet("").size(), 0u);
+    EXPECT_FALSE(usedSet("").contains(generator));
+
+    const std::vector<std::string> invalid = {
+            "34wjDxkCQrUPYwnCRtap5uib6XNcVaud9K\n",  // P2SH address
+            "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMJ\n",  // bad checksum
+            "a914751e76e8199196d454941c45d1b3a323f1433bd687\n",  // P2SH scriptPubKey
+            "76a914751e76e8199196d454941c45d1b3a323f1433bzz88ac\n",
+    };
+    for (const auto &contents : invalid)
+        EXPECT_THROW(usedSet(contents), std::invalid_argument) << contents;
+}
+
+/**
+ * @test Addresses are verified in batches, but the error still names the first bad line.
+ */
+TEST(ScanTest, UsedSetReportsFirstBadLine)
+{
+    const std::string address = "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH\n";
+    const std::string badChecksum = "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMJ\n";
+    const std::string script = "76a914000000000000000000000000000000000000000088ac\n";
+
+    std::string contents;
+    for (int i = 0; i < 150; i++)
+        contents += i % 3 == 0 ? script : address;
+    EXPECT_EQ(usedSet(contents).size(), 2u);
+
+    std::string lines;
+    for (int i = 0; i < 69; i++)
+        lines += address;
+    try
+    {
+        usedSet(lines + badChecksum + contents + "xyz\n");
+        FAIL() << "bad checksum accepted";
+    }
+    catch (const std::invalid_argument &ex)
+    {
+        EXPECT_NE(std::string(ex.what()).find("line 70:"), std::string::npos) << ex.what();
+    }
+    try
+    {
+        usedSet(lines + "xyz\n" + badChecksum);
+        FAIL() << "invalid line accepted";
+    }
+    catch (const std::invalid_argument &ex)
+    {
+        EXPECT_NE(std::string(ex.what()).find("line 70:"), std::string::npos) << ex.what();
+    }
+}
+
+/**
+ * @test Inputs are bare xpubs (receive and change chains) or pkh() descriptors with a path ending in *.
+ */
+TEST(ScanTest, ParseScanSource)
+{
+    ScanSource source = parseScanSource(MASTER_XPUB);
+    EXPECT_EQ(source.xpub, MASTER_XPUB);
+    EXPECT_EQ(source.chainPaths, (std::vector<std::string>{"0", "1"}));
+
+    source = parseScanSource("pkh([d34db33f/44h]" + MASTER_XPUB + "/7/1/*)#abcdefgh");
+    EXPECT_EQ(source.chains, (std::vector<std::vector<uint32_t>>{{7, 1}}));
+    EXPECT_EQ(source.chainPaths, (std::vector<std::string>{"7/1"}));
+
+    const std::vector<std::string> invalid = {
+            MASTER_XPUB + "/0",
+            "pkh(" + MASTER_XPUB + "/0)",
+            "pkh(" + MASTER_XPUB + "/0h/*)",
+            "sh(pkh(" + MASTER_XPUB + "/0/*))",
+            "xprv9s21ZrQH143K3QTDL4LXw2F7HEK3wJUD2nW2nRk4stbPy6cq3jPPqjiChkVvvNKmPGJxWUtg6LnF5kejMRNNU3TGtRBeJgk33yuGBxrMPHi",
+    };
+    for (const auto &value : invalid)
+        EXPECT_THROW(parseScanSource(value), std::invalid_argument) << value;
+}
+
+/**
+ * @test Chains end after gap consecutive unused addresses, also inside a derivation window, and
+ * the result does not depend on the thread count.
+ */
+TEST(ScanTest, GapLimit)
+{
+    const std::string used = childAddress({0, 3}) + "\n" + childAddress({0, 9}) + "\n" + childAddress({0, 40}) + "\n" +
+                             childAddress({1, 0}) + "\n" + childAddress({5, 0}) + "\n";
+    const UsedSet usedSetFromFile = usedSet(used);
+    const std::vector<ScanSource> sources = {parseScanSource(MASTER_XPUB), parseScanSource("pkh(" + MASTER_XPUB + "/5/*)")};
+
+    ScanOptions options;
+    options.gap = 5;
+    options.threads = 1;
+    std::vector<ScanResult> results = scanChains(sources, usedSetFromFile, options);
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_EQ(results[0].usedIndices, (std::vector<uint32_t>{3}));
+    EXPECT_EQ(results[1].usedIndices, (std::vector<uint32_t>{0}));
+    EXPECT_EQ(results[2].input, 1u);
+    EXPECT_EQ(results[2].chainPath, "5");
+    EXPECT_EQ(results[2].addresses, (std::vector<std::string>{childAddress({5, 0})}));
+
+    options.gap = 6;
+    EXPECT_EQ(scanChains(sources, usedSetFromFile, options)[0].usedIndices, (std::vector<uint32_t>{3, 9}));
+
+    options.gap = 31;
+    options.threads = 3;
+    results = scanChains(sources, usedSetFromFile, options);
+    EXPECT_EQ(results[0].usedIndices, (std::vector<uint32_t>{3, 9, 40}));
+    EXPECT_EQ(results[0].addresses[2], childAddress({0, 40}));
+}
@@ -572,4 +572,33 @@ TEST(ScriptExpressionTest, duplicatedExpression) {
     	ScriptExpression scriptExpression(argParser.getArgValues(), argParser.getComputeChecksumFlag(), argParser.getVerifyChecksumFlag());
 	    scriptExpression.parse();
     }, std::invalid_argument);
-}
\ No newline at end of file
+}
+
+/**
+ * NDJSON output contains the descriptor, its checksum and the verification result.
+ */
+TEST(ScriptExpressionTest, NdjsonOutput) {
+    const std::vector<std::pair<std::vector<const char *>, std::string>> cases = {
+            {{"bip380", "script-expression", "--format=ndjson", "raw(deadbeef)"},
+             "{\"descriptor\":\"raw(deadbeef)\",\"checksum\":\"89f8spxm\",\"verified\":null}\n"},
+            {{"bip380", "script-expression", "--format=ndjson", "--compute-checksum", "raw(deadbeef)#89f8spx"},
+             "{\"descriptor\":\"raw(deadbeef)\",\"checksum\":\"89f8spxm\",\"verified\":null}\n"},
+            {{"bip380", "script-expression", "--format=ndjson", "--verify-checksum", "raw(deadbeef)#89f8spxm"},
+             "{\"descriptor\":\"raw(deadbeef)\",\"checksum\":\"89f8spxm\",\"verified\":true}\n"},
+    };
+
+    for (const auto &testCase : cases) {
+        ArgParser argParser;
+        argParser.loadArguments(static_cast<int>(testCase.first.size()), const_cast<char **>(testCase.first.data()));
+        argParser.parse();
+
+        std::stringstream buffer;
+        std::streambuf *sbuf = std::cout.rdbuf();
+        std::cout.rdbuf(buffer.rdbuf());
+        ScriptExpression scriptExpression(argParser.getArgValues(), argParser.getComputeChecksumFlag(), argParser.getVerifyChecksumFlag(), argParser.getFormat());
+        scriptExpression.parse();
+        std::cout.rdbuf(sbuf);
+
+        EXPECT_EQ(buffer.str(), testCase.second);
+    }
+}
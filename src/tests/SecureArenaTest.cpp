@@ -0,0 +1,57 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file SecureArenaTest.cpp
+ * @brief GTest unit tests for the locked bump allocator holding seeds and private keys
+ * @date 2026-10-18
+ *
+ * © 2025
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "../app/Utility/SecureArena.h"
+
+/**
+ * @test Buffers are aligned, do not overlap and the arena refuses to hand out more than its capacity.
+ */
+TEST(SecureArenaTest, Allocate)
+{
+    SecureArena arena(100);
+    EXPECT_GE(arena.capacity(), 100u);
+    EXPECT_EQ(arena.used(), 0u);
+
+    uint8_t *first = arena.allocateBytes(3);
+    void *aligned = arena.allocate(8, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0u);
+    EXPECT_GE(static_cast<uint8_t *>(aligned), first + 3);
+    EXPECT_THROW(arena.allocate(1, 3), std::invalid_argument);
+
+    const size_t remaining = arena.capacity() - arena.used();
+    EXPECT_THROW(arena.allocateBytes(remaining + 1), std::length_error);
+    EXPECT_NO_THROW(arena.allocateBytes(remaining));
+    EXPECT_EQ(arena.used(), arena.capacity());
+    EXPECT_THROW(arena.allocateBytes(1), std::length_error);
+}
+
+/**
+ * @test reset() wipes everything handed out and the space is reused from the start.
+ */
+TEST(SecureArenaTest, ResetWipes)
+{
+    SecureArena arena;
+    char *secret = arena.allocateChars(16);
+    memcpy(secret, "000102030405060", 16);
+    uint8_t *key = arena.allocateBytes(32);
+    memset(key, 0xab, 32);
+
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+    for (size_t i = 0; i < 16; i++)
+        EXPECT_EQ(secret[i], 0);
+    for (size_t i = 0; i < 32; i++)
+        EXPECT_EQ(key[i], 0);
+    EXPECT_EQ(arena.allocateChars(1), secret);
+}
@@ -0,0 +1,156 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file SeedHexTest.cpp
+ * @brief GTest unit tests for the single-pass hex seed decoder
+ * @date 2026-10-18
+ *
+ * Random lines are checked against the seed regex the argument parser used before, so the
+ * SIMD blocks and the character-by-character path accept exactly the same inputs.
+ *
+ * © 2025
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "../app/Utility/SeedHex.h"
+
+/**
+ * Decodes a line and returns the seed bytes, empty on error.
+ */
+static std::vector<uint8_t> decode(const std::string &line, SeedHexResult *result)
+{
+    uint8_t out[SEED_MAX_BYTES];
+    *result = decodeSeedHex(line.data(), line.size(), out);
+    if (result->status != SeedHexStatus::Ok)
+        return {};
+    return std::vector<uint8_t>(out, out + result->size);
+}
+
+/**
+ * @test Seeds with and without separators decode to the same bytes, in either case.
+ */
+TEST(SeedHexTest, DecodesSeeds)
+{
+    std::vector<uint8_t> expected;
+    for (uint8_t i = 0; i < 64; i++)
+        expected.push_back(static_cast<uint8_t>(i * 37 + 5));
+    std::string plain, separated;
+    static const char digits[] = "0123456789abcdef";
+    for (uint8_t byte : expected)
+    {
+        plain += digits[byte >> 4];
+        plain += digits[byte & 0xf];
+        separated += plain.substr(plain.size() - 2) + (byte % 3 == 0 ? " \t" : "");
+    }
+
+    SeedHexResult result;
+    EXPECT_EQ(decode(plain, &result), expected);
+    EXPECT_EQ(result.size, 64u);
+    EXPECT_EQ(decode(separated + "  ", &result), expected);
+    EXPECT_EQ(decode(plain.substr(0, 32), &result), std::vector<uint8_t>(expected.begin(), expected.begin() + 16));
+    EXPECT_EQ(decode("000102030405060708090A0B0C0D0E0F", &result), decode("000102030405060708090a0b0c0d0e0f", &result));
+}
+
+/**
+ * @test Errors carry the column of the first offending character, inside and after SIMD blocks.
+ */
+TEST(SeedHexTest, ReportsColumn)
+{
+    const std::string seed = "000102030405060708090a0b0c0d0e0f";
+    SeedHexResult result;
+
+    decode(seed.substr(0, 19) + "x" + seed.substr(20), &result);
+    EXPECT_EQ(result.status, SeedHexStatus::InvalidCharacter);
+    EXPECT_EQ(result.column, 20u);
+    EXPECT_EQ(seedHexErrorMessage(result), "invalid characters in seed at column 20");
+
+    decode(seed + "\xff", &result);
+    EXPECT_EQ(result.status, SeedHexStatus::InvalidCharacter);
+    EXPECT_EQ(result.column, 33u);
+
+    decode(" " + seed, &result);
+    EXPECT_EQ(result.status, SeedHexStatus::MisplacedWhitespace);
+    EXPECT_EQ(result.column, 1u);
+
+    decode("000 102030405060708090a0b0c0d0e0f", &result);
+    EXPECT_EQ(result.status, SeedHexStatus::MisplacedWhitespace);
+    EXPECT_EQ(result.column, 4u);
+
+    decode(seed + "0", &result);
+    EXPECT_EQ(result.status, SeedHexStatus::OddLength);
+    EXPECT_EQ(result.column, 33u);
+
+    decode(seed.substr(0, 30), &result);
+    EXPECT_EQ(result.status, SeedHexStatus::TooShort);
+    EXPECT_EQ(seedHexErrorMessage(result), "seed length out of range, 15 bytes (at least 16)");
+
+    decode(seed + seed + seed + seed + "10", &result);
+    EXPECT_EQ(result.status, SeedHexStatus::TooLong);
+    EXPECT_EQ(result.column, 129u);
+}
+
+/**
+ * @test Random lines are accepted exactly when they match the seed regex.
+ */
+TEST(SeedHexTest, MatchesRegexOnRandomLines)
+{
+    const std::regex seedRegex("^(([0-9a-fA-F]{2})([ \t]*)){16,64}$");
+    static const char hexDigits[] = "0123456789abcdefABCDEF";
+    static const char mutations[] = "0aF \tgZ\xff\r";
+    std::mt19937 random(380);
+
+    for (int round = 0; round < 20000; round++)
+    {
+        // 10 to 70 bytes, a few with separators, then possibly one character replaced
+        std::string line;
+        const size_t byteCount = 10 + random() % 61;
+        for (size_t i = 0; i < byteCount; i++)
+        {
+            line += hexDigits[random() % (sizeof(hexDigits) - 1)];
+            line += hexDigits[random() % (sizeof(hexDigits) - 1)];
+            if (random() % 16 == 0)
+                line += random() % 2 == 0 ? " " : "\t ";
+        }
+        if (random() % 2 == 0)
+            line[random() % line.size()] = mutations[random() % (sizeof(mutations) - 1)];
+
+        SeedHexResult result;
+        const std::vector<uint8_t> bytes = decode(line, &result);
+        ASSERT_EQ(result.status == SeedHexStatus::Ok, std::regex_match(line, seedRegex)) << line;
+        if (result.status != SeedHexStatus::Ok)
+            continue;
+
+        std::string digits;
+        for (char c : line)
+            if (c != ' ' && c != '\t')
+                digits += c;
+        ASSERT_EQ(bytes.size(), digits.size() / 2) << line;
+        for (size_t i = 0; i < bytes.size(); i++)
+            ASSERT_EQ(bytes[i], std::stoul(digits.substr(2 * i, 2), nullptr, 16)) << line;
+    }
+}
+
+/**
+ * @test The lenient syntax skips any whitespace, also inside a byte, and still reports other characters.
+ */
+TEST(SeedHexTest, LenientSyntax)
+{
+    const std::string line = " 0\t001\n02 03\r04 05 06 07 08 09 0a 0b 0c 0d 0e 0f ";
+    uint8_t out[SEED_MAX_BYTES];
+    SeedHexResult result = decodeSeedHex(line.data(), line.size(), out, SeedHexSyntax::Lenient);
+    ASSERT_EQ(result.status, SeedHexStatus::Ok);
+    ASSERT_EQ(result.size, 16u);
+    for (uint8_t i = 0; i < 16; i++)
+        EXPECT_EQ(out[i], i);
+    EXPECT_EQ(decodeSeedHex(line.data(), line.size(), out).status, SeedHexStatus::MisplacedWhitespace);
+
+    const std::string invalid = "00 01 02 03 04 05 06 07 08 09 0a 0b 0c 0d 0e 0g";
+    result = decodeSeedHex(invalid.data(), invalid.size(), out, SeedHexSyntax::Lenient);
+    EXPECT_EQ(result.status, SeedHexStatus::InvalidCharacter);
+    EXPECT_EQ(result.column, invalid.size());
+}
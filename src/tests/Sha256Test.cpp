@@ -0,0 +1,198 @@
+/**
+ * Project: PV286 2024/2025 Project
+ * @file Sha256Test.cpp
+ * @brief GTest unit tests for the SHA-256 implementations
+ * @date 2026-10-18
+ *
+ * The multi-buffer variants and the hardware implementations picked by SHA256AutoDetect are
+ * checked against the portable scalar hasher.
+ *
+ * © 2025
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "../app/ArgParser/crypto-hash/hash256.h"
+#include "../app/ArgParser/crypto-hash/sha256.h"
+
+/**
+ * Hex encodes a byte buffer.
+ */
+static std::string toHex(const unsigned char *data, size_t len)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    for (size_t i = 0; i < len; i++)
+    {
+        hex += digits[data[i] >> 4];
+        hex += digits[data[i] & 0xf];
+    }
+    return hex;
+}
+
+/**
+ * Hashes of a fixed set of messages with the currently selected implementation: SHA-256 and
+ * double SHA-256 of every length up to 300 bytes (also through Hash256Short where it applies), and SHA256D64 of 15 blocks, so every kernel width is followed by single calls.
+ */
+static std::vector<std::string> hashAll()
+{
+    std::vector<unsigned char> data(1024);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = (unsigned char)(i * 97 + 11);
+
+    std::vector<std::string> hashes;
+    unsigned char hash[32];
+    for (size_t len = 0; len <= 300; len++)
+    {
+        safeheron::hash::CSHA256().Write(data.data() + len, len).Finalize(hash);
+        hashes.push_back(toHex(hash, sizeof(hash)));
+        safeheron::hash::SHA256D(hash, data.data() + len, len);
+        hashes.push_back(toHex(hash, sizeof(hash)));
+        if (len <= safeheron::hash::SHA256_SHORT_MAX_LEN)
+        {
+            safeheron::hash::Hash256Short(hash, data.data() + len, len);
+            hashes.push_back(toHex(hash, sizeof(hash)));
+        }
+    }
+    std::vector<unsigned char> d64(15 * 32);
+    safeheron::hash::SHA256D64(d64.data(), data.data() + 1, 15);
+    hashes.push_back(toHex(d64.data(), d64.size()));
+    return hashes;
+}
+
+/**
+ * @test Every implementation SHA256AutoDetect can select produces the hashes of the portable one.
+ */
+TEST(Sha256Test, AutoDetectMatchesStandard)
+{
+    using namespace safeheron::hash::sha256_implementation;
+    EXPECT_EQ(safeheron::hash::SHA256AutoDetect(STANDARD), "standard");
+    const std::vector<std::string> expected = hashAll();
+
+    unsigned char abc[32];
+    safeheron::hash::CSHA256().Write(reinterpret_cast<const unsigned char *>("abc"), 3).Finalize(abc);
+    EXPECT_EQ(toHex(abc, sizeof(abc)), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+    for (UseImplementation use : {USE_SSE4, USE_AVX2, USE_SHANI, USE_ALL})
+    {
+        const std::string name = safeheron::hash::SHA256AutoDetect(use);
+        EXPECT_EQ(hashAll(), expected) << name;
+    }
+}
+
+/**
+ * @test Hash256Short matches the CHash256 hasher for every length it accepts.
+ */
+TEST(Sha256Test, Hash256ShortMatchesHash256)
+{
+    std::vector<unsigned char> data(safeheron::hash::SHA256_SHORT_MAX_LEN);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = (unsigned char)(i * 73 + 29);
+
+    for (size_t len = 0; len <= safeheron::hash::SHA256_SHORT_MAX_LEN; len++)
+    {
+        unsigned char expected[32], actual[32];
+        safeheron::hash::CHash256().Write(data.data(), len).Finalize(expected);
+        safeheron::hash::Hash256Short(actual, data.data(), len);
+        EXPECT_EQ(toHex(actual, 32), toHex(expected, 32)) << "length " << len;
+    }
+}
+
+/**
+ * @test A hasher forked from a saved midstate produces the hash of the whole message, for prefixes
+ * ending inside and at the end of a block and suffixes crossing the next block boundary.
+ */
+TEST(Sha256Test, MidstateMatchesFullHash)
+{
+    std::vector<unsigned char> data(300);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = (unsigned char)(i * 59 + 17);
+
+    for (size_t prefix : {0, 1, 4, 25, 55, 63, 64, 65, 128, 130})
+    {
+        safeheron::hash::CSHA256 hasher;
+        hasher.Write(data.data(), prefix);
+        const safeheron::hash::SHA256Midstate midstate = hasher.SaveMidstate();
+        EXPECT_EQ(midstate.bytes, prefix);
+
+        for (size_t suffix : {0, 1, 20, 63, 64, 100})
+        {
+            unsigned char expected[32], actual[32];
+            safeheron::hash::CSHA256().Write(data.data(), prefix + suffix).Finalize(expected);
+            safeheron::hash::CSHA256::FromMidstate(midstate).Write(data.data() + prefix, suffix).Finalize(actual);
+            EXPECT_EQ(toHex(actual, 32), toHex(expected, 32)) << "prefix " << prefix << " suffix " << suffix;
+        }
+    }
+}
+
+/**
+ * @test SHA256_32Multiway matches the scalar hasher for every message count up to a few lane widths.
+ */
+TEST(Sha256Test, Multiway32MatchesScalar)
+{
+    using namespace safeheron::hash::sha256_implementation;
+    const size_t maxCount = 3 * safeheron::hash::SHA256_LANES + 1;
+    std::vector<unsigned char> input(32 * maxCount);
+    for (size_t i = 0; i < input.size(); i++)
+        input[i] = (unsigned char)(i * 151 + 3);
+
+    // the portable lanes, then whatever the CPU offers
+    for (UseImplementation use : {STANDARD, USE_ALL})
+    {
+        const std::string name = safeheron::hash::SHA256AutoDetect(use);
+        for (size_t count = 0; count <= maxCount; count++)
+        {
+            std::vector<unsigned char> output(32 * count + 1, 0xaa);
+            safeheron::hash::SHA256_32Multiway(output.data(), input.data(), count);
+            for (size_t i = 0; i < count; i++)
+            {
+                unsigned char expected[32];
+                safeheron::hash::CSHA256().Write(input.data() + 32 * i, 32).Finalize(expected);
+                EXPECT_EQ(toHex(output.data() + 32 * i, 32), toHex(expected, 32)) << name << " count " << count << " message " << i;
+            }
+            EXPECT_EQ(output[32 * count], 0xaa);
+        }
+    }
+}
+
+/**
+ * @test SHA256Multi and SHA256DMulti match the scalar hashes for messages of mixed lengths, including
+ * lengths at the block boundaries and above SHA256_MULTI_MAX_LEN, with every kernel.
+ */
+TEST(Sha256Test, MultiMatchesScalar)
+{
+    using namespace safeheron::hash::sha256_implementation;
+    std::vector<unsigned char> data(1024);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = (unsigned char)(i * 41 + 5);
+
+    std::vector<size_t> lens = {0, 1, 33, 34, 38, 55, 56, 63, 64, 78, 119, 120, 183, 184, 246, 247, 248, 300, 32, 21};
+    for (size_t i = 0; i < 45; i++)
+        lens.push_back((i * 37) % 260);
+    std::vector<const unsigned char *> inputs;
+    for (size_t i = 0; i < lens.size(); i++)
+        inputs.push_back(data.data() + (i * 13) % 400);
+
+    for (UseImplementation use : {STANDARD, USE_SSE4, USE_AVX2, USE_ALL})
+    {
+        const std::string name = safeheron::hash::SHA256AutoDetect(use);
+        // several counts, so that each kernel also sees partly filled lanes
+        for (size_t count : {lens.size(), (size_t)1, (size_t)5, (size_t)11})
+        {
+            std::vector<unsigned char> single(32 * count), twice(32 * count);
+            safeheron::hash::SHA256Multi(single.data(), inputs.data(), lens.data(), count);
+            safeheron::hash::SHA256DMulti(twice.data(), inputs.data(), lens.data(), count);
+            for (size_t i = 0; i < count; i++)
+            {
+                unsigned char expected[32];
+                safeheron::hash::CSHA256().Write(inputs[i], lens[i]).Finalize(expected);
+                EXPECT_EQ(toHex(single.data() + 32 * i, 32), toHex(expected, 32)) << name << " length " << lens[i];
+                safeheron::hash::SHA256D(expected, inputs[i], lens[i]);
+                EXPECT_EQ(toHex(twice.data() + 32 * i, 32), toHex(expected, 32)) << name << " length " << lens[i];
+            }
+        }
+    }
+    safeheron::hash::SHA256AutoDetect();
+}
@@ -71,6 +71,9 @@ run_test "Piped hex input" "echo -e '00   01\t02030405060708090a0b0c0d0e0f' | $B
 run_test "Hex input with uppercase" "$BINARY derive-key '00 0102030405060708090A0B0c0d0E0F'" "$EXPECTED1"
 run_test "Longer hex seed" "$BINARY derive-key fffcf9f6f3f0edeae7e4e1dedbd8d5d2cfccc9c6c3c0bdbab7b4b1aeaba8a5a29f9c999693908d8a8784817e7b7875726f6c696663605d5a5754514e4b484542" "$EXPECTED2"
 run_test "Piped seed with dash" "echo '000102030405060708090a0b0c0d0e0f' | $BINARY derive-key -" "$EXPECTED1"
+run_test "Seed error names the column" "$BINARY derive-key 0001020304050607080x0a0b0c0d0e0f 2>&1 | tail -1" " exception: [ERROR]: parseDeriveKeyValue: invalid characters in seed at column 20"
+run_test "Seed whitespace inside a byte" "$BINARY derive-key '00 0102030405060708090a0b0c0d0e0 f' 2>&1 | tail -1" " exception: [ERROR]: parseDeriveKeyValue: whitespace inside a seed byte at column 33"
+run_test "Seed longer than 64 bytes" "$BINARY derive-key $(printf '00%.0s' {1..65}) 2>&1 | tail -1" " exception: [ERROR]: parseDeriveKeyValue: seed length out of range, more than 64 bytes at column 129"
 
 # --- Multiple outputs ---
 multi_output=$($BINARY derive-key - <<EOF
@@ -127,6 +130,133 @@ echo -e "\n${GREEN}✔ [DERIVE-KEY] Running tests for checking path and dash (-)
 run_test "Path before dash" "$BINARY derive-key --path 0/1 - <<< '000102030405060708090a0b0c0d0e0f'" "$EXPECTED_DERIVED"
 run_test "Path after dash" "$BINARY derive-key - --path 0/1 <<< '000102030405060708090a0b0c0d0e0f'" "$EXPECTED_DERIVED"
 
+# BIP39 mnemonic input
+MNEMONIC1="abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about"
+EXPECTED_MNEMONIC1="xpub661MyMwAqRbcFkPHucMnrGNzDwb6teAX1RbKQmqtEF8kK3Z7LZ59qafCjB9eCRLiTVG3uxBxgKvRgbubRhqSKXnGGb1aoaqLrpMBDrVxga8:xprv9s21ZrQH143K3GJpoapnV8SFfukcVBSfeCficPSGfubmSFDxo1kuHnLisriDvSnRRuL2Qrg5ggqHKNVpxR86QEC8w35uxmGoggxtQTPvfUu"
+EXPECTED_MNEMONIC1_TREZOR="xpub661MyMwAqRbcGB88KaFbLGiYAat55APKhtWg4uYMkXAmfuSTbq2QYsn9sKJCj1YqZPafsboef4h4YbXXhNhPwMbkHTpkf3zLhx7HvFw1NDy:xprv9s21ZrQH143K3h3fDYiay8mocZ3afhfULfb5GX8kCBdno77K4HiA15Tg23wpbeF1pLfs1c5SPmYHrEpTuuRhxMwvKDwqdKiGJS9XFKzUsAF"
+EXPECTED_MNEMONIC1_BIP44="xpub6BosfCnifzxcFwrSzQiqu2DBVTshkCXacvNsWGYJVVhhawA7d4R5WSWGFNbi8Aw6ZRc1brxMyWMzG3DSSSSoekkudhUd9yLb6qx39T9nMdj:xprv9xpXFhFpqdQK3TmytPBqXtGSwS3DLjojFhTGht8gwAAii8py5X6pxeBnQ6ehJiyJ6nDjWGJfZ95WxByFXVkDxHXrqu53WCRGypk2ttuqncb"
+
+echo -e "\n${GREEN}✔ [DERIVE-KEY] Running tests for mnemonic input ...${NC}"
+run_test "Mnemonic without passphrase" "$BINARY derive-key --mnemonic '$MNEMONIC1'" "$EXPECTED_MNEMONIC1"
+run_test "Mnemonic with passphrase" "$BINARY derive-key --mnemonic '$MNEMONIC1' --passphrase TREZOR" "$EXPECTED_MNEMONIC1_TREZOR"
+run_test "Mnemonic with path" "$BINARY derive-key --mnemonic '$MNEMONIC1' --path 44h/0h/0h" "$EXPECTED_MNEMONIC1_BIP44"
+run_test "Piped mnemonics" "printf '%s\\n%s\\n' '$MNEMONIC1' '$MNEMONIC1' | $BINARY derive-key --mnemonic -" "$EXPECTED_MNEMONIC1
+$EXPECTED_MNEMONIC1"
+run_fail_test "Mnemonic with 11 words" "$BINARY derive-key --mnemonic 'abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about'"
+run_fail_test "Mnemonic with uppercase word" "$BINARY derive-key --mnemonic 'Abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about'"
+run_fail_test "Passphrase without mnemonic" "$BINARY derive-key 000102030405060708090a0b0c0d0e0f --passphrase TREZOR"
+
+echo -e "\n${GREEN}✔ [DERIVE-KEY] Running tests for public-only / private-only output ...${NC}"
+run_test "Public-only seed" "$BINARY derive-key --public-only 000102030405060708090a0b0c0d0e0f" "${EXPECTED1%%:*}"
+run_test "Private-only seed" "$BINARY derive-key --private-only 000102030405060708090a0b0c0d0e0f" "${EXPECTED1#*:}"
+run_test "Public-only with path" "$BINARY derive-key --public-only --path 0/1 000102030405060708090a0b0c0d0e0f" "${EXPECTED_DERIVED%%:*}"
+run_test "Private-only xprv" "$BINARY derive-key --private-only ${EXPECTED1#*:}" "${EXPECTED1#*:}"
+run_fail_test "Private-only xpub" "$BINARY derive-key --private-only ${EXPECTED1%%:*}"
+run_fail_test "Public-only and private-only" "$BINARY derive-key --public-only --private-only 000102030405060708090a0b0c0d0e0f"
+
+echo -e "\n${GREEN}✔ [DERIVE-KEY] Running tests for binary output ...${NC}"
+run_test "Binary record size" "$BINARY derive-key --format=bin 000102030405060708090a0b0c0d0e0f | wc -c" "128"
+run_test "Binary records per input line" "printf '%s\\n%s\\n' 000102030405060708090a0b0c0d0e0f ${EXPECTED1%%:*} | $BINARY derive-key --format=bin - | wc -c" "256"
+run_test "Binary record chain code" "$BINARY derive-key --format=bin 000102030405060708090a0b0c0d0e0f | od -An -tx1 -j16 -N32 | tr -d ' \\n'" "873dff81c02f525623fd1fe5167eac3a55a049de3d314bb42ee227ffed37d508"
+run_test "Text format is the default" "$BINARY derive-key --format=text 000102030405060708090a0b0c0d0e0f" "$EXPECTED1"
+run_fail_test "Unknown format" "$BINARY derive-key --format=xml 000102030405060708090a0b0c0d0e0f"
+
+echo -e "\n${GREEN}✔ [DERIVE-KEY] Running tests for NDJSON output ...${NC}"
+run_test "NDJSON seed" "$BINARY derive-key --format=ndjson 000102030405060708090a0b0c0d0e0f" "{\"index\":0,\"xpub\":\"${EXPECTED1%%:*}\",\"xprv\":\"${EXPECTED1#*:}\",\"depth\":0,\"child\":0,\"fingerprint\":\"00000000\"}"
+run_test "NDJSON public-only" "$BINARY derive-key --format=ndjson --public-only ${EXPECTED1#*:}" "{\"index\":0,\"xpub\":\"${EXPECTED1%%:*}\",\"xprv\":null,\"depth\":0,\"child\":0,\"fingerprint\":\"00000000\"}"
+run_test "NDJSON key-expression" "$BINARY key-expression --format=ndjson '[d34db33f/4/5]03fff97bd5755eeea420453a14355235d382f6472f8568a18b2f057a1460297556'" "{\"index\":0,\"expression\":\"[d34db33f/4/5]03fff97bd5755eeea420453a14355235d382f6472f8568a18b2f057a1460297556\",\"type\":\"pubkey\",\"key\":\"03fff97bd5755eeea420453a14355235d382f6472f8568a18b2f057a1460297556\",\"origin\":{\"fingerprint\":\"d34db33f\",\"path\":\"4/5\"},\"derivation\":null}"
+run_test "NDJSON script-expression verify" "$BINARY script-expression --format=ndjson --verify-checksum 'raw(deadbeef)#89f8spxm'" "{\"descriptor\":\"raw(deadbeef)\",\"checksum\":\"89f8spxm\",\"verified\":true}"
+run_fail_test "NDJSON script-expression bad checksum" "$BINARY script-expression --format=ndjson --verify-checksum 'raw(deadbeef)#89f8spxq'"
+run_fail_test "Binary format for key-expression" "$BINARY key-expression --format=bin 0260b2003c386519fc9eadf2b5cf124dd8eea4c4e68d5e154050a9346ea98ce600"
+
+echo -e "\n${GREEN}✔ [DERIVE-KEY] Running tests for key origin output ...${NC}"
+run_test "Origin seed" "$BINARY derive-key --origin 000102030405060708090a0b0c0d0e0f" "[3442193e]${EXPECTED1%%:*}:[3442193e]${EXPECTED1#*:}"
+run_test "Origin seed with path" "$BINARY derive-key --origin --public-only --path 0/1 000102030405060708090a0b0c0d0e0f" "[3442193e/0/1]xpub6AvUGrnEpfvJBbfx7sQ89Q8hEMPM65UteqEX4yUbUiES2jHfjexmfJoxCGSwFMZiPBaKQT1RiKWrKfuDV4vpgVs4Xn8PpPTR2i79rwHd4Zr"
+run_test "Origin hardened path uses h" "$BINARY derive-key --origin --public-only --path \"0H/1'\" 000102030405060708090a0b0c0d0e0f | cut -c1-16" "[3442193e/0h/1h]"
+run_test "Origin output is a valid key expression" "$BINARY derive-key --origin --public-only --path 0/1 000102030405060708090a0b0c0d0e0f | $BINARY key-expression -" "[3442193e/0/1]xpub6AvUGrnEpfvJBbfx7sQ89Q8hEMPM65UteqEX4yUbUiES2jHfjexmfJoxCGSwFMZiPBaKQT1RiKWrKfuDV4vpgVs4Xn8PpPTR2i79rwHd4Zr"
+run_test "Origin NDJSON" "$BINARY derive-key --origin --format=ndjson --public-only 000102030405060708090a0b0c0d0e0f" "{\"index\":0,\"xpub\":\"${EXPECTED1%%:*}\",\"xprv\":null,\"depth\":0,\"child\":0,\"fingerprint\":\"00000000\",\"origin\":{\"fingerprint\":\"3442193e\",\"path\":\"\"}}"
+run_fail_test "Origin with binary format" "$BINARY derive-key --origin --format=bin 000102030405060708090a0b0c0d0e0f"
+
+echo -e "\n${GREEN}✔ [DERIVE-KEY] Running tests for the node cache ...${NC}"
+NODE_CACHE=$(mktemp -u)
+EXPECTED_CACHED=$($BINARY derive-key --path "84h/0h/1h/0/3" 000102030405060708090a0b0c0d0e0f)
+run_test "Node cache first run" "$BINARY derive-key --cache $NODE_CACHE --path \"84h/0h/1h/0/3\" 000102030405060708090a0b0c0d0e0f" "$EXPECTED_CACHED"
+run_test "Node cache second run" "$BINARY derive-key --cache $NODE_CACHE --path \"84h/0h/1h/0/3\" 000102030405060708090a0b0c0d0e0f" "$EXPECTED_CACHED"
+run_test "Node cache file is private" "stat -c %a $NODE_CACHE" "600"
+run_test "Node cache without private keys" "$BINARY derive-key --cache $NODE_CACHE --cache-no-private --public-only --path \"84h/0h/1h/0/3\" 000102030405060708090a0b0c0d0e0f" "${EXPECTED_CACHED%%:*}"
+run_fail_test "Node cache on a foreign file" "$BINARY derive-key --cache $0 --path 0h 000102030405060708090a0b0c0d0e0f"
+run_fail_test "Node cache flag without cache" "$BINARY derive-key --cache-no-private 000102030405060708090a0b0c0d0e0f"
+rm -f "$NODE_CACHE"
+
+echo -e "\n${GREEN}✔ [ADDRESS] Running tests for address output ...${NC}"
+G_KEY="0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"
+run_test "Address of a seed" "$BINARY derive-key --format=address 000102030405060708090a0b0c0d0e0f" "15mKKb2eos1hWa6tisdPwwDC1a5J1y9nma"
+run_test "Address with path" "$BINARY derive-key --format=address --path 0h/1 000102030405060708090a0b0c0d0e0f" "1JQheacLPdM5ySCkrZkV66G2ApAXe1mqLj"
+run_test "Address of an xpub" "$BINARY derive-key --format=address --path 1 xpub68Gmy5EdvgibQVfPdqkBBCHxA5htiqg55crXYuXoQRKfDBFA1WEjWgP6LHhwBZeNK1VTsfTFUHCdrfp1bgwQ9xv5ski8PX9rL2dZXvgGDnw" "1JQheacLPdM5ySCkrZkV66G2ApAXe1mqLj"
+ADDRESS_INPUT=$(for i in $(seq 0 19); do printf '000102030405060708090a0b0c0d%04x\n' "$i"; done)
+EXPECTED_ADDRESSES=$(while read -r seed; do $BINARY derive-key --format=address --path 0/1 "$seed"; done <<< "$ADDRESS_INPUT")
+run_test "Address batch matches single inputs" "$BINARY derive-key --format=address --threads 2 --path 0/1 - <<< \"\$ADDRESS_INPUT\"" "$EXPECTED_ADDRESSES"
+run_fail_test "Address with origin" "$BINARY derive-key --format=address --origin 000102030405060708090a0b0c0d0e0f"
+run_fail_test "Address with private-only" "$BINARY derive-key --format=address --private-only 000102030405060708090a0b0c0d0e0f"
+run_test "Address of pkh()" "$BINARY script-expression --format=address 'pkh($G_KEY)'" "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH"
+run_test "Address of pkh() with WIF" "$BINARY script-expression --format=address 'pkh(5KYZdUEo39z3FPrtuX2QbbwGnNP5zTd7yyr2SC1j299sBCnWjss)'" "1HZwkjkeaoZfTSaJxDw6aKkxp45agDiEzN"
+run_test "Address of pkh() with xprv" "$BINARY script-expression --format=address 'pkh([d34db33f/0h]${EXPECTED1#*:}/0h/1)'" "1JQheacLPdM5ySCkrZkV66G2ApAXe1mqLj"
+run_test "Address of sh(pk())" "$BINARY script-expression --format=address 'sh(pk($G_KEY))'" "34wjDxkCQrUPYwnCRtap5uib6XNcVaud9K"
+run_test "Address of sh(multi())" "$BINARY script-expression --format=address 'sh(multi(1, 022f8bde4d1a07209355b4a7250a5c5128e88b84bddc619ab7cba8d569b240efe4, 025cbdf0646e5db4eaa398f365f2ea7a0e3d419b7e0330e39ce92bddedcac4f9bc))'" "3ETTzkMnuA4PguZeWYtdCT6Rva3yTHATyP"
+run_test "Address after checksum verification" "$BINARY script-expression --format=address --verify-checksum 'pkh($G_KEY)#e48zzw02'" "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH"
+run_fail_test "Address with bad checksum" "$BINARY script-expression --format=address --verify-checksum 'pkh($G_KEY)#e48zzw03'"
+run_fail_test "Address of pk()" "$BINARY script-expression --format=address 'pk($G_KEY)'"
+run_fail_test "Address of raw()" "$BINARY script-expression --format=address 'raw(deadbeef)'"
+run_fail_test "Address of ranged key" "$BINARY script-expression --format=address 'pkh(${EXPECTED1%%:*}/0/*)'"
+run_fail_test "Address with compute-checksum" "$BINARY script-expression --format=address --compute-checksum 'pkh($G_KEY)'"
+run_fail_test "Address format for key-expression" "$BINARY key-expression --format=address $G_KEY"
+
+echo -e "\n${GREEN}✔ [FIND-CHILD] Running tests for reverse child index lookup ...${NC}"
+MASTER_XPUB="${EXPECTED1%%:*}"
+FIND_TARGETS=$(mktemp)
+printf '%s\n%s\n' \
+    "$($BINARY derive-key --format=bin --path 0/17 "$MASTER_XPUB" | od -An -v -tx1 -j48 -N33 | tr -d ' \n')" \
+    "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798" > "$FIND_TARGETS"
+run_test "Find child index" "$BINARY find-child $MASTER_XPUB --targets $FIND_TARGETS --path '0/*' | cut -d: -f2" "0/17"
+run_test "Find child NDJSON" "$BINARY find-child $MASTER_XPUB --targets $FIND_TARGETS --path '0/*' --range 100 --threads 2 --format=ndjson | grep -o '\"index\":[0-9]*'" "\"index\":17"
+run_test "Find child outside range" "$BINARY find-child $MASTER_XPUB --targets $FIND_TARGETS --path '0/*' --range 17 | wc -l" "0"
+run_fail_test "Find child without targets" "$BINARY find-child $MASTER_XPUB"
+run_fail_test "Find child missing targets file" "$BINARY find-child $MASTER_XPUB --targets /nonexistent/targets"
+run_fail_test "Find child hardened template" "$BINARY find-child $MASTER_XPUB --targets $FIND_TARGETS --path \"0h/*\""
+run_fail_test "Find child from xprv" "$BINARY find-child ${EXPECTED1#*:} --targets $FIND_TARGETS"
+rm -f "$FIND_TARGETS"
+
+echo -e "\n${GREEN}✔ [SCAN] Running tests for the gap-limit scan ...${NC}"
+SCAN_USED=$(mktemp)
+{
+    $BINARY derive-key --format=address --path 0/3 "$MASTER_XPUB"
+    $BINARY derive-key --format=address --path 0/22 "$MASTER_XPUB"
+    echo "# P2PKH scriptPubKey of 1/0"
+    echo "76a914f09cb16010dc6d58dfafee3d3f9f027dc03be2c488ac"
+    $BINARY derive-key --format=address --path 0/50 "$MASTER_XPUB"
+} > "$SCAN_USED"
+run_test "Scan receive and change chains" "$BINARY scan $MASTER_XPUB --used $SCAN_USED | cut -d: -f2" "$(printf '0/3\n0/22\n1/0')"
+run_test "Scan addresses" "$BINARY scan $MASTER_XPUB --used $SCAN_USED | head -1" "0:0/3:$($BINARY derive-key --format=address --path 0/3 "$MASTER_XPUB")"
+run_test "Scan larger gap" "$BINARY scan $MASTER_XPUB --used $SCAN_USED --gap 30 | cut -d: -f2 | tail -2" "$(printf '0/50\n1/0')"
+run_test "Scan smaller gap" "$BINARY scan $MASTER_XPUB --used $SCAN_USED --gap 5 | cut -d: -f2" "$(printf '0/3\n1/0')"
+run_test "Scan descriptor" "$BINARY scan 'pkh([3442193e]$MASTER_XPUB/1/*)' --used $SCAN_USED --format=ndjson | grep -o '\"path\":\"[0-9/]*\"'" "\"path\":\"1/0\""
+run_test "Scan many inputs" "printf '%s\n' $MASTER_XPUB 'pkh($MASTER_XPUB/0/*)' | $BINARY scan - --used $SCAN_USED --threads 3 | cut -d: -f1,2 | tr '\n' ' '" "0:0/3 0:0/22 0:1/0 1:0/3 1:0/22 "
+run_fail_test "Scan without used file" "$BINARY scan $MASTER_XPUB"
+run_fail_test "Scan missing used file" "$BINARY scan $MASTER_XPUB --used /nonexistent/used"
+run_fail_test "Scan invalid used entry" "$BINARY scan $MASTER_XPUB --used $0"
+run_fail_test "Scan from xprv" "$BINARY scan ${EXPECTED1#*:} --used $SCAN_USED"
+run_fail_test "Scan zero gap" "$BINARY scan $MASTER_XPUB --used $SCAN_USED --gap 0"
+rm -f "$SCAN_USED"
+
+echo -e "\n${GREEN}✔ [DERIVE-KEY] Running tests for parallel derivation ...${NC}"
+PARALLEL_INPUT=$(for i in $(seq 0 199); do printf '000102030405060708090a0b0c0d%04x\n' "$i"; done)
+EXPECTED_PARALLEL=$($BINARY derive-key --threads 1 --path 0/1h - <<< "$PARALLEL_INPUT" 2>&1)
+run_test "Threads 1 derives every line" "echo \"\$EXPECTED_PARALLEL\" | wc -l" "200"
+run_test "Threads 4 matches serial output" "$BINARY derive-key --threads 4 --path 0/1h - <<< \"\$PARALLEL_INPUT\"" "$EXPECTED_PARALLEL"
+run_test "Threads 0 matches serial output" "$BINARY derive-key --threads 0 --path 0/1h - <<< \"\$PARALLEL_INPUT\"" "$EXPECTED_PARALLEL"
+run_fail_test "Threads not a number" "$BINARY derive-key --threads four 000102030405060708090a0b0c0d0e0f"
+run_fail_test "Threads above limit" "$BINARY derive-key --threads 1000 000102030405060708090a0b0c0d0e0f"
+
 #------------------------------- ARGUMENT-PARSER TESTS -------------------------------
 EXPECTED_HELP=$(eval "$BINARY --help" 2>&1)
 